@@ -0,0 +1,386 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_BENCHMARK_BASELINE_H_
+#define CC65C_BENCHMARK_BASELINE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <vector>
+#include "../include/define.h"
+#include "../include/core/exception.h"
+#include "../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#ifndef BENCHMARK_BUILD_FLAGS
+		#define BENCHMARK_BUILD_FLAGS "unknown"
+		#endif // BENCHMARK_BUILD_FLAGS
+
+		#ifdef __clang__
+		#define BENCHMARK_COMPILER "clang " __clang_version__
+		#elif defined(__GNUC__)
+		#define BENCHMARK_COMPILER "gcc " __VERSION__
+		#else
+		#define BENCHMARK_COMPILER "unknown"
+		#endif // __clang__
+
+		#define BENCHMARK_CPU_KEY "model name"
+		#define BENCHMARK_CPU_PATH "/proc/cpuinfo"
+		#define BENCHMARK_DEVIATION_SCALE 1.4826
+		#define BENCHMARK_MEDIAN_SCALE 1.2533
+		#define BENCHMARK_SIGMA 3.0
+		#define BENCHMARK_THRESHOLD 0.03
+
+		enum {
+			BENCHMARK_FINGERPRINT_COMPILER = 0,
+			BENCHMARK_FINGERPRINT_CPU,
+			BENCHMARK_FINGERPRINT_FLAGS,
+		};
+
+		#define BENCHMARK_FINGERPRINT_MAX BENCHMARK_FINGERPRINT_FLAGS
+
+		static const std::string BENCHMARK_FINGERPRINT_STR[] = {
+			"compiler", "cpu", "flags",
+			};
+
+		enum {
+			BENCHMARK_METRIC_MEDIAN = 0,
+			BENCHMARK_METRIC_NOISE,
+			BENCHMARK_METRIC_SAMPLES,
+		};
+
+		typedef std::tuple<double, double, size_t> benchmark_metric_t;
+
+		class baseline {
+
+			public:
+
+				baseline(void)
+				{
+					TRACE_ENTRY();
+
+					m_fingerprint[BENCHMARK_FINGERPRINT_STR[BENCHMARK_FINGERPRINT_COMPILER]] = BENCHMARK_COMPILER;
+					m_fingerprint[BENCHMARK_FINGERPRINT_STR[BENCHMARK_FINGERPRINT_CPU]] = cpu();
+					m_fingerprint[BENCHMARK_FINGERPRINT_STR[BENCHMARK_FINGERPRINT_FLAGS]] = BENCHMARK_BUILD_FLAGS;
+
+					TRACE_EXIT();
+				}
+
+				void 
+				add(
+					__in const std::string &name,
+					__in std::vector<double> samples
+					)
+				{
+					double median;
+					std::vector<double> deviation;
+					std::vector<double>::iterator iter;
+
+					TRACE_ENTRY();
+
+					if(samples.empty()) {
+						THROW_EXCEPTION_FORMAT("Empty benchmark metric", "Name=%s", STRING_CHECK(name));
+					}
+
+					median = percentile(samples, 50);
+
+					for(iter = samples.begin(); iter != samples.end(); ++iter) {
+						deviation.push_back(std::fabs(*iter - median));
+					}
+
+					m_metric[name] = std::make_tuple(median, median ? ((BENCHMARK_DEVIATION_SCALE
+						* percentile(deviation, 50)) / median) : 0.0, samples.size());
+
+					TRACE_EXIT();
+				}
+
+				bool 
+				compare(
+					__in const std::string &path,
+					__in_opt double threshold = BENCHMARK_THRESHOLD
+					)
+				{
+					baseline reference;
+					bool result = true;
+					double change, limit;
+					std::map<std::string, std::string>::iterator fingerprint;
+					std::map<std::string, cc65c::test::benchmark_metric_t>::iterator entry, iter;
+
+					TRACE_ENTRY();
+
+					reference.read(path);
+
+					for(fingerprint = m_fingerprint.begin(); fingerprint != m_fingerprint.end(); ++fingerprint) {
+
+						if(reference.m_fingerprint[fingerprint->first] != fingerprint->second) {
+							std::cerr << "BASELINE_MISMATCH[" << fingerprint->first << "]: \""
+								<< reference.m_fingerprint[fingerprint->first] << "\" != \"" << fingerprint->second
+								<< "\"" << std::endl;
+						}
+					}
+
+					for(iter = m_metric.begin(); iter != m_metric.end(); ++iter) {
+
+						entry = reference.m_metric.find(iter->first);
+						if(entry == reference.m_metric.end()) {
+							std::cerr << "BASELINE_NEW[" << iter->first << "]" << std::endl;
+							continue;
+						}
+
+						change = (std::get<BENCHMARK_METRIC_MEDIAN>(entry->second)
+							? ((std::get<BENCHMARK_METRIC_MEDIAN>(iter->second)
+								/ std::get<BENCHMARK_METRIC_MEDIAN>(entry->second)) - 1.0) : 0.0);
+						limit = std::max(threshold, BENCHMARK_SIGMA * BENCHMARK_MEDIAN_SCALE * std::sqrt(
+							(std::pow(std::get<BENCHMARK_METRIC_NOISE>(entry->second), 2)
+								/ std::get<BENCHMARK_METRIC_SAMPLES>(entry->second))
+							+ (std::pow(std::get<BENCHMARK_METRIC_NOISE>(iter->second), 2)
+								/ std::get<BENCHMARK_METRIC_SAMPLES>(iter->second))));
+
+						std::cerr << ((change > limit) ? "BASELINE_REGRESSION[" : "BASELINE_PASS[") << iter->first
+							<< "]: " << std::fixed << std::setprecision(2) << (change * 100.0) << "% (limit "
+							<< (limit * 100.0) << "%)" << std::endl;
+
+						if(change > limit) {
+							result = false;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				void 
+				read(
+					__in const std::string &path
+					)
+				{
+					std::string line;
+					std::map<std::string, std::string> object;
+					std::ifstream file(path.c_str(), std::ios::in);
+
+					TRACE_ENTRY();
+
+					if(!file) {
+						THROW_EXCEPTION_FORMAT("Failed to open file", "Path=%s", STRING_CHECK(path));
+					}
+
+					m_fingerprint.clear();
+					m_metric.clear();
+
+					while(std::getline(file, line)) {
+
+						object = parse(line);
+						if(object.find("name") != object.end()) {
+							m_metric[object["name"]] = std::make_tuple(std::stod(object["median"]),
+								std::stod(object["noise"]), std::stoul(object["samples"]));
+						} else if(object.find(BENCHMARK_FINGERPRINT_STR[BENCHMARK_FINGERPRINT_CPU]) != object.end()) {
+							m_fingerprint = object;
+						}
+					}
+
+					file.close();
+
+					TRACE_EXIT();
+				}
+
+				void 
+				write(
+					__in const std::string &path
+					)
+				{
+					std::map<std::string, std::string>::iterator fingerprint;
+					std::map<std::string, cc65c::test::benchmark_metric_t>::iterator iter;
+					std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+
+					TRACE_ENTRY();
+
+					if(!file) {
+						THROW_EXCEPTION_FORMAT("Failed to open file", "Path=%s", STRING_CHECK(path));
+					}
+
+					file << "{" << std::endl << "  \"fingerprint\": {";
+
+					for(fingerprint = m_fingerprint.begin(); fingerprint != m_fingerprint.end(); ++fingerprint) {
+						file << ((fingerprint == m_fingerprint.begin()) ? "" : ", ") << "\"" << fingerprint->first
+							<< "\": \"" << escape(fingerprint->second) << "\"";
+					}
+
+					file << "}," << std::endl << "  \"metrics\": [";
+
+					for(iter = m_metric.begin(); iter != m_metric.end(); ++iter) {
+						file << ((iter == m_metric.begin()) ? "" : ",") << std::endl << "    {\"name\": \""
+							<< escape(iter->first) << "\", " << std::fixed << std::setprecision(6) << "\"median\": "
+							<< std::get<BENCHMARK_METRIC_MEDIAN>(iter->second) << ", \"noise\": "
+							<< std::get<BENCHMARK_METRIC_NOISE>(iter->second) << ", \"samples\": "
+							<< std::get<BENCHMARK_METRIC_SAMPLES>(iter->second) << "}";
+					}
+
+					file << std::endl << "  ]" << std::endl << "}" << std::endl;
+					file.close();
+
+					TRACE_EXIT();
+				}
+
+			protected:
+
+				static std::string 
+				cpu(void)
+				{
+					size_t position;
+					std::string line, result = "unknown";
+					std::ifstream file(BENCHMARK_CPU_PATH, std::ios::in);
+
+					TRACE_ENTRY();
+
+					while(file && std::getline(file, line)) {
+
+						if(!line.compare(0, std::string(BENCHMARK_CPU_KEY).size(), BENCHMARK_CPU_KEY)) {
+
+							position = line.find(':');
+							if(position != std::string::npos) {
+								result = line.substr(line.find_first_not_of(' ', position + 1));
+							}
+							break;
+						}
+					}
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				static std::string 
+				escape(
+					__in const std::string &input
+					)
+				{
+					std::string result;
+					std::string::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = input.begin(); iter != input.end(); ++iter) {
+
+						if((*iter == '\"') || (*iter == '\\')) {
+							result += '\\';
+						}
+
+						result += *iter;
+					}
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				static std::map<std::string, std::string> 
+				parse(
+					__in const std::string &line
+					)
+				{
+					size_t position;
+					std::string key, *value;
+					std::map<std::string, std::string> result;
+
+					TRACE_ENTRY();
+
+					position = line.find('{');
+
+					while((position != std::string::npos) && (position < line.size())) {
+
+						position = line.find('\"', position);
+						if(position == std::string::npos) {
+							break;
+						}
+
+						key = parse_string(line, position);
+						position = line.find_first_not_of(" :", position);
+						if(position == std::string::npos) {
+							break;
+						}
+
+						value = &result[key];
+						if(line.at(position) == '\"') {
+							*value = parse_string(line, position);
+						} else {
+
+							while((position < line.size()) && (line.at(position) != ',') && (line.at(position) != '}')) {
+								*value += line.at(position++);
+							}
+						}
+
+						position = line.find(',', position);
+					}
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				static std::string 
+				parse_string(
+					__in const std::string &line,
+					__inout size_t &position
+					)
+				{
+					std::string result;
+
+					TRACE_ENTRY();
+
+					for(++position; (position < line.size()) && (line.at(position) != '\"'); ++position) {
+
+						if((line.at(position) == '\\') && ((position + 1) < line.size())) {
+							++position;
+						}
+
+						result += line.at(position);
+					}
+
+					++position;
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				static double 
+				percentile(
+					__in std::vector<double> samples,
+					__in size_t rank
+					)
+				{
+					double result;
+
+					TRACE_ENTRY();
+
+					std::sort(samples.begin(), samples.end());
+					result = samples.at(std::min(samples.size() - 1, (samples.size() * rank) / 100));
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				std::map<std::string, std::string> m_fingerprint;
+
+				std::map<std::string, cc65c::test::benchmark_metric_t> m_metric;
+		};
+	}
+}
+
+#endif // CC65C_BENCHMARK_BASELINE_H_
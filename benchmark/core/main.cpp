@@ -0,0 +1,666 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <thread>
+#include "../../include/runtime.h"
+#include "../../include/assembler/tree.h"
+#include "../../include/core/stream.h"
+#include "../../include/test/suite.h"
+#include "../baseline.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define CORE_FIXTURE_NAME "CORE_FIXTURE"
+		#define CORE_SUITE_NAME "CORE_SUITE"
+
+		#define CORE_OPERATIONS 100000
+		#define CORE_REPETITION 5
+		#define CORE_STREAM_LENGTH 0x1000
+		#define CORE_STREAM_PATH "/tmp/cc65c_core_benchmark_"
+		#define CORE_TRACE_MESSAGE "Benchmark message"
+
+		typedef std::chrono::high_resolution_clock::time_point core_time_t;
+
+		typedef std::function<void(size_t, size_t, std::atomic<size_t> &, size_t, core_time_t &, core_time_t &)>
+			core_function_t;
+
+		enum {
+			CORE_BENCHMARK_DIVISOR = 0,
+			CORE_BENCHMARK_FUNCTION,
+			CORE_BENCHMARK_NAME,
+			CORE_BENCHMARK_TRACE,
+		};
+
+		typedef std::tuple<size_t, cc65c::test::core_function_t, std::string, bool> core_benchmark_t;
+
+		enum {
+			CORE_RESULT_MAXIMUM = 0,
+			CORE_RESULT_MEDIAN,
+			CORE_RESULT_MINIMUM,
+			CORE_RESULT_NAME,
+			CORE_RESULT_OPERATIONS,
+			CORE_RESULT_THREADS,
+		};
+
+		typedef std::tuple<double, double, double, std::string, size_t, size_t> core_result_t;
+
+		class fixture_core :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_core(
+					__in size_t operations,
+					__in size_t repetition,
+					__in size_t threads,
+					__inout cc65c::test::baseline &metric
+					) :
+						cc65c::test::fixture(CORE_FIXTURE_NAME),
+						m_metric(metric),
+						m_operations(operations),
+						m_repetition(repetition),
+						m_threads(threads)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					m_result.clear();
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					std::vector<cc65c::test::core_benchmark_t>::iterator iter;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<cc65c::test::core_benchmark_t> benchmark = {
+						cc65c::test::core_benchmark_t(100, stream_write, "stream_write", false),
+						cc65c::test::core_benchmark_t(1, symbol_decrement_token, "symbol_decrement_token", false),
+						cc65c::test::core_benchmark_t(1, symbol_generate_token, "symbol_generate_token", false),
+						cc65c::test::core_benchmark_t(1, token_copy, "token_copy", false),
+						cc65c::test::core_benchmark_t(1, token_destroy, "token_destroy", false),
+						trace_benchmark(cc65c::core::LEVEL_ERROR, "trace_send_error"),
+						trace_benchmark(cc65c::core::LEVEL_INFORMATION, "trace_send_information"),
+						trace_benchmark(cc65c::core::LEVEL_VERBOSE, "trace_send_verbose"),
+						trace_benchmark(cc65c::core::LEVEL_WARNING, "trace_send_warning"),
+						cc65c::test::core_benchmark_t(1, tree_add, "tree_add", false),
+						cc65c::test::core_benchmark_t(1, uuid_decrement, "uuid_decrement", false),
+						cc65c::test::core_benchmark_t(1, uuid_generate, "uuid_generate", false),
+						};
+
+					TRACE_ENTRY();
+
+					try {
+
+						for(iter = benchmark.begin(); iter != benchmark.end(); ++iter) {
+							run(*iter, 1);
+
+							if(m_threads > 1) {
+								run(*iter, m_threads);
+							}
+						}
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				std::string 
+				to_json(void)
+				{
+					std::stringstream result;
+					std::vector<cc65c::test::core_result_t>::iterator iter;
+
+					TRACE_ENTRY();
+
+					result << "{" << std::endl << "  \"suite\": \"core\"," << std::endl << "  \"operations\": "
+						<< m_operations << "," << std::endl << "  \"repetitions\": " << m_repetition << ","
+						<< std::endl << "  \"results\": [";
+
+					for(iter = m_result.begin(); iter != m_result.end(); ++iter) {
+						result << ((iter == m_result.begin()) ? "" : ",") << std::endl << "    {\"name\": \""
+							<< std::get<CORE_RESULT_NAME>(*iter) << "\", \"threads\": "
+							<< std::get<CORE_RESULT_THREADS>(*iter) << ", \"operations\": "
+							<< std::get<CORE_RESULT_OPERATIONS>(*iter) << std::fixed << std::setprecision(3)
+							<< ", \"ns_per_op_median\": " << std::get<CORE_RESULT_MEDIAN>(*iter)
+							<< ", \"ns_per_op_minimum\": " << std::get<CORE_RESULT_MINIMUM>(*iter)
+							<< ", \"ns_per_op_maximum\": " << std::get<CORE_RESULT_MAXIMUM>(*iter)
+							<< ", \"ops_per_second\": " << (1000000000.0 / std::get<CORE_RESULT_MEDIAN>(*iter))
+							<< "}";
+					}
+
+					result << std::endl << "  ]" << std::endl << "}" << std::endl;
+
+					TRACE_EXIT();
+					return result.str();
+				}
+
+			protected:
+
+				void 
+				run(
+					__in const cc65c::test::core_benchmark_t &benchmark,
+					__in size_t threads
+					)
+				{
+					size_t index, operations, repetition;
+					std::atomic<size_t> ready;
+					std::vector<double> elapsed;
+					std::vector<std::thread> worker;
+					std::streambuf *error = nullptr, *output = nullptr;
+					std::stringstream discard;
+					std::vector<cc65c::test::core_time_t> begin(threads), end(threads);
+
+					TRACE_ENTRY();
+
+					operations = std::max((size_t) 1, m_operations / std::get<CORE_BENCHMARK_DIVISOR>(benchmark));
+
+					for(repetition = 0; repetition < m_repetition; ++repetition) {
+						ready = 0;
+
+						if(std::get<CORE_BENCHMARK_TRACE>(benchmark)) {
+							error = std::cerr.rdbuf(discard.rdbuf());
+							output = std::cout.rdbuf(discard.rdbuf());
+						}
+
+						for(index = 0; index < threads; ++index) {
+							worker.push_back(std::thread(std::get<CORE_BENCHMARK_FUNCTION>(benchmark), index,
+								operations, std::ref(ready), threads, std::ref(begin.at(index)),
+								std::ref(end.at(index))));
+						}
+
+						for(index = 0; index < threads; ++index) {
+							worker.at(index).join();
+						}
+
+						worker.clear();
+
+						if(std::get<CORE_BENCHMARK_TRACE>(benchmark)) {
+							cc65c::core::trace &instance = cc65c::core::trace::acquire();
+							instance.uninitialize();
+							instance.initialize();
+							std::cerr.rdbuf(error);
+							std::cout.rdbuf(output);
+							discard.str(std::string());
+						}
+
+						elapsed.push_back(std::chrono::duration<double, std::nano>(
+							*std::max_element(end.begin(), end.end())
+							- *std::min_element(begin.begin(), begin.end())).count() / (operations * threads));
+					}
+
+					m_metric.add(std::get<CORE_BENCHMARK_NAME>(benchmark) + "/" + std::to_string(threads), elapsed);
+					std::sort(elapsed.begin(), elapsed.end());
+					m_result.push_back(std::make_tuple(elapsed.back(), elapsed.at(elapsed.size() / 2),
+						elapsed.front(), std::get<CORE_BENCHMARK_NAME>(benchmark), operations, threads));
+
+					TRACE_EXIT();
+				}
+
+				static cc65c::test::core_time_t 
+				start(
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads
+					)
+				{
+					TRACE_ENTRY();
+
+					++ready;
+
+					while(ready < threads) {
+						std::this_thread::yield();
+					}
+
+					TRACE_EXIT();
+					return std::chrono::high_resolution_clock::now();
+				}
+
+				static void 
+				stream_write(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					std::string path = (CORE_STREAM_PATH + std::to_string(thread));
+					cc65c::core::stream instance(CORE_STREAM_LENGTH, 0xea);
+
+					TRACE_ENTRY();
+
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						instance.write(path);
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+					std::remove(path.c_str());
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				symbol_decrement_token(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					int32_t *value;
+					std::string *key;
+					std::vector<cc65c::core::uuid_t> id;
+					cc65c::core::uuid &instance_uuid = cc65c::core::uuid::acquire();
+					cc65c::assembler::symbol &instance_symbol = cc65c::assembler::symbol::acquire();
+
+					TRACE_ENTRY();
+
+					for(index = 0; index < operations; ++index) {
+						id.push_back(instance_uuid.generate());
+						instance_symbol.generate_token(id.back(), (int32_t) index, key, value);
+					}
+
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						instance_symbol.decrement_token(id.at(index));
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					for(index = 0; index < operations; ++index) {
+						instance_uuid.decrement(id.at(index));
+					}
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				symbol_generate_token(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					int32_t *value;
+					std::string *key;
+					std::vector<cc65c::core::uuid_t> id;
+					cc65c::core::uuid &instance_uuid = cc65c::core::uuid::acquire();
+					cc65c::assembler::symbol &instance_symbol = cc65c::assembler::symbol::acquire();
+
+					TRACE_ENTRY();
+
+					for(index = 0; index < operations; ++index) {
+						id.push_back(instance_uuid.generate());
+					}
+
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						instance_symbol.generate_token(id.at(index), (int32_t) index, key, value);
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					for(index = 0; index < operations; ++index) {
+						instance_symbol.decrement_token(id.at(index));
+						instance_uuid.decrement(id.at(index));
+					}
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				token_copy(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					std::vector<cc65c::assembler::token> copy;
+					cc65c::assembler::token source((int32_t) thread);
+
+					TRACE_ENTRY();
+
+					copy.reserve(operations);
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						copy.push_back(source);
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				token_destroy(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					std::vector<cc65c::assembler::token> copy;
+
+					TRACE_ENTRY();
+
+					copy.reserve(operations);
+
+					for(index = 0; index < operations; ++index) {
+						copy.push_back(cc65c::assembler::token((int32_t) index));
+					}
+
+					begin = start(ready, threads);
+					copy.clear();
+					end = std::chrono::high_resolution_clock::now();
+
+					TRACE_EXIT();
+				}
+
+				static cc65c::test::core_benchmark_t 
+				trace_benchmark(
+					__in cc65c::core::level_t level,
+					__in const std::string &name
+					)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+					return cc65c::test::core_benchmark_t(1, std::bind(trace_send, level, std::placeholders::_1,
+						std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5,
+						std::placeholders::_6), name, true);
+				}
+
+				static void 
+				trace_send(
+					__in cc65c::core::level_t level,
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					cc65c::core::trace &instance = cc65c::core::trace::acquire();
+
+					TRACE_ENTRY();
+
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						instance.send(level, std::string(), __FILE__, __FUNCTION__, __LINE__, "%s[%u]",
+							CORE_TRACE_MESSAGE, index);
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				tree_add(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					cc65c::assembler::tree instance;
+					cc65c::assembler::token child((int32_t) thread);
+
+					TRACE_ENTRY();
+
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						instance.add(child);
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				uuid_decrement(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					std::vector<cc65c::core::uuid_t> id;
+					cc65c::core::uuid &instance = cc65c::core::uuid::acquire();
+
+					TRACE_ENTRY();
+
+					for(index = 0; index < operations; ++index) {
+						id.push_back(instance.generate());
+					}
+
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						instance.decrement(id.at(index));
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				uuid_generate(
+					__in size_t thread,
+					__in size_t operations,
+					__inout std::atomic<size_t> &ready,
+					__in size_t threads,
+					__inout cc65c::test::core_time_t &begin,
+					__inout cc65c::test::core_time_t &end
+					)
+				{
+					size_t index;
+					std::vector<cc65c::core::uuid_t> id;
+					cc65c::core::uuid &instance = cc65c::core::uuid::acquire();
+
+					TRACE_ENTRY();
+
+					id.reserve(operations);
+					begin = start(ready, threads);
+
+					for(index = 0; index < operations; ++index) {
+						id.push_back(instance.generate());
+					}
+
+					end = std::chrono::high_resolution_clock::now();
+
+					for(index = 0; index < operations; ++index) {
+						instance.decrement(id.at(index));
+					}
+
+					TRACE_EXIT();
+				}
+
+				cc65c::test::baseline &m_metric;
+
+				size_t m_operations;
+
+				size_t m_repetition;
+
+				std::vector<cc65c::test::core_result_t> m_result;
+
+				size_t m_threads;
+		};
+	}
+}
+
+int 
+main(
+	__in int argc,
+	__in char *argv[]
+	)
+{
+	int option;
+	bool regression = false;
+	cc65c::test::baseline metric;
+	double threshold = BENCHMARK_THRESHOLD;
+	std::string compare, output, record;
+	size_t operations = CORE_OPERATIONS, repetition = CORE_REPETITION,
+		threads = std::max(2u, std::thread::hardware_concurrency());
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+
+		while((option = getopt(argc, argv, "B:C:j:n:o:r:t:")) != -1) {
+
+			switch(option) {
+				case 'B':
+					record = optarg;
+					break;
+				case 'C':
+					compare = optarg;
+					break;
+				case 'j':
+					threads = std::stoul(optarg);
+					break;
+				case 'n':
+					operations = std::stoul(optarg);
+					break;
+				case 'o':
+					output = optarg;
+					break;
+				case 'r':
+					repetition = std::stoul(optarg);
+					break;
+				case 't':
+					threshold = (std::stod(optarg) / 100.0);
+					break;
+				default:
+					std::cerr << "Usage: " << argv[0] << " [-B BASELINE] [-C BASELINE] [-j THREADS] [-n OPERATIONS] "
+						<< "[-o OUTPUT] [-r REPETITIONS] [-t THRESHOLD]" << std::endl;
+					return result;
+			}
+		}
+
+		if(!operations || !repetition || !threads) {
+			THROW_EXCEPTION_FORMAT("Invalid benchmark parameters", "Operations=%u, Repetitions=%u, Threads=%u",
+				operations, repetition, threads);
+		}
+
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(CORE_SUITE_NAME);
+		cc65c::test::fixture_core test(operations, repetition, threads, metric);
+		suite.add(test);
+		result = suite.run(CORE_FIXTURE_NAME);
+
+		if(result == cc65c::test::STATUS_SUCCESS) {
+
+			if(output.empty()) {
+				std::cout << test.to_json();
+			} else {
+				std::ofstream file(output.c_str(), std::ios::out | std::ios::trunc);
+				if(!file) {
+					THROW_EXCEPTION_FORMAT("Failed to open file", "Path=%s", STRING_CHECK(output));
+				}
+
+				file << test.to_json();
+				file.close();
+			}
+
+			if(!compare.empty()) {
+				regression = !metric.compare(compare, threshold);
+			}
+
+			if(!record.empty()) {
+				metric.write(record);
+			}
+		}
+
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	} catch(std::exception &exc) {
+		std::cerr << exc.what() << std::endl;
+	}
+
+	if(!compare.empty() || !record.empty()) {
+		return (((result == cc65c::test::STATUS_SUCCESS) && !regression) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	return result;
+}
@@ -0,0 +1,213 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include "../../include/runtime.h"
+#include "../../include/assembler/generator.h"
+#include "../../include/emulator/processor.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define EMULATOR_FIXTURE_NAME "EMULATOR_FIXTURE"
+		#define EMULATOR_ORIGIN 0x0200
+		#define EMULATOR_SUITE_NAME "EMULATOR_SUITE"
+
+		#define EMULATOR_SOURCE \
+			"org 0x0200\n" \
+			"start:\n" \
+			"\tldx #0x00\n" \
+			"copy:\n" \
+			"\tlda 0x1000, x\n" \
+			"\tsta 0x2000, x\n" \
+			"\tinx\n" \
+			"\tbne copy\n" \
+			"convert:\n" \
+			"\tlda 0x2000, x\n" \
+			"\tcmp #0x61\n" \
+			"\tbcc skip\n" \
+			"\tsbc #0x20\n" \
+			"\tsta 0x2000, x\n" \
+			"skip:\n" \
+			"\tinx\n" \
+			"\tbne convert\n" \
+			"\tinc 0x1000\n" \
+			"\tjmp start\n"
+
+		static const std::vector<uint64_t> EMULATOR_BENCHMARK_SET = {
+			10000000, 100000000, 1000000000,
+			};
+
+		class fixture_emulator :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_emulator(void) :
+					cc65c::test::fixture(EMULATOR_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<uint64_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = EMULATOR_BENCHMARK_SET.begin(); iter != EMULATOR_BENCHMARK_SET.end(); ++iter) {
+
+						result = benchmark(*iter);
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Benchmark failure", "Cycles=%llu", *iter);
+							break;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static cc65c::test::status_t 
+				benchmark(
+					__in uint64_t cycles
+					)
+				{
+					cc65c::test::status_t result;
+
+					TRACE_ENTRY();
+
+					result = benchmark(cycles, false);
+					if(result == STATUS_SUCCESS) {
+						result = benchmark(cycles, true);
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				benchmark(
+					__in uint64_t cycles,
+					__in bool cached
+					)
+				{
+					uint64_t executed;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::chrono::high_resolution_clock::time_point begin;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::emulator::processor instance;
+						cc65c::assembler::generator gen(EMULATOR_SOURCE, false);
+
+						gen.enumerate();
+						instance.set_block_cache(cached);
+						instance.write(cc65c::emulator::VECTOR_RESET, EMULATOR_ORIGIN & UINT8_MAX);
+						instance.write(cc65c::emulator::VECTOR_RESET + 1, EMULATOR_ORIGIN >> CHAR_BIT);
+						instance.load(gen.segment_begin(), gen.segment_end());
+						instance.reset();
+
+						begin = std::chrono::high_resolution_clock::now();
+						executed = instance.run(cycles);
+						report(cached ? "BLOCK" : "INTERPRET", executed, instance.instructions(), begin);
+
+						if(executed < cycles) {
+							THROW_EXCEPTION_FORMAT("Cycle mismatch", "Expecting=%llu, Found=%llu", cycles, executed);
+						}
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static void 
+				report(
+					__in const std::string &name,
+					__in uint64_t cycles,
+					__in uint64_t instructions,
+					__in const std::chrono::high_resolution_clock::time_point &begin
+					)
+				{
+					double elapsed;
+
+					TRACE_ENTRY();
+
+					elapsed = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() 
+						- begin).count();
+					std::cout << "EMULATOR_" << name << "[" << cycles << "]: " << std::fixed << std::setprecision(3) 
+						<< (elapsed / 1000.0) << " ms (" << (cycles / elapsed) << " MHz, " 
+						<< (instructions / elapsed) << " MIPS)" << std::endl;
+
+					TRACE_EXIT();
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(EMULATOR_SUITE_NAME);
+		cc65c::test::fixture_emulator test; 
+		suite.add(test);
+		result = suite.run(EMULATOR_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
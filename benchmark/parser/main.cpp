@@ -0,0 +1,649 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <getopt.h>
+#include <numeric>
+#include <random>
+#include "../../include/runtime.h"
+#include "../../include/assembler/parser.h"
+#include "../../include/core/counter.h"
+#include "../../include/test/suite.h"
+#include "../baseline.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define PARSER_FIXTURE_NAME "PARSER_FIXTURE"
+		#define PARSER_SUITE_NAME "PARSER_SUITE"
+
+		#define CORPUS_LABEL_MAX 0x100
+		#define CORPUS_SEED 0x6502
+		#define CORPUS_SIZE_MAX (100 * 1024 * 1024)
+		#define CORPUS_SIZE_MIN 1024
+
+		#define PARSER_PERCENTILE 95
+		#define PARSER_REPETITION 10
+
+		enum {
+			CORPUS_MIX_COMMAND = 0,
+			CORPUS_MIX_COMMENT,
+			CORPUS_MIX_DATA,
+			CORPUS_MIX_EXPRESSION,
+			CORPUS_MIX_LABEL,
+		};
+
+		#define CORPUS_MIX_MAX CORPUS_MIX_LABEL
+
+		static const std::vector<uint32_t> CORPUS_MIX_DEFAULT = {
+			50, 10, 15, 15, 10,
+			};
+
+		static const std::string CORPUS_COMMAND[] = {
+			"adc", "and", "cmp", "eor", "lda", "ora", "sbc",
+			};
+
+		#define CORPUS_COMMAND_MAX (sizeof(CORPUS_COMMAND) / sizeof(CORPUS_COMMAND[0]))
+
+		static const std::string CORPUS_COMMAND_IMPLIED[] = {
+			"clc", "dex", "dey", "inx", "iny", "nop", "pha", "pla", "rts", "sec", "tax", "tay", "txa", "tya",
+			};
+
+		#define CORPUS_COMMAND_IMPLIED_MAX (sizeof(CORPUS_COMMAND_IMPLIED) / sizeof(CORPUS_COMMAND_IMPLIED[0]))
+
+		static const std::string CORPUS_WORD[] = {
+			"buffer", "copy", "count", "frame", "index", "loop", "pointer", "restore", "save", "update",
+			};
+
+		#define CORPUS_WORD_MAX (sizeof(CORPUS_WORD) / sizeof(CORPUS_WORD[0]))
+
+		static const std::vector<size_t> PARSER_BENCHMARK_SET = {
+			1024, 64 * 1024, 1024 * 1024,
+			};
+
+		class corpus {
+
+			public:
+
+				corpus(
+					__in const std::vector<uint32_t> &mix,
+					__in_opt uint32_t seed = CORPUS_SEED
+					) :
+						m_define(0),
+						m_label(0),
+						m_mix(mix),
+						m_random(seed)
+				{
+					TRACE_ENTRY();
+
+					if((m_mix.size() != (CORPUS_MIX_MAX + 1))
+							|| !std::accumulate(m_mix.begin(), m_mix.end(), (uint32_t) 0)) {
+						THROW_EXCEPTION_FORMAT("Invalid corpus mix", "Count=%u", m_mix.size());
+					}
+
+					TRACE_EXIT();
+				}
+
+				std::string 
+				generate(
+					__in size_t size
+					)
+				{
+					std::stringstream result;
+					std::discrete_distribution<uint32_t> statement(m_mix.begin(), m_mix.end());
+
+					TRACE_ENTRY();
+
+					if((size < CORPUS_SIZE_MIN) || (size > CORPUS_SIZE_MAX)) {
+						THROW_EXCEPTION_FORMAT("Invalid corpus size", "Size=%u", size);
+					}
+
+					m_define = 0;
+					m_label = 0;
+					result << "; CC65C synthetic corpus" << std::endl << std::endl << "org 0x0200" << std::endl
+						<< std::endl << "label_0:" << std::endl;
+
+					while(((size_t) result.tellp()) < size) {
+
+						switch(statement(m_random)) {
+							case CORPUS_MIX_COMMAND:
+								generate_command(result);
+								break;
+							case CORPUS_MIX_COMMENT:
+								result << "; " << word() << " " << word() << " " << word() << std::endl;
+								break;
+							case CORPUS_MIX_DATA:
+								generate_data(result);
+								break;
+							case CORPUS_MIX_EXPRESSION:
+								result << "def " << word() << "_" << m_define++ << " "
+									<< expression() << std::endl;
+								break;
+							case CORPUS_MIX_LABEL:
+								result << "label_" << ++m_label << ":" << std::endl;
+								break;
+							default:
+								break;
+						}
+					}
+
+					TRACE_EXIT();
+					return result.str();
+				}
+
+			protected:
+
+				std::string 
+				expression(void)
+				{
+					std::stringstream result;
+
+					TRACE_ENTRY();
+
+					switch(uniform(4)) {
+						case 0:
+							result << "(" << label() << " + " << uniform(UINT8_MAX) << ") * " << (uniform(4) + 1);
+							break;
+						case 1:
+							result << "high(" << label() << " + 0x" << std::hex << uniform(UINT8_MAX) << ")";
+							break;
+						case 2:
+							result << "low(" << label() << ") | 0x" << std::hex << uniform(UINT8_MAX);
+							break;
+						default:
+							result << label() << " - " << label() << " + " << uniform(UINT8_MAX);
+							break;
+					}
+
+					TRACE_EXIT();
+					return result.str();
+				}
+
+				void 
+				generate_command(
+					__inout std::stringstream &stream
+					)
+				{
+					const std::string &command = CORPUS_COMMAND[uniform(CORPUS_COMMAND_MAX)];
+
+					TRACE_ENTRY();
+
+					stream << "\t";
+
+					switch(uniform(8)) {
+						case 0:
+							stream << command << " #0x" << std::hex << uniform(UINT8_MAX) << std::dec;
+							break;
+						case 1:
+							stream << command << " #low(" << expression() << ")";
+							break;
+						case 2:
+							stream << command << " 0x" << std::hex << uniform(UINT16_MAX) << std::dec << ", x";
+							break;
+						case 3:
+							stream << command << " [0x" << std::hex << uniform(UINT8_MAX) << std::dec << "], y";
+							break;
+						case 4:
+							stream << "bne $ - " << uniform(INT8_MAX);
+							break;
+						case 5:
+							stream << ((uniform(2) == 0) ? "jmp " : "jsr ") << label();
+							break;
+						case 6:
+							stream << "sta " << label() << ", y";
+							break;
+						default:
+							stream << CORPUS_COMMAND_IMPLIED[uniform(CORPUS_COMMAND_IMPLIED_MAX)];
+							break;
+					}
+
+					if(uniform(4) == 0) {
+						stream << "\t\t; " << word();
+					}
+
+					stream << std::endl;
+
+					TRACE_EXIT();
+				}
+
+				void 
+				generate_data(
+					__inout std::stringstream &stream
+					)
+				{
+					size_t count, index;
+
+					TRACE_ENTRY();
+
+					count = (uniform(8) + 1);
+
+					switch(uniform(3)) {
+						case 0:
+							stream << "\tdb ";
+
+							for(index = 0; index < count; ++index) {
+								stream << (index ? ", " : "") << "0x" << std::hex << uniform(UINT8_MAX) << std::dec;
+							}
+							break;
+						case 1:
+							stream << "\tdw ";
+
+							for(index = 0; index < count; ++index) {
+								stream << (index ? ", " : "") << label();
+							}
+							break;
+						default:
+							stream << "\tdb \"" << word() << " " << word() << "\", 0";
+							break;
+					}
+
+					stream << std::endl;
+
+					TRACE_EXIT();
+				}
+
+				std::string 
+				label(void)
+				{
+					std::string result;
+
+					TRACE_ENTRY();
+
+					result = "label_" + std::to_string(m_label - uniform(std::min(m_label + 1,
+						(size_t) CORPUS_LABEL_MAX)));
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				size_t 
+				uniform(
+					__in size_t bound
+					)
+				{
+					size_t result;
+
+					TRACE_ENTRY();
+
+					result = std::uniform_int_distribution<size_t>(0, bound - 1)(m_random);
+
+					TRACE_EXIT_FORMAT("Result=%u", result);
+					return result;
+				}
+
+				const std::string & 
+				word(void)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+					return CORPUS_WORD[uniform(CORPUS_WORD_MAX)];
+				}
+
+				size_t m_define;
+
+				size_t m_label;
+
+				std::vector<uint32_t> m_mix;
+
+				std::mt19937 m_random;
+		};
+
+		class fixture_parser :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_parser(
+					__in const std::vector<size_t> &size,
+					__in const std::vector<uint32_t> &mix,
+					__in size_t repetition,
+					__inout cc65c::test::baseline &metric
+					) :
+						cc65c::test::fixture(PARSER_FIXTURE_NAME),
+						m_metric(metric),
+						m_mix(mix),
+						m_repetition(repetition),
+						m_size(size)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<size_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = m_size.begin(); iter != m_size.end(); ++iter) {
+
+						result = benchmark(*iter);
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Benchmark failure", "Size=%u", *iter);
+							break;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				cc65c::test::status_t 
+				benchmark(
+					__in size_t size
+					)
+				{
+					std::string input;
+					size_t index, statements = 0, tokens = 0;
+					std::vector<double> elapsed_lexer, elapsed_parser;
+					std::map<std::string, std::vector<double>> counter_lexer, counter_parser;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::chrono::high_resolution_clock::time_point begin;
+
+					TRACE_ENTRY();
+
+					try {
+						input = corpus(m_mix).generate(size);
+						cc65c::assembler::parser(input, false).enumerate();
+
+						for(index = 0; index < m_repetition; ++index) {
+							cc65c::assembler::lexer lex(input, false);
+
+							cc65c::core::counter::acquire().reset();
+							begin = std::chrono::high_resolution_clock::now();
+							tokens = lex.enumerate();
+							elapsed_lexer.push_back(std::chrono::duration<double, std::micro>(
+								std::chrono::high_resolution_clock::now() - begin).count());
+							sample(counter_lexer);
+						}
+
+						for(index = 0; index < m_repetition; ++index) {
+							cc65c::assembler::parser par(input, false);
+
+							cc65c::core::counter::acquire().reset();
+							begin = std::chrono::high_resolution_clock::now();
+							statements = par.enumerate();
+							elapsed_parser.push_back(std::chrono::duration<double, std::micro>(
+								std::chrono::high_resolution_clock::now() - begin).count());
+							sample(counter_parser);
+						}
+
+						report("LEXER", input.size(), tokens, statements, elapsed_lexer);
+						report_counter("LEXER", input.size(), counter_lexer);
+						report("PARSER", input.size(), tokens, statements, elapsed_parser);
+						report_counter("PARSER", input.size(), counter_parser);
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				void 
+				report(
+					__in const std::string &name,
+					__in size_t size,
+					__in size_t tokens,
+					__in size_t statements,
+					__inout std::vector<double> &elapsed
+					)
+				{
+					double median, percentile;
+
+					TRACE_ENTRY();
+
+					m_metric.add(name + "/" + std::to_string(size), elapsed);
+					std::sort(elapsed.begin(), elapsed.end());
+					median = elapsed.at(elapsed.size() / 2);
+					percentile = elapsed.at(std::min(elapsed.size() - 1,
+						(size_t) ((elapsed.size() * PARSER_PERCENTILE) / 100)));
+
+					std::cout << "PARSER_" << name << "[" << size << "]: " << std::fixed << std::setprecision(3)
+						<< (median / 1000.0) << " ms median, " << (percentile / 1000.0) << " ms p"
+						<< PARSER_PERCENTILE << " (" << (size / median) << " MB/s, " << (tokens / median)
+						<< " Mtokens/s, " << (statements / median) << " Mstatements/s, " << elapsed.size()
+						<< " runs)" << std::endl;
+
+					TRACE_EXIT();
+				}
+
+				void 
+				report_counter(
+					__in const std::string &name,
+					__in size_t size,
+					__inout std::map<std::string, std::vector<double>> &counter
+					)
+				{
+					std::map<std::string, std::vector<double>>::iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = counter.begin(); iter != counter.end(); ++iter) {
+						m_metric.add(name + "/" + std::to_string(size) + "/" + iter->first, iter->second);
+						std::sort(iter->second.begin(), iter->second.end());
+						std::cout << "PARSER_" << name << "_COUNTER[" << size << "]: " << iter->first << " "
+							<< std::fixed << std::setprecision(0) << iter->second.at(iter->second.size() / 2)
+							<< " median (" << std::setprecision(3) << (iter->second.at(iter->second.size() / 2)
+								/ size) << " per byte)" << std::endl;
+					}
+
+					TRACE_EXIT();
+				}
+
+				static void 
+				sample(
+					__inout std::map<std::string, std::vector<double>> &counter
+					)
+				{
+					size_t event, phase;
+					cc65c::core::counter_metadata_t entry;
+
+					TRACE_ENTRY();
+
+					cc65c::core::counter &instance = cc65c::core::counter::acquire();
+					if(instance.available()) {
+
+						for(phase = 0; phase <= COUNTER_PHASE_MAX; ++phase) {
+
+							entry = instance.metadata((cc65c::core::counter_phase_t) phase);
+							if(!std::get<cc65c::core::COUNTER_METADATA_ENTRY>(entry)) {
+								continue;
+							}
+
+							for(event = 0; event <= COUNTER_EVENT_MAX; ++event) {
+								counter[std::string(COUNTER_PHASE_STRING(phase)) + "/" + COUNTER_EVENT_STRING(event)]
+									.push_back(std::get<cc65c::core::COUNTER_METADATA_EVENT>(entry).at(event));
+							}
+						}
+					}
+
+					TRACE_EXIT();
+				}
+
+				cc65c::test::baseline &m_metric;
+
+				std::vector<uint32_t> m_mix;
+
+				size_t m_repetition;
+
+				std::vector<size_t> m_size;
+		};
+	}
+}
+
+static size_t 
+parse_size(
+	__in const std::string &input
+	)
+{
+	size_t result;
+	std::string suffix;
+	std::stringstream stream(input);
+
+	stream >> result >> suffix;
+
+	if(suffix == "K") {
+		result *= 1024;
+	} else if(suffix == "M") {
+		result *= 1024 * 1024;
+	} else if(!suffix.empty()) {
+		THROW_EXCEPTION_FORMAT("Invalid size", "Size=%s", STRING_CHECK(input));
+	}
+
+	return result;
+}
+
+int 
+main(
+	__in int argc,
+	__in char *argv[]
+	)
+{
+	int option;
+	std::stringstream stream;
+	std::vector<size_t> size;
+	cc65c::test::baseline metric;
+	bool regression = false;
+	double threshold = BENCHMARK_THRESHOLD;
+	std::string compare, entry, output, record;
+	std::vector<uint32_t> mix = cc65c::test::CORPUS_MIX_DEFAULT;
+	size_t repetition = PARSER_REPETITION;
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+
+		while((option = getopt(argc, argv, "B:C:m:o:r:s:t:")) != -1) {
+
+			switch(option) {
+				case 'B':
+					record = optarg;
+					break;
+				case 'C':
+					compare = optarg;
+					break;
+				case 'm':
+					mix.clear();
+					stream.clear();
+					stream.str(optarg);
+
+					while(std::getline(stream, entry, ',')) {
+						mix.push_back(std::stoul(entry));
+					}
+					break;
+				case 'o':
+					output = optarg;
+					break;
+				case 'r':
+					repetition = std::stoul(optarg);
+					break;
+				case 's':
+					size.push_back(parse_size(optarg));
+					break;
+				case 't':
+					threshold = (std::stod(optarg) / 100.0);
+					break;
+				default:
+					std::cerr << "Usage: " << argv[0] << " [-B BASELINE] [-C BASELINE] "
+						<< "[-m COMMAND,COMMENT,DATA,EXPRESSION,LABEL] [-o OUTPUT] [-r REPETITIONS] [-s SIZE[K|M]]... "
+						<< "[-t THRESHOLD]" << std::endl;
+					return result;
+			}
+		}
+
+		if(size.empty()) {
+			size = cc65c::test::PARSER_BENCHMARK_SET;
+		}
+
+		if(!output.empty()) {
+			std::ofstream file(output.c_str(), std::ios::out | std::ios::trunc);
+			if(!file) {
+				THROW_EXCEPTION_FORMAT("Failed to open file", "Path=%s", STRING_CHECK(output));
+			}
+
+			file << cc65c::test::corpus(mix).generate(size.front());
+			file.close();
+			return cc65c::test::STATUS_SUCCESS;
+		}
+
+		if(!repetition) {
+			THROW_EXCEPTION_FORMAT("Invalid repetition count", "Count=%u", repetition);
+		}
+
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::core::counter::acquire().initialize();
+		cc65c::test::suite suite(PARSER_SUITE_NAME);
+		cc65c::test::fixture_parser test(size, mix, repetition, metric);
+		suite.add(test);
+		result = suite.run(PARSER_FIXTURE_NAME);
+
+		if(result == cc65c::test::STATUS_SUCCESS) {
+
+			if(!compare.empty()) {
+				regression = !metric.compare(compare, threshold);
+			}
+
+			if(!record.empty()) {
+				metric.write(record);
+			}
+		}
+
+		cc65c::core::counter::acquire().uninitialize();
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	} catch(std::exception &exc) {
+		std::cerr << exc.what() << std::endl;
+	}
+
+	if(!compare.empty() || !record.empty()) {
+		return (((result == cc65c::test::STATUS_SUCCESS) && !regression) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	return result;
+}
@@ -0,0 +1,205 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include "../../include/runtime.h"
+#include "../../include/assembler/table.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define TABLE_FIXTURE_NAME "TABLE_FIXTURE"
+		#define TABLE_SUITE_NAME "TABLE_SUITE"
+
+		#define TABLE_SEED 0x6502
+
+		static const std::vector<size_t> TABLE_BENCHMARK_SET = {
+			10000, 100000, 1000000,
+			};
+
+		class fixture_table :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_table(void) :
+					cc65c::test::fixture(TABLE_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<size_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = TABLE_BENCHMARK_SET.begin(); iter != TABLE_BENCHMARK_SET.end(); ++iter) {
+
+						result = benchmark(*iter);
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Benchmark failure", "Count=%u", *iter);
+							break;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static cc65c::test::status_t 
+				benchmark(
+					__in size_t count
+					)
+				{
+					size_t index;
+					std::vector<size_t> order, resolved;
+					std::vector<std::string> name;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::chrono::high_resolution_clock::time_point begin;
+
+					TRACE_ENTRY();
+
+					for(index = 0; index < count; ++index) {
+						name.push_back("symbol_" + std::to_string(index));
+						order.push_back(index);
+					}
+
+					std::shuffle(order.begin(), order.end(), std::mt19937(TABLE_SEED));
+
+					try {
+						cc65c::assembler::table insert;
+
+						begin = std::chrono::high_resolution_clock::now();
+
+						for(index = 0; index < count; ++index) {
+							insert.define(insert.intern(name.at(index)), cc65c::assembler::TABLE_SYMBOL_LABEL, index, 
+								resolved);
+						}
+
+						report("INSERT", count, begin);
+						begin = std::chrono::high_resolution_clock::now();
+
+						for(index = 0; index < count; ++index) {
+
+							if(insert.find(name.at(order.at(index))) != order.at(index)) {
+								THROW_EXCEPTION_FORMAT("Lookup mismatch", "Name=%s", 
+									STRING_CHECK(name.at(order.at(index))));
+							}
+						}
+
+						report("LOOKUP", count, begin);
+
+						cc65c::assembler::table pending;
+
+						for(index = 0; index < count; ++index) {
+							pending.wait(pending.intern(name.at(index)), index);
+						}
+
+						begin = std::chrono::high_resolution_clock::now();
+
+						for(index = 0; index < count; ++index) {
+							pending.define(pending.find(name.at(order.at(index))), cc65c::assembler::TABLE_SYMBOL_LABEL, 
+								index, resolved);
+						}
+
+						report("RESOLVE", count, begin);
+
+						if(resolved.size() != count) {
+							THROW_EXCEPTION_FORMAT("Resolve mismatch", "Expecting=%u, Found=%u", count, resolved.size());
+						}
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static void 
+				report(
+					__in const std::string &name,
+					__in size_t count,
+					__in const std::chrono::high_resolution_clock::time_point &begin
+					)
+				{
+					double elapsed;
+
+					TRACE_ENTRY();
+
+					elapsed = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() 
+						- begin).count();
+					std::cout << "TABLE_" << name << "[" << count << "]: " << std::fixed << std::setprecision(3) 
+						<< (elapsed / 1000000.0) << " ms (" << (elapsed / count) << " ns/op)" << std::endl;
+
+					TRACE_EXIT();
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(TABLE_SUITE_NAME);
+		cc65c::test::fixture_table test; 
+		suite.add(test);
+		result = suite.run(TABLE_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
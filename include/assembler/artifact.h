@@ -0,0 +1,162 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_ARTIFACT_H_
+#define CC65C_ASSEMBLER_ARTIFACT_H_
+
+#include <map>
+#include <set>
+#include <vector>
+#include "../core/singleton.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define ARTIFACT_MANIFEST_EXTENSION ".ccm"
+		#define ARTIFACT_RESULT_EXTENSION ".cca"
+		#define ARTIFACT_STATISTICS "stats"
+
+		class artifact :
+				public cc65c::core::singleton<cc65c::assembler::artifact> {
+
+			public:
+
+				~artifact(void);
+
+				void clear(void);
+
+				std::string directory(void);
+
+				bool fetch(
+					__in const std::string &input,
+					__in const std::map<std::string, int32_t> &define,
+					__in const std::vector<std::string> &output,
+					__in_opt bool relax = false,
+					__in_opt bool peephole = false
+					);
+
+				size_t hits(void);
+
+				void initialize(void);
+
+				size_t misses(void);
+
+				void set_directory(
+					__in const std::string &directory
+					);
+
+				void statistics(
+					__inout size_t &hits,
+					__inout size_t &misses
+					);
+
+				void store(
+					__in const std::string &input,
+					__in const std::map<std::string, int32_t> &define,
+					__in const std::set<std::string> &dependency,
+					__in const std::vector<std::string> &output,
+					__in_opt bool relax = false,
+					__in_opt bool peephole = false
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				friend class cc65c::core::singleton<cc65c::assembler::artifact>;
+
+				artifact(void);
+
+				artifact(
+					__in const artifact &other
+					) = delete;
+
+				artifact &operator=(
+					__in const artifact &other
+					) = delete;
+
+				static std::string as_string(
+					__in const artifact &reference,
+					__in_opt bool verbose = false
+					);
+
+				bool key_manifest(
+					__in const std::string &input,
+					__in const std::map<std::string, int32_t> &define,
+					__in const std::vector<std::string> &output,
+					__in bool relax,
+					__in bool peephole,
+					__inout uint64_t &key
+					);
+
+				bool key_result(
+					__in uint64_t manifest,
+					__in const std::vector<std::pair<std::string, uint64_t>> &dependency,
+					__inout uint64_t &key
+					);
+
+				bool load_manifest(
+					__in const std::string &data,
+					__inout std::vector<std::pair<std::string, uint64_t>> &dependency
+					);
+
+				bool load_result(
+					__in const std::string &data,
+					__in const std::vector<std::string> &output
+					);
+
+				std::string path(
+					__in const std::string &name
+					);
+
+				std::string path(
+					__in uint64_t key,
+					__in const std::string &extension
+					);
+
+				static bool read(
+					__in const std::string &path,
+					__inout std::string &data
+					);
+
+				void record(
+					__in bool hit
+					);
+
+				static bool write(
+					__in const std::string &path,
+					__in const std::string &data
+					);
+
+				std::mutex m_artifact_mutex;
+
+				std::string m_directory;
+
+				size_t m_hits;
+
+				size_t m_misses;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_ARTIFACT_H_
@@ -0,0 +1,132 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_CACHE_H_
+#define CC65C_ASSEMBLER_CACHE_H_
+
+#include "tree.h"
+#include "../core/singleton.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define CACHE_EXTENSION ".ccp"
+
+		class cache :
+				public cc65c::core::singleton<cc65c::assembler::cache> {
+
+			public:
+
+				~cache(void);
+
+				void clear(void);
+
+				std::string directory(void);
+
+				size_t hits(void);
+
+				void initialize(void);
+
+				size_t misses(void);
+
+				const std::vector<cc65c::assembler::tree> &parse(
+					__in const std::string &path
+					);
+
+				void set_directory(
+					__in const std::string &directory
+					);
+
+				size_t size(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				friend class cc65c::core::singleton<cc65c::assembler::cache>;
+
+				cache(void);
+
+				cache(
+					__in const cache &other
+					) = delete;
+
+				cache &operator=(
+					__in const cache &other
+					) = delete;
+
+				static std::string as_string(
+					__in const cache &reference,
+					__in_opt bool verbose = false
+					);
+
+				static bool deserialize(
+					__in const std::string &data,
+					__inout size_t &position,
+					__inout cc65c::assembler::tree &tree
+					);
+
+				static bool is_stale(
+					__in const std::map<std::string, uint64_t> &dependency
+					);
+
+				bool load(
+					__in uint64_t key,
+					__inout std::vector<cc65c::assembler::tree> &entry
+					);
+
+				std::string path(
+					__in uint64_t key
+					);
+
+				static bool read(
+					__in const std::string &path,
+					__inout std::string &data
+					);
+
+				static void serialize(
+					__inout std::string &data,
+					__inout cc65c::assembler::tree &tree
+					);
+
+				void store(
+					__in uint64_t key,
+					__in const std::vector<cc65c::assembler::tree> &entry
+					);
+
+				std::mutex m_cache_mutex;
+
+				std::map<uint64_t, std::map<std::string, uint64_t>> m_dependency;
+
+				std::string m_directory;
+
+				std::map<uint64_t, std::vector<cc65c::assembler::tree>> m_entry;
+
+				size_t m_hits;
+
+				size_t m_misses;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_CACHE_H_
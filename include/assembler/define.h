@@ -146,12 +146,12 @@ namespace cc65c {
 			((_TYPE_) > ADDRESS_MODE_MAX ? STRING_UNKNOWN : STRING_CHECK(ADDRESS_MODE_STR[_TYPE_]))
 
 		static const std::set<uint32_t> ADDRESS_MODE_ABSOLUTE_SET = {
-			KEYWORD_COMMAND_ADC, KEYWORD_COMMAND_AND, KEYWORD_COMMAND_ASL, KEYWORD_COMMAND_BIT, KEYWORD_COMMAND_BRK,
-			KEYWORD_COMMAND_CMP, KEYWORD_COMMAND_CPX, KEYWORD_COMMAND_CPY, KEYWORD_COMMAND_DEC, KEYWORD_COMMAND_EOR,
-			KEYWORD_COMMAND_INC, KEYWORD_COMMAND_JMP, KEYWORD_COMMAND_JSR, KEYWORD_COMMAND_LDA, KEYWORD_COMMAND_LDX,
-			KEYWORD_COMMAND_LDY, KEYWORD_COMMAND_LSR, KEYWORD_COMMAND_ORA, KEYWORD_COMMAND_ROL, KEYWORD_COMMAND_ROR,
-			KEYWORD_COMMAND_SBC, KEYWORD_COMMAND_STA, KEYWORD_COMMAND_STX, KEYWORD_COMMAND_STY, KEYWORD_COMMAND_STZ,
-			KEYWORD_COMMAND_TRB, KEYWORD_COMMAND_TSB,
+			KEYWORD_COMMAND_ADC, KEYWORD_COMMAND_AND, KEYWORD_COMMAND_ASL, KEYWORD_COMMAND_BIT, KEYWORD_COMMAND_CMP,
+			KEYWORD_COMMAND_CPX, KEYWORD_COMMAND_CPY, KEYWORD_COMMAND_DEC, KEYWORD_COMMAND_EOR, KEYWORD_COMMAND_INC,
+			KEYWORD_COMMAND_JMP, KEYWORD_COMMAND_JSR, KEYWORD_COMMAND_LDA, KEYWORD_COMMAND_LDX, KEYWORD_COMMAND_LDY,
+			KEYWORD_COMMAND_LSR, KEYWORD_COMMAND_ORA, KEYWORD_COMMAND_ROL, KEYWORD_COMMAND_ROR, KEYWORD_COMMAND_SBC,
+			KEYWORD_COMMAND_STA, KEYWORD_COMMAND_STX, KEYWORD_COMMAND_STY, KEYWORD_COMMAND_STZ, KEYWORD_COMMAND_TRB,
+			KEYWORD_COMMAND_TSB,
 			};
 
 		#define ADDRESS_MODE_ABSOLUTE_CONTAINS(_TYPE_) \
@@ -227,23 +227,55 @@ namespace cc65c {
 		#define ADDRESS_MODE_RELATIVE_CONTAINS(_TYPE_) \
 			(ADDRESS_MODE_RELATIVE_SET.find(_TYPE_) != ADDRESS_MODE_RELATIVE_SET.end())
 
+		static const std::set<uint32_t> ADDRESS_MODE_RELATIVE_BIT_SET = {
+			KEYWORD_COMMAND_BBR0, KEYWORD_COMMAND_BBR1, KEYWORD_COMMAND_BBR2, KEYWORD_COMMAND_BBR3, KEYWORD_COMMAND_BBR4,
+			KEYWORD_COMMAND_BBR5, KEYWORD_COMMAND_BBR6, KEYWORD_COMMAND_BBR7, KEYWORD_COMMAND_BBS0, KEYWORD_COMMAND_BBS1, 
+			KEYWORD_COMMAND_BBS2, KEYWORD_COMMAND_BBS3, KEYWORD_COMMAND_BBS4, KEYWORD_COMMAND_BBS5, KEYWORD_COMMAND_BBS6, 
+			KEYWORD_COMMAND_BBS7,
+			};
+
+		#define ADDRESS_MODE_RELATIVE_BIT_CONTAINS(_TYPE_) \
+			(ADDRESS_MODE_RELATIVE_BIT_SET.find(_TYPE_) != ADDRESS_MODE_RELATIVE_BIT_SET.end())
+
+		static const std::map<uint32_t, uint32_t> ADDRESS_MODE_RELATIVE_INVERSE = {
+			{ KEYWORD_COMMAND_BBR0, KEYWORD_COMMAND_BBS0, }, { KEYWORD_COMMAND_BBR1, KEYWORD_COMMAND_BBS1, },
+			{ KEYWORD_COMMAND_BBR2, KEYWORD_COMMAND_BBS2, }, { KEYWORD_COMMAND_BBR3, KEYWORD_COMMAND_BBS3, },
+			{ KEYWORD_COMMAND_BBR4, KEYWORD_COMMAND_BBS4, }, { KEYWORD_COMMAND_BBR5, KEYWORD_COMMAND_BBS5, },
+			{ KEYWORD_COMMAND_BBR6, KEYWORD_COMMAND_BBS6, }, { KEYWORD_COMMAND_BBR7, KEYWORD_COMMAND_BBS7, },
+			{ KEYWORD_COMMAND_BBS0, KEYWORD_COMMAND_BBR0, }, { KEYWORD_COMMAND_BBS1, KEYWORD_COMMAND_BBR1, },
+			{ KEYWORD_COMMAND_BBS2, KEYWORD_COMMAND_BBR2, }, { KEYWORD_COMMAND_BBS3, KEYWORD_COMMAND_BBR3, },
+			{ KEYWORD_COMMAND_BBS4, KEYWORD_COMMAND_BBR4, }, { KEYWORD_COMMAND_BBS5, KEYWORD_COMMAND_BBR5, },
+			{ KEYWORD_COMMAND_BBS6, KEYWORD_COMMAND_BBR6, }, { KEYWORD_COMMAND_BBS7, KEYWORD_COMMAND_BBR7, },
+			{ KEYWORD_COMMAND_BCC, KEYWORD_COMMAND_BCS, }, { KEYWORD_COMMAND_BCS, KEYWORD_COMMAND_BCC, },
+			{ KEYWORD_COMMAND_BEQ, KEYWORD_COMMAND_BNE, }, { KEYWORD_COMMAND_BMI, KEYWORD_COMMAND_BPL, },
+			{ KEYWORD_COMMAND_BNE, KEYWORD_COMMAND_BEQ, }, { KEYWORD_COMMAND_BPL, KEYWORD_COMMAND_BMI, },
+			{ KEYWORD_COMMAND_BVC, KEYWORD_COMMAND_BVS, }, { KEYWORD_COMMAND_BVS, KEYWORD_COMMAND_BVC, },
+			};
+
+		#define ADDRESS_MODE_RELATIVE_INVERSE_CONTAINS(_TYPE_) \
+			(ADDRESS_MODE_RELATIVE_INVERSE.find(_TYPE_) != ADDRESS_MODE_RELATIVE_INVERSE.end())
+		#define ADDRESS_MODE_RELATIVE_INVERSE_VALUE(_TYPE_) \
+			(ADDRESS_MODE_RELATIVE_INVERSE.find(_TYPE_)->second)
+
 		static const std::set<uint32_t> ADDRESS_MODE_STACK_SET = {
-			KEYWORD_COMMAND_PHA, KEYWORD_COMMAND_PHP, KEYWORD_COMMAND_PHX, KEYWORD_COMMAND_PHY, KEYWORD_COMMAND_PLA,
-			KEYWORD_COMMAND_PLP, KEYWORD_COMMAND_PLX, KEYWORD_COMMAND_PLY, KEYWORD_COMMAND_RTI, KEYWORD_COMMAND_RTS
+			KEYWORD_COMMAND_BRK, KEYWORD_COMMAND_PHA, KEYWORD_COMMAND_PHP, KEYWORD_COMMAND_PHX, KEYWORD_COMMAND_PHY,
+			KEYWORD_COMMAND_PLA, KEYWORD_COMMAND_PLP, KEYWORD_COMMAND_PLX, KEYWORD_COMMAND_PLY, KEYWORD_COMMAND_RTI,
+			KEYWORD_COMMAND_RTS
 			};
 
 		#define ADDRESS_MODE_STACK_CONTAINS(_TYPE_) \
 			(ADDRESS_MODE_STACK_SET.find(_TYPE_) != ADDRESS_MODE_STACK_SET.end())
 
 		static const std::set<uint32_t> ADDRESS_MODE_ZERO_PAGE_SET = {
-			KEYWORD_COMMAND_ADC, KEYWORD_COMMAND_AND, KEYWORD_COMMAND_ASL, KEYWORD_COMMAND_BIT, KEYWORD_COMMAND_CMP,
-			KEYWORD_COMMAND_CPX, KEYWORD_COMMAND_CPY, KEYWORD_COMMAND_DEC, KEYWORD_COMMAND_EOR, KEYWORD_COMMAND_INC,
-			KEYWORD_COMMAND_LDA, KEYWORD_COMMAND_LDX, KEYWORD_COMMAND_LDY, KEYWORD_COMMAND_LSR, KEYWORD_COMMAND_ORA,
-			KEYWORD_COMMAND_RMB0, KEYWORD_COMMAND_RMB1, KEYWORD_COMMAND_RMB2, KEYWORD_COMMAND_RMB3, KEYWORD_COMMAND_RMB4,
-			KEYWORD_COMMAND_RMB5, KEYWORD_COMMAND_RMB6, KEYWORD_COMMAND_RMB7, KEYWORD_COMMAND_ROL, KEYWORD_COMMAND_ROR,
-			KEYWORD_COMMAND_SBC, KEYWORD_COMMAND_SMB0, KEYWORD_COMMAND_SMB1, KEYWORD_COMMAND_SMB2, KEYWORD_COMMAND_SMB3,
-			KEYWORD_COMMAND_SMB4, KEYWORD_COMMAND_SMB5, KEYWORD_COMMAND_SMB6, KEYWORD_COMMAND_SMB7, KEYWORD_COMMAND_STA,
-			KEYWORD_COMMAND_STX, KEYWORD_COMMAND_STY, KEYWORD_COMMAND_STZ, KEYWORD_COMMAND_TRB, KEYWORD_COMMAND_TSB,
+			KEYWORD_COMMAND_ADC, KEYWORD_COMMAND_AND, KEYWORD_COMMAND_ASL, KEYWORD_COMMAND_BIT, KEYWORD_COMMAND_BRK,
+			KEYWORD_COMMAND_CMP, KEYWORD_COMMAND_CPX, KEYWORD_COMMAND_CPY, KEYWORD_COMMAND_DEC, KEYWORD_COMMAND_EOR,
+			KEYWORD_COMMAND_INC, KEYWORD_COMMAND_LDA, KEYWORD_COMMAND_LDX, KEYWORD_COMMAND_LDY, KEYWORD_COMMAND_LSR,
+			KEYWORD_COMMAND_ORA, KEYWORD_COMMAND_RMB0, KEYWORD_COMMAND_RMB1, KEYWORD_COMMAND_RMB2, KEYWORD_COMMAND_RMB3,
+			KEYWORD_COMMAND_RMB4, KEYWORD_COMMAND_RMB5, KEYWORD_COMMAND_RMB6, KEYWORD_COMMAND_RMB7, KEYWORD_COMMAND_ROL,
+			KEYWORD_COMMAND_ROR, KEYWORD_COMMAND_SBC, KEYWORD_COMMAND_SMB0, KEYWORD_COMMAND_SMB1, KEYWORD_COMMAND_SMB2,
+			KEYWORD_COMMAND_SMB3, KEYWORD_COMMAND_SMB4, KEYWORD_COMMAND_SMB5, KEYWORD_COMMAND_SMB6, KEYWORD_COMMAND_SMB7,
+			KEYWORD_COMMAND_STA, KEYWORD_COMMAND_STX, KEYWORD_COMMAND_STY, KEYWORD_COMMAND_STZ, KEYWORD_COMMAND_TRB,
+			KEYWORD_COMMAND_TSB,
 			};
 
 		#define ADDRESS_MODE_ZERO_PAGE_CONTAINS(_TYPE_) \
@@ -290,6 +322,334 @@ namespace cc65c {
 		#define ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX_CONTAINS(_TYPE_) \
 			(ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX_SET.find(_TYPE_) != ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX_SET.end())
 
+		static const size_t ADDRESS_MODE_LENGTH[] = {
+			3, 3, 3, 3, 3, 1, 2, 1, 2, 1, 2, 2, 2, 2, 2, 2,
+			};
+
+		#define ADDRESS_MODE_LENGTH_VALUE(_TYPE_) \
+			((_TYPE_) > ADDRESS_MODE_MAX ? 0 : ADDRESS_MODE_LENGTH[_TYPE_])
+
+		#define OPCODE_NONE SCALAR_INVALID(uint16_t)
+
+		static const uint16_t ADDRESS_MODE_OPCODE[][ADDRESS_MODE_MAX + 1] = {
+			{ 0x6d, OPCODE_NONE, 0x7d, 0x79, OPCODE_NONE, OPCODE_NONE, 0x69, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x65, 0x61, 0x75, OPCODE_NONE, 0x72, 0x71, }, // adc
+			{ 0x2d, OPCODE_NONE, 0x3d, 0x39, OPCODE_NONE, OPCODE_NONE, 0x29, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x25, 0x21, 0x35, OPCODE_NONE, 0x32, 0x31, }, // and
+			{ 0x0e, OPCODE_NONE, 0x1e, OPCODE_NONE, OPCODE_NONE, 0x0a, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x06, OPCODE_NONE, 0x16, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // asl
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x0f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr0
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x1f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr1
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x2f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr2
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x3f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr3
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x4f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr4
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x5f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr5
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x6f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr6
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x7f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbr7
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x8f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs0
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x9f, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs1
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xaf, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs2
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xbf, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs3
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xcf, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs4
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xdf, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs5
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xef, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs6
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xff, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bbs7
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x90, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bcc
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xb0, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bcs
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xf0, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // beq
+			{ 0x2c, OPCODE_NONE, 0x3c, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x89, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x24, OPCODE_NONE, 0x34, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bit
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x30, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bmi
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0xd0, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bne
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x10, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bpl
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x80, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bra
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x00, 0x00, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // brk
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x50, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bvc
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				0x70, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // bvs
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x18,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // clc
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xd8,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // cld
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x58,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // cli
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xb8,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // clv
+			{ 0xcd, OPCODE_NONE, 0xdd, 0xd9, OPCODE_NONE, OPCODE_NONE, 0xc9, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xc5, 0xc1, 0xd5, OPCODE_NONE, 0xd2, 0xd1, }, // cmp
+			{ 0xec, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xe0, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xe4, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // cpx
+			{ 0xcc, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xc0, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xc4, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // cpy
+			{ 0xce, OPCODE_NONE, 0xde, OPCODE_NONE, OPCODE_NONE, 0x3a, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xc6, OPCODE_NONE, 0xd6, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // dec
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xca,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // dex
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x88,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // dey
+			{ 0x4d, OPCODE_NONE, 0x5d, 0x59, OPCODE_NONE, OPCODE_NONE, 0x49, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x45, 0x41, 0x55, OPCODE_NONE, 0x52, 0x51, }, // eor
+			{ 0xee, OPCODE_NONE, 0xfe, OPCODE_NONE, OPCODE_NONE, 0x1a, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xe6, OPCODE_NONE, 0xf6, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // inc
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xe8,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // inx
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xc8,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // iny
+			{ 0x4c, 0x7c, OPCODE_NONE, OPCODE_NONE, 0x6c, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // jmp
+			{ 0x20, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // jsr
+			{ 0xad, OPCODE_NONE, 0xbd, 0xb9, OPCODE_NONE, OPCODE_NONE, 0xa9, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xa5, 0xa1, 0xb5, OPCODE_NONE, 0xb2, 0xb1, }, // lda
+			{ 0xae, OPCODE_NONE, OPCODE_NONE, 0xbe, OPCODE_NONE, OPCODE_NONE, 0xa2, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xa6, OPCODE_NONE, OPCODE_NONE, 0xb6, OPCODE_NONE, OPCODE_NONE, }, // ldx
+			{ 0xac, OPCODE_NONE, 0xbc, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xa0, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xa4, OPCODE_NONE, 0xb4, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // ldy
+			{ 0x4e, OPCODE_NONE, 0x5e, OPCODE_NONE, OPCODE_NONE, 0x4a, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x46, OPCODE_NONE, 0x56, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // lsr
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xea,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // nop
+			{ 0x0d, OPCODE_NONE, 0x1d, 0x19, OPCODE_NONE, OPCODE_NONE, 0x09, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x05, 0x01, 0x15, OPCODE_NONE, 0x12, 0x11, }, // ora
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x48, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // pha
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x08, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // php
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0xda, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // phx
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x5a, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // phy
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x68, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // pla
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x28, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // plp
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0xfa, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // plx
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x7a, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // ply
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x07, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb0
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x17, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb1
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x27, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb2
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x37, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb3
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x47, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb4
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x57, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb5
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x67, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb6
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x77, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rmb7
+			{ 0x2e, OPCODE_NONE, 0x3e, OPCODE_NONE, OPCODE_NONE, 0x2a, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x26, OPCODE_NONE, 0x36, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rol
+			{ 0x6e, OPCODE_NONE, 0x7e, OPCODE_NONE, OPCODE_NONE, 0x6a, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x66, OPCODE_NONE, 0x76, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // ror
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x40, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rti
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, 0x60, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // rts
+			{ 0xed, OPCODE_NONE, 0xfd, 0xf9, OPCODE_NONE, OPCODE_NONE, 0xe9, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xe5, 0xe1, 0xf5, OPCODE_NONE, 0xf2, 0xf1, }, // sbc
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x38,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // sec
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xf8,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // sed
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x78,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // sei
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x87, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb0
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x97, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb1
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xa7, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb2
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xb7, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb3
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xc7, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb4
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xd7, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb5
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xe7, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb6
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0xf7, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // smb7
+			{ 0x8d, OPCODE_NONE, 0x9d, 0x99, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x85, 0x81, 0x95, OPCODE_NONE, 0x92, 0x91, }, // sta
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xdb,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // stp
+			{ 0x8e, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x86, OPCODE_NONE, OPCODE_NONE, 0x96, OPCODE_NONE, OPCODE_NONE, }, // stx
+			{ 0x8c, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x84, OPCODE_NONE, 0x94, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // sty
+			{ 0x9c, OPCODE_NONE, 0x9e, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x64, OPCODE_NONE, 0x74, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // stz
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xaa,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // tax
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xa8,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // tay
+			{ 0x1c, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x14, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // trb
+			{ 0x0c, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE,
+				OPCODE_NONE, OPCODE_NONE, 0x04, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // tsb
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xba,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // tsx
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x8a,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // txa
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x9a,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // txs
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0x98,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // tya
+			{ OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, 0xcb,
+				OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, OPCODE_NONE, }, // wai
+			};
+
+		#define ADDRESS_MODE_OPCODE_VALUE(_TYPE_, _MODE_) \
+			(((_TYPE_) > KEYWORD_COMMAND_MAX) || ((_MODE_) > ADDRESS_MODE_MAX) ? OPCODE_NONE \
+				: ADDRESS_MODE_OPCODE[_TYPE_][_MODE_])
+
+		enum {
+			PEEPHOLE_FLAG_CARRY = 0x01,
+			PEEPHOLE_FLAG_ZERO = 0x02,
+			PEEPHOLE_FLAG_DECIMAL = 0x08,
+			PEEPHOLE_FLAG_OVERFLOW = 0x40,
+			PEEPHOLE_FLAG_NEGATIVE = 0x80,
+		};
+
+		#define PEEPHOLE_FLAG_ALL (PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_ZERO | PEEPHOLE_FLAG_DECIMAL \
+			| PEEPHOLE_FLAG_OVERFLOW | PEEPHOLE_FLAG_NEGATIVE)
+		#define PEEPHOLE_FLAG_ARITHMETIC (PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_ZERO | PEEPHOLE_FLAG_OVERFLOW \
+			| PEEPHOLE_FLAG_NEGATIVE)
+		#define PEEPHOLE_FLAG_RESULT (PEEPHOLE_FLAG_ZERO | PEEPHOLE_FLAG_NEGATIVE)
+		#define PEEPHOLE_FLAG_SHIFT (PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_RESULT)
+
+		static const std::map<uint32_t, std::pair<uint8_t, uint8_t>> PEEPHOLE_FLAG = {
+			{ KEYWORD_COMMAND_ADC, { PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_DECIMAL, PEEPHOLE_FLAG_ARITHMETIC, }, },
+			{ KEYWORD_COMMAND_AND, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_ASL, { 0, PEEPHOLE_FLAG_SHIFT, }, },
+			{ KEYWORD_COMMAND_BIT, { 0, PEEPHOLE_FLAG_ZERO, }, }, { KEYWORD_COMMAND_CLC, { 0, PEEPHOLE_FLAG_CARRY, }, },
+			{ KEYWORD_COMMAND_CLD, { 0, PEEPHOLE_FLAG_DECIMAL, }, }, { KEYWORD_COMMAND_CLI, { 0, 0, }, },
+			{ KEYWORD_COMMAND_CLV, { 0, PEEPHOLE_FLAG_OVERFLOW, }, }, { KEYWORD_COMMAND_CMP, { 0, PEEPHOLE_FLAG_SHIFT, }, },
+			{ KEYWORD_COMMAND_CPX, { 0, PEEPHOLE_FLAG_SHIFT, }, }, { KEYWORD_COMMAND_CPY, { 0, PEEPHOLE_FLAG_SHIFT, }, },
+			{ KEYWORD_COMMAND_DEC, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_DEX, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_DEY, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_EOR, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_INC, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_INX, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_INY, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_LDA, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_LDX, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_LDY, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_LSR, { 0, PEEPHOLE_FLAG_SHIFT, }, }, { KEYWORD_COMMAND_NOP, { 0, 0, }, },
+			{ KEYWORD_COMMAND_ORA, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_PHA, { 0, 0, }, },
+			{ KEYWORD_COMMAND_PHP, { PEEPHOLE_FLAG_ALL, 0, }, }, { KEYWORD_COMMAND_PHX, { 0, 0, }, },
+			{ KEYWORD_COMMAND_PHY, { 0, 0, }, }, { KEYWORD_COMMAND_PLA, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_PLP, { 0, PEEPHOLE_FLAG_ALL, }, }, { KEYWORD_COMMAND_PLX, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_PLY, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_RMB0, { 0, 0, }, },
+			{ KEYWORD_COMMAND_RMB1, { 0, 0, }, }, { KEYWORD_COMMAND_RMB2, { 0, 0, }, },
+			{ KEYWORD_COMMAND_RMB3, { 0, 0, }, }, { KEYWORD_COMMAND_RMB4, { 0, 0, }, },
+			{ KEYWORD_COMMAND_RMB5, { 0, 0, }, }, { KEYWORD_COMMAND_RMB6, { 0, 0, }, },
+			{ KEYWORD_COMMAND_RMB7, { 0, 0, }, }, { KEYWORD_COMMAND_ROL, { PEEPHOLE_FLAG_CARRY, PEEPHOLE_FLAG_SHIFT, }, },
+			{ KEYWORD_COMMAND_ROR, { PEEPHOLE_FLAG_CARRY, PEEPHOLE_FLAG_SHIFT, }, }, { KEYWORD_COMMAND_RTI, { 0, PEEPHOLE_FLAG_ALL, }, },
+			{ KEYWORD_COMMAND_SBC, { PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_DECIMAL, PEEPHOLE_FLAG_ARITHMETIC, }, },
+			{ KEYWORD_COMMAND_SEC, { 0, PEEPHOLE_FLAG_CARRY, }, }, { KEYWORD_COMMAND_SED, { 0, PEEPHOLE_FLAG_DECIMAL, }, },
+			{ KEYWORD_COMMAND_SEI, { 0, 0, }, }, { KEYWORD_COMMAND_SMB0, { 0, 0, }, },
+			{ KEYWORD_COMMAND_SMB1, { 0, 0, }, }, { KEYWORD_COMMAND_SMB2, { 0, 0, }, },
+			{ KEYWORD_COMMAND_SMB3, { 0, 0, }, }, { KEYWORD_COMMAND_SMB4, { 0, 0, }, },
+			{ KEYWORD_COMMAND_SMB5, { 0, 0, }, }, { KEYWORD_COMMAND_SMB6, { 0, 0, }, },
+			{ KEYWORD_COMMAND_SMB7, { 0, 0, }, }, { KEYWORD_COMMAND_STA, { 0, 0, }, },
+			{ KEYWORD_COMMAND_STX, { 0, 0, }, }, { KEYWORD_COMMAND_STY, { 0, 0, }, },
+			{ KEYWORD_COMMAND_STZ, { 0, 0, }, }, { KEYWORD_COMMAND_TAX, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_TAY, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_TRB, { 0, PEEPHOLE_FLAG_ZERO, }, },
+			{ KEYWORD_COMMAND_TSB, { 0, PEEPHOLE_FLAG_ZERO, }, }, { KEYWORD_COMMAND_TSX, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			{ KEYWORD_COMMAND_TXA, { 0, PEEPHOLE_FLAG_RESULT, }, }, { KEYWORD_COMMAND_TXS, { 0, 0, }, },
+			{ KEYWORD_COMMAND_TYA, { 0, PEEPHOLE_FLAG_RESULT, }, },
+			};
+
+		#define PEEPHOLE_FLAG_CONTAINS(_TYPE_) \
+			(PEEPHOLE_FLAG.find(_TYPE_) != PEEPHOLE_FLAG.end())
+		#define PEEPHOLE_FLAG_READ(_TYPE_) \
+			(PEEPHOLE_FLAG.find(_TYPE_)->second.first)
+		#define PEEPHOLE_FLAG_WRITE(_TYPE_) \
+			(PEEPHOLE_FLAG.find(_TYPE_)->second.second)
+
+		enum {
+			PEEPHOLE_OPERAND_ANY = 0,
+			PEEPHOLE_OPERAND_ONE,
+			PEEPHOLE_OPERAND_SAME,
+		};
+
+		enum {
+			PEEPHOLE_PATTERN_CLC_ADC = 0,
+			PEEPHOLE_PATTERN_JSR_RTS,
+			PEEPHOLE_PATTERN_SEC_SBC,
+			PEEPHOLE_PATTERN_STA_LDA,
+		};
+
+		#define PEEPHOLE_PATTERN_MAX PEEPHOLE_PATTERN_STA_LDA
+
+		static const std::string PEEPHOLE_PATTERN_STR[] = {
+			"clc/adc #1 -> inc a", "jsr/rts -> jmp", "sec/sbc #1 -> dec a", "sta/lda -> sta",
+			};
+
+		#define PEEPHOLE_PATTERN_STRING(_TYPE_) \
+			((_TYPE_) > PEEPHOLE_PATTERN_MAX ? STRING_UNKNOWN : STRING_CHECK(PEEPHOLE_PATTERN_STR[_TYPE_]))
+
+		enum {
+			PEEPHOLE_METADATA_FIRST_COMMAND = 0,
+			PEEPHOLE_METADATA_FIRST_MODE,
+			PEEPHOLE_METADATA_FIRST_REPLACE_COMMAND,
+			PEEPHOLE_METADATA_FIRST_REPLACE_MODE,
+			PEEPHOLE_METADATA_FLAG,
+			PEEPHOLE_METADATA_OPERAND,
+			PEEPHOLE_METADATA_SECOND_COMMAND,
+			PEEPHOLE_METADATA_SECOND_MODE,
+			PEEPHOLE_METADATA_SECOND_REPLACE_COMMAND,
+			PEEPHOLE_METADATA_SECOND_REPLACE_MODE,
+		};
+
+		#define PEEPHOLE_METADATA_MAX PEEPHOLE_METADATA_SECOND_REPLACE_MODE
+
+		#define PEEPHOLE_DROP SCALAR_INVALID(uint32_t)
+		#define PEEPHOLE_KEEP (SCALAR_INVALID(uint32_t) - 1)
+		#define PEEPHOLE_MODE_ANY SCALAR_INVALID(uint32_t)
+
+		static const uint32_t PEEPHOLE_PATTERN[][PEEPHOLE_METADATA_MAX + 1] = {
+			{ KEYWORD_COMMAND_CLC, ADDRESS_MODE_IMPLIED, PEEPHOLE_DROP, PEEPHOLE_MODE_ANY, 
+				PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_DECIMAL | PEEPHOLE_FLAG_OVERFLOW, PEEPHOLE_OPERAND_ONE, 
+				KEYWORD_COMMAND_ADC, ADDRESS_MODE_IMMEDIATE, KEYWORD_COMMAND_INC, ADDRESS_MODE_ACCUMULATOR, }, // clc/adc #1
+			{ KEYWORD_COMMAND_JSR, ADDRESS_MODE_ABSOLUTE, KEYWORD_COMMAND_JMP, ADDRESS_MODE_ABSOLUTE, 
+				0, PEEPHOLE_OPERAND_ANY, 
+				KEYWORD_COMMAND_RTS, ADDRESS_MODE_STACK, PEEPHOLE_DROP, PEEPHOLE_MODE_ANY, }, // jsr/rts
+			{ KEYWORD_COMMAND_SEC, ADDRESS_MODE_IMPLIED, PEEPHOLE_DROP, PEEPHOLE_MODE_ANY, 
+				PEEPHOLE_FLAG_CARRY | PEEPHOLE_FLAG_DECIMAL | PEEPHOLE_FLAG_OVERFLOW, PEEPHOLE_OPERAND_ONE, 
+				KEYWORD_COMMAND_SBC, ADDRESS_MODE_IMMEDIATE, KEYWORD_COMMAND_DEC, ADDRESS_MODE_ACCUMULATOR, }, // sec/sbc #1
+			{ KEYWORD_COMMAND_STA, PEEPHOLE_MODE_ANY, PEEPHOLE_KEEP, PEEPHOLE_MODE_ANY, 
+				PEEPHOLE_FLAG_RESULT, PEEPHOLE_OPERAND_SAME, 
+				KEYWORD_COMMAND_LDA, PEEPHOLE_MODE_ANY, PEEPHOLE_DROP, PEEPHOLE_MODE_ANY, }, // sta/lda
+			};
+
 		enum {
 			KEYWORD_CONDITION_ELSE = 0,
 			KEYWORD_CONDITION_ELSE_IF,
@@ -364,7 +724,9 @@ namespace cc65c {
 			(KEYWORD_INCLUDE_SET.find(_VAL_) != KEYWORD_INCLUDE_SET.end())
 
 		enum {
-			KEYWORD_MACRO_BYTE = 0,
+			KEYWORD_MACRO_BEGIN = 0,
+			KEYWORD_MACRO_BYTE,
+			KEYWORD_MACRO_END,
 			KEYWORD_MACRO_HIGH,
 			KEYWORD_MACRO_LOW,
 			KEYWORD_MACRO_WORD,
@@ -373,7 +735,7 @@ namespace cc65c {
 		#define KEYWORD_MACRO_MAX KEYWORD_MACRO_WORD
 
 		static const std::string KEYWORD_MACRO_STR[] = {
-			"byte", "high", "low", "word",
+			"macro", "byte", "endm", "high", "low", "word",
 			};
 
 		#define KEYWORD_MACRO_STRING(_TYPE_) \
@@ -0,0 +1,499 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_GENERATOR_H_
+#define CC65C_ASSEMBLER_GENERATOR_H_
+
+#include <set>
+#include "object.h"
+#include "parser.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define SEGMENT_DEFAULT "default"
+
+		enum {
+			FIXUP_METADATA_ADDRESS = 0,
+			FIXUP_METADATA_BLOCK,
+			FIXUP_METADATA_COLUMN,
+			FIXUP_METADATA_INDEX,
+			FIXUP_METADATA_NODE,
+			FIXUP_METADATA_OFFSET,
+			FIXUP_METADATA_PATH,
+			FIXUP_METADATA_PENDING,
+			FIXUP_METADATA_PROGRAM,
+			FIXUP_METADATA_ROW,
+			FIXUP_METADATA_SEGMENT,
+			FIXUP_METADATA_TREE,
+			FIXUP_METADATA_TYPE,
+		};
+
+		typedef std::tuple<uint16_t, size_t, cc65c::core::stream_t, size_t, cc65c::core::uuid_t, size_t, std::string, 
+			size_t, size_t, cc65c::core::stream_t, std::string, size_t, cc65c::assembler::fixup_t> fixup_metadata_t;
+
+		enum {
+			LABEL_METADATA_BLOCK = 0,
+			LABEL_METADATA_INDEX,
+			LABEL_METADATA_OFFSET,
+			LABEL_METADATA_SEGMENT,
+		};
+
+		typedef std::tuple<size_t, size_t, size_t, std::string> label_metadata_t;
+
+		enum {
+			LISTING_METADATA_BLOCK = 0,
+			LISTING_METADATA_COLUMN,
+			LISTING_METADATA_LABEL,
+			LISTING_METADATA_LENGTH,
+			LISTING_METADATA_OFFSET,
+			LISTING_METADATA_PATH,
+			LISTING_METADATA_ROW,
+			LISTING_METADATA_SEGMENT,
+		};
+
+		typedef std::tuple<size_t, cc65c::core::stream_t, std::string, size_t, size_t, std::string, cc65c::core::stream_t, 
+			std::string> listing_metadata_t;
+
+		enum {
+			PEEPHOLE_COMMAND_BOUNDARY = 0,
+			PEEPHOLE_COMMAND_MODE,
+			PEEPHOLE_COMMAND_ORDINAL,
+			PEEPHOLE_COMMAND_RESOLVED,
+			PEEPHOLE_COMMAND_TYPE,
+			PEEPHOLE_COMMAND_VALUE,
+		};
+
+		typedef std::tuple<bool, uint32_t, size_t, bool, uint32_t, int32_t> peephole_command_t;
+
+		enum {
+			PEEPHOLE_REPORT_BYTE = 0,
+			PEEPHOLE_REPORT_COUNT,
+			PEEPHOLE_REPORT_CYCLE,
+		};
+
+		typedef std::tuple<size_t, size_t, size_t> peephole_report_t;
+
+		enum {
+			PEEPHOLE_REWRITE_COMMAND = 0,
+			PEEPHOLE_REWRITE_MODE,
+			PEEPHOLE_REWRITE_PATTERN,
+			PEEPHOLE_REWRITE_SITE,
+		};
+
+		typedef std::tuple<uint32_t, uint32_t, uint32_t, bool> peephole_rewrite_t;
+
+		enum {
+			RELAX_BRANCH_ADDRESS = 0,
+			RELAX_BRANCH_BLOCK,
+			RELAX_BRANCH_COMMAND,
+			RELAX_BRANCH_FIXUP,
+			RELAX_BRANCH_GROWTH,
+			RELAX_BRANCH_LENGTH,
+			RELAX_BRANCH_OFFSET,
+			RELAX_BRANCH_RESOLVED,
+			RELAX_BRANCH_SEGMENT,
+			RELAX_BRANCH_TARGET,
+			RELAX_BRANCH_TYPE,
+		};
+
+		typedef std::tuple<uint16_t, size_t, size_t, size_t, size_t, size_t, size_t, bool, std::string, int32_t, 
+			uint32_t> relax_branch_t;
+
+		enum {
+			SHORTEN_CANDIDATE_ADDRESS = 0,
+			SHORTEN_CANDIDATE_BLOCK,
+			SHORTEN_CANDIDATE_COMMAND,
+			SHORTEN_CANDIDATE_FIXUP,
+			SHORTEN_CANDIDATE_LABEL,
+			SHORTEN_CANDIDATE_OFFSET,
+			SHORTEN_CANDIDATE_OPCODE,
+			SHORTEN_CANDIDATE_RESOLVED,
+			SHORTEN_CANDIDATE_SEGMENT,
+			SHORTEN_CANDIDATE_VALUE,
+		};
+
+		typedef std::tuple<uint16_t, size_t, size_t, size_t, bool, size_t, uint8_t, bool, std::string, 
+			int32_t> shorten_candidate_t;
+
+		class generator :
+				protected cc65c::assembler::parser {
+
+			public:
+
+				generator(void);
+
+				generator(
+					__in const std::string &input,
+					__in_opt bool is_file = true
+					);
+
+				generator(
+					__in const generator &other
+					);
+
+				virtual ~generator(void);
+
+				generator &operator=(
+					__in const generator &other
+					);
+
+				static std::string as_string(
+					__in const generator &reference,
+					__in_opt bool verbose = false
+					);
+
+				virtual void clear(void);
+
+				void define(
+					__in const std::string &name,
+					__in int32_t value
+					);
+
+				std::set<std::string>::const_iterator dependency_begin(void);
+
+				std::set<std::string>::const_iterator dependency_end(void);
+
+				virtual size_t enumerate(void);
+
+				cc65c::assembler::object enumerate_object(void);
+
+				bool has_label(
+					__in const std::string &name
+					);
+
+				uint16_t label(
+					__in const std::string &name
+					);
+
+				std::vector<cc65c::assembler::listing_metadata_t>::const_iterator listing_begin(void);
+
+				std::vector<cc65c::assembler::listing_metadata_t>::const_iterator listing_end(void);
+
+				const std::string &listing_line(
+					__in const std::string &path,
+					__in cc65c::core::stream_t row
+					);
+
+				size_t passes(void);
+
+				std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator peephole_begin(void);
+
+				std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator peephole_end(void);
+
+				size_t relaxed(void);
+
+				const std::vector<cc65c::assembler::block_t> &segment(
+					__in const std::string &name
+					);
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator segment_begin(void);
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator segment_end(void);
+
+				virtual void set(
+					__in const std::string &input,
+					__in_opt bool is_file = true
+					);
+
+				void set_peephole(
+					__in bool enabled
+					);
+
+				void set_relax(
+					__in bool enabled
+					);
+
+				size_t shortened(void);
+
+				size_t size(void);
+
+				size_t symbol_count(void);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				size_t tree_count(void);
+
+			protected:
+
+				uint16_t address(void);
+
+				std::string as_exception_source(
+					__in const std::string &path,
+					__in cc65c::core::stream_t row,
+					__in cc65c::core::stream_t column
+					);
+
+				cc65c::assembler::block_t &block(void);
+
+				bool contains_symbol(
+					__in const std::string &name
+					);
+
+				void define_symbol(
+					__in const std::string &name,
+					__in cc65c::assembler::table_symbol_t type,
+					__in int32_t value
+					);
+
+				void emit(
+					__in uint8_t value
+					);
+
+				void emit(
+					__in const uint8_t *data,
+					__in size_t length
+					);
+
+				void emit_branch(
+					__in int32_t value,
+					__in const std::vector<size_t> &unresolved,
+					__inout cc65c::assembler::tree &tree,
+					__in size_t index,
+					__in uint16_t address,
+					__in size_t command,
+					__in uint32_t type
+					);
+
+				void emit_value(
+					__in int32_t value,
+					__in cc65c::assembler::fixup_t type,
+					__in const std::vector<size_t> &unresolved,
+					__inout cc65c::assembler::tree &tree,
+					__in size_t index,
+					__in uint16_t address
+					);
+
+				void enumerate_command(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				uint32_t enumerate_command_mode(
+					__in size_t command,
+					__in uint32_t type,
+					__in int32_t value,
+					__in const std::vector<size_t> &unresolved,
+					__in bool tracked,
+					__in uint32_t mode_zero_page,
+					__in uint32_t mode_absolute
+					);
+
+				void enumerate_command_relax(
+					__inout cc65c::assembler::tree &tree,
+					__in uint32_t type,
+					__in int32_t value,
+					__in const std::vector<size_t> &unresolved,
+					__in int32_t target,
+					__in const std::vector<size_t> &unresolved_target,
+					__in size_t index_target,
+					__in uint16_t address
+					);
+
+				void enumerate_condition(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				void enumerate_define(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				int32_t enumerate_expression(
+					__inout cc65c::assembler::tree &tree,
+					__inout size_t &index,
+					__in uint16_t origin,
+					__in uint16_t address,
+					__inout std::vector<size_t> &unresolved
+					);
+
+				int32_t enumerate_expression_evaluate(
+					__in size_t program,
+					__in uint16_t origin,
+					__in uint16_t address,
+					__inout std::vector<size_t> &unresolved
+					);
+
+				bool enumerate_expression_position(
+					__in size_t program
+					);
+
+				int32_t enumerate_expression_resolved(
+					__inout cc65c::assembler::tree &tree,
+					__inout size_t &index
+					);
+
+				bool enumerate_expression_tracked(
+					__inout cc65c::assembler::tree &tree,
+					__in size_t index,
+					__in const std::vector<size_t> &unresolved
+					);
+
+				void enumerate_include(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				void enumerate_include_binary(
+					__inout cc65c::assembler::tree &tree,
+					__in const std::string &path
+					);
+
+				void enumerate_include_hex(
+					__inout cc65c::assembler::tree &tree,
+					__in const std::string &path
+					);
+
+				static size_t enumerate_include_hex_vector(
+					__in const uint8_t *input,
+					__in size_t length,
+					__inout uint8_t *output,
+					__inout size_t &invalid
+					);
+
+				size_t enumerate_input(
+					__in bool relocatable
+					);
+
+				void enumerate_label(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				bool enumerate_peephole(void);
+
+				bool enumerate_peephole_dead(
+					__in size_t index,
+					__in uint8_t flags
+					);
+
+				bool enumerate_relax(void);
+
+				bool enumerate_relayout(void);
+
+				bool enumerate_relayout_shift(
+					__in const std::string &segment,
+					__in size_t block,
+					__in size_t offset,
+					__in int32_t delta
+					);
+
+				bool enumerate_relocation(
+					__in size_t index,
+					__inout std::string &symbol,
+					__inout int32_t &addend
+					);
+
+				bool enumerate_shorten(
+					__in bool frozen
+					);
+
+				void enumerate_statement(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				size_t enumerate_statement_list(
+					__inout cc65c::assembler::tree &tree,
+					__in size_t index,
+					__in bool active
+					);
+
+				uint16_t origin(void);
+
+				void patch(
+					__in size_t index
+					);
+
+				void reset_generator(void);
+
+				void write(
+					__in const std::string &segment,
+					__in size_t block,
+					__in size_t offset,
+					__in int32_t value,
+					__in cc65c::assembler::fixup_t type,
+					__in const std::string &path,
+					__in cc65c::core::stream_t row,
+					__in cc65c::core::stream_t column
+					);
+
+				size_t m_command;
+
+				std::map<std::string, int32_t> m_define;
+
+				std::set<std::string> m_dependency;
+
+				std::vector<cc65c::assembler::expression_program_t> m_expression;
+
+				std::map<std::pair<cc65c::core::uuid_t, size_t>, size_t> m_expression_index;
+
+				std::vector<cc65c::assembler::fixup_metadata_t> m_fixup;
+
+				std::vector<cc65c::assembler::tree> m_fixup_tree;
+
+				std::recursive_mutex m_generator_mutex;
+
+				std::vector<std::string> m_include;
+
+				std::vector<cc65c::assembler::label_metadata_t> m_label;
+
+				std::vector<cc65c::assembler::listing_metadata_t> m_listing;
+
+				std::map<std::string, cc65c::assembler::stream> m_listing_source;
+
+				size_t m_pass;
+
+				std::map<size_t, cc65c::assembler::peephole_rewrite_t> m_peephole;
+
+				bool m_peephole_boundary;
+
+				std::vector<cc65c::assembler::peephole_command_t> m_peephole_command;
+
+				bool m_peephole_enabled;
+
+				std::map<uint32_t, cc65c::assembler::peephole_report_t> m_peephole_report;
+
+				std::set<size_t> m_relax;
+
+				std::vector<cc65c::assembler::relax_branch_t> m_relax_branch;
+
+				bool m_relax_enabled;
+
+				std::map<size_t, size_t> m_relax_fixup;
+
+				bool m_relayout_safe;
+
+				bool m_relocatable;
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>> m_segment;
+
+				std::string m_segment_current;
+
+				std::set<size_t> m_shorten;
+
+				std::vector<cc65c::assembler::shorten_candidate_t> m_shorten_candidate;
+
+				std::map<size_t, size_t> m_shorten_fixup;
+
+				std::set<size_t> m_shorten_pinned;
+
+				cc65c::assembler::table m_table;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_GENERATOR_H_
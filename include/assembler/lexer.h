@@ -171,6 +171,19 @@ namespace cc65c {
 
 				void skip_comment(void);
 
+				void skip_condition(
+					__in_opt bool end = false
+					);
+
+				void skip_condition_next(
+					__in_opt bool end = false
+					);
+
+				void skip_condition_stream(
+					__inout size_t &depth,
+					__in bool end
+					);
+
 				void skip_whitespace(void);
 
 				std::recursive_mutex m_lexer_mutex;
@@ -178,6 +191,8 @@ namespace cc65c {
 				std::vector<cc65c::assembler::token> m_token;
 
 				size_t m_token_position;
+
+				bool m_token_template;
 		};
 	}
 }
@@ -0,0 +1,159 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_LINKER_H_
+#define CC65C_ASSEMBLER_LINKER_H_
+
+#include "object.h"
+#include "../core/thread.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		enum {
+			LINKER_RELOCATION_BLOCK = 0,
+			LINKER_RELOCATION_COLUMN,
+			LINKER_RELOCATION_OFFSET,
+			LINKER_RELOCATION_PATH,
+			LINKER_RELOCATION_ROW,
+			LINKER_RELOCATION_TYPE,
+			LINKER_RELOCATION_VALUE,
+		};
+
+		typedef std::tuple<size_t, cc65c::core::stream_t, size_t, std::string, cc65c::core::stream_t, 
+			cc65c::assembler::fixup_t, int32_t> linker_relocation_t;
+
+		class linker_worker :
+				protected cc65c::core::thread {
+
+			public:
+
+				linker_worker(
+					__inout std::vector<cc65c::assembler::block_t> &segment,
+					__in const std::vector<cc65c::assembler::linker_relocation_t> &relocation
+					);
+
+				virtual ~linker_worker(void);
+
+				void start(void);
+
+				void stop(void);
+
+			protected:
+
+				linker_worker(
+					__in const linker_worker &other
+					) = delete;
+
+				linker_worker &operator=(
+					__in const linker_worker &other
+					) = delete;
+
+				void apply(void);
+
+				void on_activate(void);
+
+				void on_deactivate(void);
+
+				void on_loop(void);
+
+				const std::vector<cc65c::assembler::linker_relocation_t> &m_relocation;
+
+				std::vector<cc65c::assembler::block_t> &m_segment;
+
+				cc65c::core::signal m_signal_complete;
+		};
+
+		class linker {
+
+			public:
+
+				linker(void);
+
+				linker(
+					__in const linker &other
+					);
+
+				virtual ~linker(void);
+
+				linker &operator=(
+					__in const linker &other
+					);
+
+				void add(
+					__in const cc65c::assembler::object &input
+					);
+
+				void add(
+					__in const std::string &input
+					);
+
+				static std::string as_string(
+					__in const linker &reference,
+					__in_opt bool verbose = false
+					);
+
+				void clear(void);
+
+				bool has_symbol(
+					__in const std::string &name
+					);
+
+				size_t link(void);
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator segment_begin(void);
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator segment_end(void);
+
+				size_t size(void);
+
+				int32_t symbol(
+					__in const std::string &name
+					);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+			protected:
+
+				void link_overlap(void);
+
+				void link_relocation(
+					__in const std::map<std::string, std::vector<cc65c::assembler::linker_relocation_t>> &relocation
+					);
+
+				void link_segment(
+					__inout std::map<std::string, std::vector<cc65c::assembler::linker_relocation_t>> &relocation
+					);
+
+				void link_symbol(void);
+
+				std::recursive_mutex m_linker_mutex;
+
+				std::vector<cc65c::assembler::object> m_object;
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>> m_segment;
+
+				cc65c::assembler::table m_table;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_LINKER_H_
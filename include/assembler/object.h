@@ -0,0 +1,159 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_OBJECT_H_
+#define CC65C_ASSEMBLER_OBJECT_H_
+
+#include <map>
+#include <mutex>
+#include "table.h"
+#include "../core/stream.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define OBJECT_MAGIC 0x4f353643
+		#define OBJECT_VERSION 1
+
+		typedef enum {
+			FIXUP_ABSOLUTE_BYTE = 0,
+			FIXUP_ABSOLUTE_WORD,
+			FIXUP_RELATIVE,
+		} fixup_t;
+
+		#define FIXUP_MAX FIXUP_RELATIVE
+
+		typedef std::pair<uint16_t, std::vector<uint8_t>> block_t;
+
+		enum {
+			OBJECT_RELOCATION_ADDEND = 0,
+			OBJECT_RELOCATION_BLOCK,
+			OBJECT_RELOCATION_COLUMN,
+			OBJECT_RELOCATION_OFFSET,
+			OBJECT_RELOCATION_ROW,
+			OBJECT_RELOCATION_SEGMENT,
+			OBJECT_RELOCATION_SYMBOL,
+			OBJECT_RELOCATION_TYPE,
+		};
+
+		typedef std::tuple<int32_t, size_t, cc65c::core::stream_t, size_t, cc65c::core::stream_t, std::string, size_t, 
+			cc65c::assembler::fixup_t> object_relocation_t;
+
+		enum {
+			OBJECT_SYMBOL_NAME = 0,
+			OBJECT_SYMBOL_TYPE,
+			OBJECT_SYMBOL_VALUE,
+		};
+
+		typedef std::tuple<std::string, cc65c::assembler::table_symbol_t, int32_t> object_symbol_t;
+
+		class object {
+
+			public:
+
+				object(void);
+
+				object(
+					__in const std::string &input
+					);
+
+				object(
+					__in const std::string &source,
+					__in const std::map<std::string, std::vector<cc65c::assembler::block_t>> &segment,
+					__in const std::vector<cc65c::assembler::object_symbol_t> &symbol,
+					__in const std::vector<cc65c::assembler::object_relocation_t> &relocation
+					);
+
+				object(
+					__in const object &other
+					);
+
+				virtual ~object(void);
+
+				object &operator=(
+					__in const object &other
+					);
+
+				static std::string as_string(
+					__in const object &reference,
+					__in_opt bool verbose = false
+					);
+
+				void clear(void);
+
+				void read(
+					__in const std::string &input
+					);
+
+				std::vector<cc65c::assembler::object_relocation_t> &relocation(void);
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>> &segment(void);
+
+				std::string source(void);
+
+				std::vector<cc65c::assembler::object_symbol_t> &symbol(void);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void write(
+					__in const std::string &output
+					);
+
+			protected:
+
+				static std::string read_string(
+					__in const uint8_t *data,
+					__in size_t length,
+					__inout size_t &offset
+					);
+
+				static uint32_t read_value(
+					__in const uint8_t *data,
+					__in size_t length,
+					__inout size_t &offset,
+					__in size_t width
+					);
+
+				static void write_string(
+					__inout std::vector<uint8_t> &data,
+					__in const std::string &value
+					);
+
+				static void write_value(
+					__inout std::vector<uint8_t> &data,
+					__in uint32_t value,
+					__in size_t width
+					);
+
+				std::recursive_mutex m_object_mutex;
+
+				std::vector<cc65c::assembler::object_relocation_t> m_relocation;
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>> m_segment;
+
+				std::string m_source;
+
+				std::vector<cc65c::assembler::object_symbol_t> m_symbol;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_OBJECT_H_
@@ -19,6 +19,8 @@
 #ifndef CC65C_ASSEMBLER_PARSER_H_
 #define CC65C_ASSEMBLER_PARSER_H_
 
+#include <functional>
+#include <set>
 #include "lexer.h"
 #include "tree.h"
 
@@ -26,6 +28,84 @@ namespace cc65c {
 
 	namespace assembler {
 
+		typedef enum {
+			CONDITION_FALSE = 0,
+			CONDITION_TRUE,
+			CONDITION_UNKNOWN,
+		} condition_t;
+
+		enum {
+			CONDITION_SYMBOL_DEFINED = 0,
+			CONDITION_SYMBOL_RESOLVED,
+			CONDITION_SYMBOL_VALUE,
+		};
+
+		typedef std::tuple<cc65c::assembler::condition_t, bool, int32_t> condition_symbol_t;
+
+		enum {
+			EXPRESSION_INSTRUCTION_COLUMN = 0,
+			EXPRESSION_INSTRUCTION_OPERAND,
+			EXPRESSION_INSTRUCTION_OPERATION,
+			EXPRESSION_INSTRUCTION_ROW,
+		};
+
+		typedef std::tuple<cc65c::core::stream_t, int32_t, uint32_t, cc65c::core::stream_t> expression_instruction_t;
+
+		typedef enum {
+			EXPRESSION_OPERATION_ADDITION = 0,
+			EXPRESSION_OPERATION_AND,
+			EXPRESSION_OPERATION_AND_LOGICAL,
+			EXPRESSION_OPERATION_BASE,
+			EXPRESSION_OPERATION_DIVISION,
+			EXPRESSION_OPERATION_EQUAL,
+			EXPRESSION_OPERATION_GREATER_THAN,
+			EXPRESSION_OPERATION_GREATER_THAN_EQUAL,
+			EXPRESSION_OPERATION_HIGH,
+			EXPRESSION_OPERATION_IDENTIFIER,
+			EXPRESSION_OPERATION_LESS_THAN,
+			EXPRESSION_OPERATION_LESS_THAN_EQUAL,
+			EXPRESSION_OPERATION_LITERAL,
+			EXPRESSION_OPERATION_LOW,
+			EXPRESSION_OPERATION_MODULUS,
+			EXPRESSION_OPERATION_MULTIPLICATION,
+			EXPRESSION_OPERATION_NOT_BINARY,
+			EXPRESSION_OPERATION_NOT_EQUAL,
+			EXPRESSION_OPERATION_NOT_LOGICAL,
+			EXPRESSION_OPERATION_OR,
+			EXPRESSION_OPERATION_OR_LOGICAL,
+			EXPRESSION_OPERATION_POSITION,
+			EXPRESSION_OPERATION_SCALAR,
+			EXPRESSION_OPERATION_SUBTRACTION,
+			EXPRESSION_OPERATION_WORD,
+			EXPRESSION_OPERATION_XOR,
+		} expression_operation_t;
+
+		#define EXPRESSION_OPERATION_MAX EXPRESSION_OPERATION_XOR
+
+		#define EXPRESSION_FAULT_NONE SCALAR_INVALID(size_t)
+
+		typedef std::function<int32_t(const std::string &)> expression_intern_t;
+
+		typedef std::function<bool(cc65c::assembler::expression_operation_t, int32_t, int32_t &)> expression_lookup_t;
+
+		enum {
+			EXPRESSION_PROGRAM_DEPTH = 0,
+			EXPRESSION_PROGRAM_END,
+			EXPRESSION_PROGRAM_INSTRUCTION,
+			EXPRESSION_PROGRAM_KEY,
+		};
+
+		typedef std::tuple<size_t, size_t, std::vector<cc65c::assembler::expression_instruction_t>, 
+			std::vector<std::string>> expression_program_t;
+
+		enum {
+			MACRO_METADATA_PARAMETER = 0,
+			MACRO_METADATA_PATH,
+			MACRO_METADATA_TEMPLATE,
+		};
+
+		typedef std::tuple<std::vector<std::string>, std::string, std::vector<cc65c::assembler::token>> macro_metadata_t;
+
 		class parser :
 				protected cc65c::assembler::lexer {
 
@@ -66,6 +146,12 @@ namespace cc65c {
 
 				bool has_previous(void);
 
+				size_t macro_expansion_hit(void);
+
+				size_t macro_expansion_miss(void);
+
+				std::set<std::string> macro_include(void);
+
 				bool match(
 					__in cc65c::assembler::tree_t type
 					);
@@ -89,6 +175,10 @@ namespace cc65c {
 					__in_opt bool is_file = true
 					);
 
+				void set_condition(
+					__in const std::map<std::string, int32_t> &define
+					);
+
 				size_t size(void);
 
 				virtual std::string to_string(
@@ -113,6 +203,33 @@ namespace cc65c {
 					__in cc65c::assembler::tree &tree
 					);
 
+				bool compile_expression(
+					__inout cc65c::assembler::tree &tree,
+					__inout size_t &index,
+					__in const cc65c::assembler::expression_intern_t &intern,
+					__inout cc65c::assembler::expression_program_t &program
+					);
+
+				bool compile_expression_factor(
+					__inout cc65c::assembler::tree &tree,
+					__in const cc65c::assembler::expression_intern_t &intern,
+					__inout cc65c::assembler::expression_program_t &program
+					);
+
+				void compile_expression_instruction(
+					__inout cc65c::assembler::expression_program_t &program,
+					__in cc65c::assembler::expression_operation_t operation,
+					__inout cc65c::assembler::token &tok,
+					__in_opt int32_t operand = 0
+					);
+
+				bool compile_expression_term(
+					__inout cc65c::assembler::tree &tree,
+					__inout size_t &index,
+					__in const cc65c::assembler::expression_intern_t &intern,
+					__inout cc65c::assembler::expression_program_t &program
+					);
+
 				void enumerate_tree(void);
 
 				void enumerate_tree_command(
@@ -158,6 +275,12 @@ namespace cc65c {
 					__inout cc65c::assembler::tree &tree
 					);
 
+				void enumerate_tree_condition_branch(
+					__inout cc65c::assembler::tree &tree,
+					__in cc65c::assembler::condition_t condition,
+					__inout bool &unknown
+					);
+
 				void enumerate_tree_condition_expression(
 					__inout cc65c::assembler::tree &tree
 					);
@@ -218,6 +341,10 @@ namespace cc65c {
 					__inout cc65c::assembler::tree &tree
 					);
 
+				void enumerate_tree_include_macro(
+					__in const std::string &path
+					);
+
 				void enumerate_tree_label(
 					__inout cc65c::assembler::tree &tree
 					);
@@ -226,6 +353,12 @@ namespace cc65c {
 					__inout cc65c::assembler::tree &tree
 					);
 
+				void enumerate_tree_macro_define(void);
+
+				void enumerate_tree_macro_user(
+					__inout std::vector<cc65c::assembler::tree> &statement
+					);
+
 				void enumerate_tree_statement(
 					__inout cc65c::assembler::tree &tree
 					);
@@ -234,6 +367,58 @@ namespace cc65c {
 					__inout cc65c::assembler::tree &tree
 					);
 
+				cc65c::assembler::condition_t evaluate_condition(
+					__inout cc65c::assembler::tree &tree
+					);
+
+				cc65c::assembler::condition_t evaluate_condition_define(
+					__in const std::string &name
+					);
+
+				bool evaluate_expression(
+					__inout cc65c::assembler::tree &tree,
+					__inout size_t &index,
+					__inout int32_t &result
+					);
+
+				bool evaluate_expression(
+					__in const cc65c::assembler::expression_program_t &program,
+					__in const cc65c::assembler::expression_lookup_t &lookup,
+					__inout int32_t &result,
+					__inout size_t &fault
+					);
+
+				void update_condition(
+					__in const std::string &name,
+					__in cc65c::assembler::condition_t defined,
+					__in_opt bool resolved = false,
+					__in_opt int32_t value = 0
+					);
+
+				bool m_condition_closed;
+
+				size_t m_condition_effect;
+
+				std::map<std::string, cc65c::assembler::condition_symbol_t> m_condition_symbol;
+
+				size_t m_condition_unknown;
+
+				std::vector<int32_t> m_expression_stack;
+
+				std::map<std::string, cc65c::assembler::macro_metadata_t> m_macro;
+
+				std::set<std::string> m_macro_active;
+
+				std::map<std::string, std::vector<cc65c::assembler::tree>> m_macro_expansion;
+
+				size_t m_macro_expansion_hit;
+
+				size_t m_macro_expansion_miss;
+
+				std::set<std::string> m_macro_include;
+
+				std::set<std::string> m_macro_include_parent;
+
 				std::recursive_mutex m_parser_mutex;
 
 				std::vector<cc65c::assembler::tree> m_tree;
@@ -91,6 +91,10 @@ namespace cc65c {
 
 				const std::string &line(void);
 
+				const std::string &line(
+					__in cc65c::core::stream_t row
+					);
+
 				bool match(
 					__in cc65c::assembler::character_t type
 					);
@@ -185,6 +185,14 @@ namespace cc65c {
 					__in cc65c::core::uuid_t id
 					);
 
+				void hold(
+					__in cc65c::core::uuid_t id
+					);
+
+				void release(
+					__in cc65c::core::uuid_t id
+					);
+
 				std::map<cc65c::core::uuid_t, std::pair<cc65c::assembler::node_metadata_t, size_t>> m_node;
 
 				std::mutex m_symbol_mutex;
@@ -0,0 +1,180 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_TABLE_H_
+#define CC65C_ASSEMBLER_TABLE_H_
+
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "../define.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define TABLE_CAPACITY_MIN 64
+		#define TABLE_INDEX_INVALID SCALAR_INVALID(size_t)
+
+		typedef enum {
+			TABLE_SYMBOL_UNDEFINED = 0,
+			TABLE_SYMBOL_DEFINE,
+			TABLE_SYMBOL_LABEL,
+		} table_symbol_t;
+
+		#define TABLE_SYMBOL_MAX TABLE_SYMBOL_LABEL
+
+		static const std::string TABLE_SYMBOL_STR[] = {
+			"UNDEFINED", "DEFINE", "LABEL",
+			};
+
+		#define TABLE_SYMBOL_STRING(_TYPE_) \
+			((_TYPE_) > TABLE_SYMBOL_MAX ? STRING_UNKNOWN : STRING_CHECK(TABLE_SYMBOL_STR[_TYPE_]))
+
+		enum {
+			TABLE_ENTRY_FIXUP = 0,
+			TABLE_ENTRY_NAME,
+			TABLE_ENTRY_TYPE,
+			TABLE_ENTRY_VALUE,
+		};
+
+		typedef std::tuple<size_t, std::string, cc65c::assembler::table_symbol_t, int32_t> table_entry_t;
+
+		enum {
+			TABLE_LINK_FIXUP = 0,
+			TABLE_LINK_NEXT,
+		};
+
+		typedef std::pair<size_t, size_t> table_link_t;
+
+		class table {
+
+			public:
+
+				table(
+					__in_opt size_t reserve = 0
+					);
+
+				table(
+					__in const table &other
+					);
+
+				virtual ~table(void);
+
+				table &operator=(
+					__in const table &other
+					);
+
+				static std::string as_string(
+					__in const table &reference,
+					__in_opt bool verbose = false
+					);
+
+				void clear(void);
+
+				bool contains(
+					__in const std::string &name
+					);
+
+				bool contains(
+					__in const std::string &name,
+					__in cc65c::assembler::table_symbol_t type
+					);
+
+				void define(
+					__in size_t index,
+					__in cc65c::assembler::table_symbol_t type,
+					__in int32_t value,
+					__inout std::vector<size_t> &resolved
+					);
+
+				size_t find(
+					__in const std::string &name
+					);
+
+				bool has_pending(
+					__inout size_t &index,
+					__inout size_t &fixup
+					);
+
+				size_t intern(
+					__in const std::string &name
+					);
+
+				std::string name(
+					__in size_t index
+					);
+
+				void reset(void);
+
+				size_t size(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				cc65c::assembler::table_symbol_t type(
+					__in size_t index
+					);
+
+				void undefine(
+					__in size_t index
+					);
+
+				int32_t value(
+					__in size_t index
+					);
+
+				void wait(
+					__in size_t index,
+					__in size_t fixup
+					);
+
+			protected:
+
+				static uint32_t as_hash(
+					__in const std::string &name
+					);
+
+				cc65c::assembler::table_entry_t &entry(
+					__in size_t index
+					);
+
+				size_t probe(
+					__in const std::string &name,
+					__in uint32_t hash
+					);
+
+				void rehash(
+					__in size_t capacity
+					);
+
+				std::vector<cc65c::assembler::table_entry_t> m_entry;
+
+				std::vector<cc65c::assembler::table_link_t> m_link;
+
+				size_t m_link_free;
+
+				std::vector<uint64_t> m_slot;
+
+				std::mutex m_table_mutex;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_TABLE_H_
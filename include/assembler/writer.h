@@ -0,0 +1,131 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_WRITER_H_
+#define CC65C_ASSEMBLER_WRITER_H_
+
+#include "generator.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define WRITER_BUFFER_SIZE 0x10000
+		#define WRITER_FILL_DEFAULT 0xff
+		#define WRITER_HEX_RECORD_LENGTH 0x10
+
+		typedef enum {
+			WRITER_HEX_DATA = 0,
+			WRITER_HEX_END,
+		} writer_hex_t;
+
+		class writer {
+
+			public:
+
+				writer(void);
+
+				writer(
+					__in const std::string &output
+					);
+
+				virtual ~writer(void);
+
+				static std::string as_string(
+					__in const writer &reference,
+					__in_opt bool verbose = false
+					);
+
+				void close(void);
+
+				void flush(void);
+
+				bool is_open(void);
+
+				void open(
+					__in const std::string &output
+					);
+
+				size_t size(void);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void write(
+					__in const uint8_t *data,
+					__in size_t length
+					);
+
+				void write(
+					__in const std::string &data
+					);
+
+				void write_binary(
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end,
+					__in_opt uint8_t fill = WRITER_FILL_DEFAULT
+					);
+
+				void write_hex(
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end
+					);
+
+				void write_listing(
+					__inout cc65c::assembler::generator &input
+					);
+
+			protected:
+
+				writer(
+					__in const writer &other
+					) = delete;
+
+				writer &operator=(
+					__in const writer &other
+					) = delete;
+
+				static std::vector<const cc65c::assembler::block_t *> as_image(
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end
+					);
+
+				void write_hex_record(
+					__in cc65c::assembler::writer_hex_t type,
+					__in uint16_t address,
+					__in const uint8_t *data,
+					__in size_t length
+					);
+
+				std::vector<uint8_t> m_buffer;
+
+				int m_file;
+
+				std::string m_path;
+
+				size_t m_position;
+
+				size_t m_size;
+
+				std::recursive_mutex m_writer_mutex;
+		};
+	}
+}
+
+#endif // CC65C_ASSEMBLER_WRITER_H_
@@ -0,0 +1,176 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_CORE_COUNTER_H_
+#define CC65C_CORE_COUNTER_H_
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "singleton.h"
+
+namespace cc65c {
+
+	namespace core {
+
+		typedef enum {
+			COUNTER_EVENT_BRANCH_MISS = 0,
+			COUNTER_EVENT_CACHE_MISS,
+			COUNTER_EVENT_CYCLE,
+			COUNTER_EVENT_INSTRUCTION,
+		} counter_event_t;
+
+		#define COUNTER_EVENT_MAX cc65c::core::COUNTER_EVENT_INSTRUCTION
+
+		static const std::string COUNTER_EVENT_STR[] = {
+			"branch-misses", "cache-misses", "cycles", "instructions",
+			};
+
+		#define COUNTER_EVENT_STRING(_TYPE_) \
+			((_TYPE_) > COUNTER_EVENT_MAX ? STRING_UNKNOWN : STRING_CHECK(cc65c::core::COUNTER_EVENT_STR[_TYPE_]))
+
+		typedef enum {
+			COUNTER_PHASE_EMIT = 0,
+			COUNTER_PHASE_LEX,
+			COUNTER_PHASE_PARSE,
+			COUNTER_PHASE_RESOLVE,
+			COUNTER_PHASE_STREAM,
+		} counter_phase_t;
+
+		#define COUNTER_PHASE_MAX cc65c::core::COUNTER_PHASE_STREAM
+		#define COUNTER_PHASE_NONE (COUNTER_PHASE_MAX + 1)
+
+		static const std::string COUNTER_PHASE_STR[] = {
+			"emit", "lex", "parse", "resolve", "stream",
+			};
+
+		#define COUNTER_PHASE_STRING(_TYPE_) \
+			((_TYPE_) > COUNTER_PHASE_MAX ? STRING_UNKNOWN : STRING_CHECK(cc65c::core::COUNTER_PHASE_STR[_TYPE_]))
+
+		enum {
+			COUNTER_METADATA_CPU = 0,
+			COUNTER_METADATA_ENTRY,
+			COUNTER_METADATA_EVENT,
+			COUNTER_METADATA_WALL,
+		};
+
+		typedef std::tuple<uint64_t, size_t, std::vector<uint64_t>, uint64_t> counter_metadata_t;
+
+		class counter :
+				public cc65c::core::singleton<cc65c::core::counter> {
+
+			public:
+
+				~counter(void);
+
+				bool available(void);
+
+				void enter(
+					__in cc65c::core::counter_phase_t phase
+					);
+
+				void exit(void);
+
+				void initialize(void);
+
+				cc65c::core::counter_metadata_t metadata(
+					__in cc65c::core::counter_phase_t phase
+					);
+
+				size_t phase(void);
+
+				void reset(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				friend class cc65c::core::singleton<cc65c::core::counter>;
+
+				counter(void);
+
+				counter(
+					__in const counter &other
+					) = delete;
+
+				counter &operator=(
+					__in const counter &other
+					) = delete;
+
+				static std::string as_string(
+					__in const counter &reference,
+					__in_opt bool verbose = false
+					);
+
+				void clear(void);
+
+				void close(void);
+
+				bool open(void);
+
+				void sample(void);
+
+				uint64_t m_counter_cpu;
+
+				std::atomic<size_t> m_counter_current;
+
+				std::atomic<bool> m_counter_enabled;
+
+				std::vector<int> m_counter_handle;
+
+				std::vector<cc65c::core::counter_metadata_t> m_counter_metadata;
+
+				std::mutex m_counter_mutex;
+
+				std::vector<cc65c::core::counter_phase_t> m_counter_phase;
+
+				std::vector<uint64_t> m_counter_sample;
+
+				std::thread::id m_counter_thread;
+
+				uint64_t m_counter_wall;
+		};
+
+		class counter_scope {
+
+			public:
+
+				counter_scope(
+					__in cc65c::core::counter_phase_t phase
+					);
+
+				~counter_scope(void);
+
+			protected:
+
+				counter_scope(
+					__in const counter_scope &other
+					) = delete;
+
+				counter_scope &operator=(
+					__in const counter_scope &other
+					) = delete;
+		};
+	}
+}
+
+#endif // CC65C_CORE_COUNTER_H_
@@ -0,0 +1,75 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_CORE_HASH_H_
+#define CC65C_CORE_HASH_H_
+
+#include "../define.h"
+
+namespace cc65c {
+
+	namespace core {
+
+		#define HASH_SEED_DEFAULT 0
+
+		class hash {
+
+			public:
+
+				static uint64_t generate(
+					__in const void *data,
+					__in size_t length,
+					__in_opt uint64_t seed = HASH_SEED_DEFAULT
+					);
+
+				static uint64_t generate(
+					__in const std::string &data,
+					__in_opt uint64_t seed = HASH_SEED_DEFAULT
+					);
+
+			protected:
+
+				hash(void) = delete;
+
+				hash(
+					__in const hash &other
+					) = delete;
+
+				hash &operator=(
+					__in const hash &other
+					) = delete;
+
+				static uint64_t merge(
+					__in uint64_t accumulator,
+					__in uint64_t value
+					);
+
+				static uint64_t read(
+					__in const uint8_t *data,
+					__in size_t width
+					);
+
+				static uint64_t round(
+					__in uint64_t accumulator,
+					__in uint64_t value
+					);
+		};
+	}
+}
+
+#endif // CC65C_CORE_HASH_H_
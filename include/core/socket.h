@@ -0,0 +1,111 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_CORE_SOCKET_H_
+#define CC65C_CORE_SOCKET_H_
+
+#include <mutex>
+#include "../define.h"
+
+namespace cc65c {
+
+	namespace core {
+
+		#define SOCKET_BACKLOG 0x40
+		#define SOCKET_FRAME_MAX 0x4000000
+		#define SOCKET_HANDLE_INVALID -1
+
+		class socket {
+
+			public:
+
+				socket(void);
+
+				virtual ~socket(void);
+
+				void accept(
+					__inout socket &client
+					);
+
+				static std::string as_string(
+					__in const socket &reference,
+					__in_opt bool verbose = false
+					);
+
+				void close(void);
+
+				void connect(
+					__in const std::string &path
+					);
+
+				bool is_open(void);
+
+				void listen(
+					__in const std::string &path
+					);
+
+				bool receive(
+					__inout std::string &data
+					);
+
+				void send(
+					__in const std::string &data
+					);
+
+				void set_timeout(
+					__in uint32_t timeout
+					);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+			protected:
+
+				socket(
+					__in const socket &other
+					) = delete;
+
+				socket &operator=(
+					__in const socket &other
+					) = delete;
+
+				void open(void);
+
+				bool read(
+					__inout void *data,
+					__in size_t length
+					);
+
+				void write(
+					__in const void *data,
+					__in size_t length
+					);
+
+				int m_handle;
+
+				bool m_listening;
+
+				std::string m_path;
+
+				std::recursive_mutex m_socket_mutex;
+		};
+	}
+}
+
+#endif // CC65C_CORE_SOCKET_H_
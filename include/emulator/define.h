@@ -0,0 +1,386 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_EMULATOR_DEFINE_H_
+#define CC65C_EMULATOR_DEFINE_H_
+
+#include <map>
+#include <set>
+#include "../define.h"
+#include "../assembler/define.h"
+
+namespace cc65c {
+
+	namespace emulator {
+
+		#define BLOCK_LENGTH_MAX 32
+
+		#define MEMORY_LENGTH 0x10000
+		#define MEMORY_PAGE_COUNT (MEMORY_LENGTH / MEMORY_PAGE_LENGTH)
+		#define MEMORY_PAGE_LENGTH 0x100
+		#define MEMORY_STACK 0x0100
+
+		enum {
+			OPCODE_METADATA_COMMAND = 0,
+			OPCODE_METADATA_CYCLE,
+			OPCODE_METADATA_LENGTH,
+			OPCODE_METADATA_MODE,
+		};
+
+		#define OPCODE_METADATA_MAX OPCODE_METADATA_MODE
+
+		static constexpr uint32_t OPCODE[][OPCODE_METADATA_MAX + 1] = {
+			{ cc65c::assembler::KEYWORD_COMMAND_BRK, 7, 2, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x00 brk
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0x01 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x02 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x03 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_TSB, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x04 tsb
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x05 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_ASL, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x06 asl
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB0, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x07 rmb0
+			{ cc65c::assembler::KEYWORD_COMMAND_PHP, 3, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x08 php
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x09 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_ASL, 2, 1, cc65c::assembler::ADDRESS_MODE_ACCUMULATOR, }, // 0x0a asl
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x0b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_TSB, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x0c tsb
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x0d ora
+			{ cc65c::assembler::KEYWORD_COMMAND_ASL, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x0e asl
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR0, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x0f bbr0
+			{ cc65c::assembler::KEYWORD_COMMAND_BPL, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x10 bpl
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0x11 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0x12 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x13 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_TRB, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x14 trb
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x15 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_ASL, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x16 asl
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB1, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x17 rmb1
+			{ cc65c::assembler::KEYWORD_COMMAND_CLC, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x18 clc
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0x19 ora
+			{ cc65c::assembler::KEYWORD_COMMAND_INC, 2, 1, cc65c::assembler::ADDRESS_MODE_ACCUMULATOR, }, // 0x1a inc
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x1b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_TRB, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x1c trb
+			{ cc65c::assembler::KEYWORD_COMMAND_ORA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x1d ora
+			{ cc65c::assembler::KEYWORD_COMMAND_ASL, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x1e asl
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR1, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x1f bbr1
+			{ cc65c::assembler::KEYWORD_COMMAND_JSR, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x20 jsr
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0x21 and
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x22 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x23 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_BIT, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x24 bit
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x25 and
+			{ cc65c::assembler::KEYWORD_COMMAND_ROL, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x26 rol
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB2, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x27 rmb2
+			{ cc65c::assembler::KEYWORD_COMMAND_PLP, 4, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x28 plp
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x29 and
+			{ cc65c::assembler::KEYWORD_COMMAND_ROL, 2, 1, cc65c::assembler::ADDRESS_MODE_ACCUMULATOR, }, // 0x2a rol
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x2b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_BIT, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x2c bit
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x2d and
+			{ cc65c::assembler::KEYWORD_COMMAND_ROL, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x2e rol
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR2, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x2f bbr2
+			{ cc65c::assembler::KEYWORD_COMMAND_BMI, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x30 bmi
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0x31 and
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0x32 and
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x33 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_BIT, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x34 bit
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x35 and
+			{ cc65c::assembler::KEYWORD_COMMAND_ROL, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x36 rol
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB3, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x37 rmb3
+			{ cc65c::assembler::KEYWORD_COMMAND_SEC, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x38 sec
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0x39 and
+			{ cc65c::assembler::KEYWORD_COMMAND_DEC, 2, 1, cc65c::assembler::ADDRESS_MODE_ACCUMULATOR, }, // 0x3a dec
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x3b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_BIT, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x3c bit
+			{ cc65c::assembler::KEYWORD_COMMAND_AND, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x3d and
+			{ cc65c::assembler::KEYWORD_COMMAND_ROL, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x3e rol
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR3, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x3f bbr3
+			{ cc65c::assembler::KEYWORD_COMMAND_RTI, 6, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x40 rti
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0x41 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x42 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x43 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x44 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x45 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_LSR, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x46 lsr
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB4, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x47 rmb4
+			{ cc65c::assembler::KEYWORD_COMMAND_PHA, 3, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x48 pha
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x49 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_LSR, 2, 1, cc65c::assembler::ADDRESS_MODE_ACCUMULATOR, }, // 0x4a lsr
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x4b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_JMP, 3, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x4c jmp
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x4d eor
+			{ cc65c::assembler::KEYWORD_COMMAND_LSR, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x4e lsr
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR4, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x4f bbr4
+			{ cc65c::assembler::KEYWORD_COMMAND_BVC, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x50 bvc
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0x51 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0x52 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x53 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x54 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x55 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_LSR, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x56 lsr
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB5, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x57 rmb5
+			{ cc65c::assembler::KEYWORD_COMMAND_CLI, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x58 cli
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0x59 eor
+			{ cc65c::assembler::KEYWORD_COMMAND_PHY, 3, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x5a phy
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x5b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 8, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x5c nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_EOR, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x5d eor
+			{ cc65c::assembler::KEYWORD_COMMAND_LSR, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x5e lsr
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR5, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x5f bbr5
+			{ cc65c::assembler::KEYWORD_COMMAND_RTS, 6, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x60 rts
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0x61 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x62 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x63 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_STZ, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x64 stz
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x65 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_ROR, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x66 ror
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB6, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x67 rmb6
+			{ cc65c::assembler::KEYWORD_COMMAND_PLA, 4, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x68 pla
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x69 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_ROR, 2, 1, cc65c::assembler::ADDRESS_MODE_ACCUMULATOR, }, // 0x6a ror
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x6b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_JMP, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDIRECT, }, // 0x6c jmp
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x6d adc
+			{ cc65c::assembler::KEYWORD_COMMAND_ROR, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x6e ror
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR6, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x6f bbr6
+			{ cc65c::assembler::KEYWORD_COMMAND_BVS, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x70 bvs
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0x71 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0x72 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x73 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_STZ, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x74 stz
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x75 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_ROR, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x76 ror
+			{ cc65c::assembler::KEYWORD_COMMAND_RMB7, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x77 rmb7
+			{ cc65c::assembler::KEYWORD_COMMAND_SEI, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x78 sei
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0x79 adc
+			{ cc65c::assembler::KEYWORD_COMMAND_PLY, 4, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0x7a ply
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x7b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_JMP, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_INDIRECT, }, // 0x7c jmp
+			{ cc65c::assembler::KEYWORD_COMMAND_ADC, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x7d adc
+			{ cc65c::assembler::KEYWORD_COMMAND_ROR, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x7e ror
+			{ cc65c::assembler::KEYWORD_COMMAND_BBR7, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x7f bbr7
+			{ cc65c::assembler::KEYWORD_COMMAND_BRA, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x80 bra
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0x81 sta
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x82 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x83 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_STY, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x84 sty
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x85 sta
+			{ cc65c::assembler::KEYWORD_COMMAND_STX, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x86 stx
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB0, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x87 smb0
+			{ cc65c::assembler::KEYWORD_COMMAND_DEY, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x88 dey
+			{ cc65c::assembler::KEYWORD_COMMAND_BIT, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0x89 bit
+			{ cc65c::assembler::KEYWORD_COMMAND_TXA, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x8a txa
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x8b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_STY, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x8c sty
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x8d sta
+			{ cc65c::assembler::KEYWORD_COMMAND_STX, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x8e stx
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS0, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x8f bbs0
+			{ cc65c::assembler::KEYWORD_COMMAND_BCC, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x90 bcc
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0x91 sta
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0x92 sta
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x93 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_STY, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x94 sty
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0x95 sta
+			{ cc65c::assembler::KEYWORD_COMMAND_STX, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_Y, }, // 0x96 stx
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB1, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0x97 smb1
+			{ cc65c::assembler::KEYWORD_COMMAND_TYA, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x98 tya
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 5, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0x99 sta
+			{ cc65c::assembler::KEYWORD_COMMAND_TXS, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x9a txs
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0x9b nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_STZ, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0x9c stz
+			{ cc65c::assembler::KEYWORD_COMMAND_STA, 5, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x9d sta
+			{ cc65c::assembler::KEYWORD_COMMAND_STZ, 5, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0x9e stz
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS1, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0x9f bbs1
+			{ cc65c::assembler::KEYWORD_COMMAND_LDY, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xa0 ldy
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0xa1 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_LDX, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xa2 ldx
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xa3 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_LDY, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xa4 ldy
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xa5 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_LDX, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xa6 ldx
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB2, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xa7 smb2
+			{ cc65c::assembler::KEYWORD_COMMAND_TAY, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xa8 tay
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xa9 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_TAX, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xaa tax
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xab nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_LDY, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xac ldy
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xad lda
+			{ cc65c::assembler::KEYWORD_COMMAND_LDX, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xae ldx
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS2, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xaf bbs2
+			{ cc65c::assembler::KEYWORD_COMMAND_BCS, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xb0 bcs
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0xb1 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0xb2 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xb3 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_LDY, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xb4 ldy
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xb5 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_LDX, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_Y, }, // 0xb6 ldx
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB3, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xb7 smb3
+			{ cc65c::assembler::KEYWORD_COMMAND_CLV, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xb8 clv
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0xb9 lda
+			{ cc65c::assembler::KEYWORD_COMMAND_TSX, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xba tsx
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xbb nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_LDY, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0xbc ldy
+			{ cc65c::assembler::KEYWORD_COMMAND_LDA, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0xbd lda
+			{ cc65c::assembler::KEYWORD_COMMAND_LDX, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0xbe ldx
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS3, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xbf bbs3
+			{ cc65c::assembler::KEYWORD_COMMAND_CPY, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xc0 cpy
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0xc1 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xc2 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xc3 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_CPY, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xc4 cpy
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xc5 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_DEC, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xc6 dec
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB4, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xc7 smb4
+			{ cc65c::assembler::KEYWORD_COMMAND_INY, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xc8 iny
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xc9 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_DEX, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xca dex
+			{ cc65c::assembler::KEYWORD_COMMAND_WAI, 3, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xcb wai
+			{ cc65c::assembler::KEYWORD_COMMAND_CPY, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xcc cpy
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xcd cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_DEC, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xce dec
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS4, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xcf bbs4
+			{ cc65c::assembler::KEYWORD_COMMAND_BNE, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xd0 bne
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0xd1 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0xd2 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xd3 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xd4 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xd5 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_DEC, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xd6 dec
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB5, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xd7 smb5
+			{ cc65c::assembler::KEYWORD_COMMAND_CLD, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xd8 cld
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0xd9 cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_PHX, 3, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0xda phx
+			{ cc65c::assembler::KEYWORD_COMMAND_STP, 3, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xdb stp
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xdc nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_CMP, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0xdd cmp
+			{ cc65c::assembler::KEYWORD_COMMAND_DEC, 7, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0xde dec
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS5, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xdf bbs5
+			{ cc65c::assembler::KEYWORD_COMMAND_CPX, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xe0 cpx
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT, }, // 0xe1 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xe2 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xe3 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_CPX, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xe4 cpx
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 3, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xe5 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_INC, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xe6 inc
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB6, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xe7 smb6
+			{ cc65c::assembler::KEYWORD_COMMAND_INX, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xe8 inx
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 2, 2, cc65c::assembler::ADDRESS_MODE_IMMEDIATE, }, // 0xe9 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xea nop
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xeb nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_CPX, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xec cpx
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xed sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_INC, 6, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xee inc
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS6, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xef bbs6
+			{ cc65c::assembler::KEYWORD_COMMAND_BEQ, 2, 2, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xf0 beq
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX, }, // 0xf1 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT, }, // 0xf2 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xf3 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xf4 nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 4, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xf5 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_INC, 6, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X, }, // 0xf6 inc
+			{ cc65c::assembler::KEYWORD_COMMAND_SMB7, 5, 2, cc65c::assembler::ADDRESS_MODE_ZERO_PAGE, }, // 0xf7 smb7
+			{ cc65c::assembler::KEYWORD_COMMAND_SED, 2, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xf8 sed
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y, }, // 0xf9 sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_PLX, 4, 1, cc65c::assembler::ADDRESS_MODE_STACK, }, // 0xfa plx
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 1, 1, cc65c::assembler::ADDRESS_MODE_IMPLIED, }, // 0xfb nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_NOP, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE, }, // 0xfc nop*
+			{ cc65c::assembler::KEYWORD_COMMAND_SBC, 4, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0xfd sbc
+			{ cc65c::assembler::KEYWORD_COMMAND_INC, 7, 3, cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X, }, // 0xfe inc
+			{ cc65c::assembler::KEYWORD_COMMAND_BBS7, 5, 3, cc65c::assembler::ADDRESS_MODE_RELATIVE, }, // 0xff bbs7
+			};
+
+		#define OPCODE_COMMAND(_OPCODE_) OPCODE[_OPCODE_][OPCODE_METADATA_COMMAND]
+		#define OPCODE_CYCLE(_OPCODE_) OPCODE[_OPCODE_][OPCODE_METADATA_CYCLE]
+		#define OPCODE_LENGTH(_OPCODE_) OPCODE[_OPCODE_][OPCODE_METADATA_LENGTH]
+		#define OPCODE_MODE(_OPCODE_) OPCODE[_OPCODE_][OPCODE_METADATA_MODE]
+
+		#define OPCODE_MAX UINT8_MAX
+
+		static const std::set<uint32_t> OPCODE_BLOCK_END_SET = {
+			cc65c::assembler::KEYWORD_COMMAND_BBR0, cc65c::assembler::KEYWORD_COMMAND_BBR1, cc65c::assembler::KEYWORD_COMMAND_BBR2, 
+			cc65c::assembler::KEYWORD_COMMAND_BBR3, cc65c::assembler::KEYWORD_COMMAND_BBR4, cc65c::assembler::KEYWORD_COMMAND_BBR5, 
+			cc65c::assembler::KEYWORD_COMMAND_BBR6, cc65c::assembler::KEYWORD_COMMAND_BBR7, cc65c::assembler::KEYWORD_COMMAND_BBS0, 
+			cc65c::assembler::KEYWORD_COMMAND_BBS1, cc65c::assembler::KEYWORD_COMMAND_BBS2, cc65c::assembler::KEYWORD_COMMAND_BBS3, 
+			cc65c::assembler::KEYWORD_COMMAND_BBS4, cc65c::assembler::KEYWORD_COMMAND_BBS5, cc65c::assembler::KEYWORD_COMMAND_BBS6, 
+			cc65c::assembler::KEYWORD_COMMAND_BBS7, cc65c::assembler::KEYWORD_COMMAND_BCC, cc65c::assembler::KEYWORD_COMMAND_BCS, 
+			cc65c::assembler::KEYWORD_COMMAND_BEQ, cc65c::assembler::KEYWORD_COMMAND_BMI, cc65c::assembler::KEYWORD_COMMAND_BNE, 
+			cc65c::assembler::KEYWORD_COMMAND_BPL, cc65c::assembler::KEYWORD_COMMAND_BRA, cc65c::assembler::KEYWORD_COMMAND_BRK, 
+			cc65c::assembler::KEYWORD_COMMAND_BVC, cc65c::assembler::KEYWORD_COMMAND_BVS, cc65c::assembler::KEYWORD_COMMAND_JMP, 
+			cc65c::assembler::KEYWORD_COMMAND_JSR, cc65c::assembler::KEYWORD_COMMAND_RTI, cc65c::assembler::KEYWORD_COMMAND_RTS, 
+			cc65c::assembler::KEYWORD_COMMAND_STP, cc65c::assembler::KEYWORD_COMMAND_WAI,
+			};
+
+		#define OPCODE_BLOCK_END_CONTAINS(_TYPE_) \
+			(OPCODE_BLOCK_END_SET.find(_TYPE_) != OPCODE_BLOCK_END_SET.end())
+
+		static const std::set<uint32_t> OPCODE_PAGE_PENALTY_SET = {
+			cc65c::assembler::KEYWORD_COMMAND_ADC, cc65c::assembler::KEYWORD_COMMAND_AND, cc65c::assembler::KEYWORD_COMMAND_ASL, 
+			cc65c::assembler::KEYWORD_COMMAND_BIT, cc65c::assembler::KEYWORD_COMMAND_CMP, cc65c::assembler::KEYWORD_COMMAND_EOR, 
+			cc65c::assembler::KEYWORD_COMMAND_LDA, cc65c::assembler::KEYWORD_COMMAND_LDX, cc65c::assembler::KEYWORD_COMMAND_LDY, 
+			cc65c::assembler::KEYWORD_COMMAND_LSR, cc65c::assembler::KEYWORD_COMMAND_ORA, cc65c::assembler::KEYWORD_COMMAND_ROL, 
+			cc65c::assembler::KEYWORD_COMMAND_ROR, cc65c::assembler::KEYWORD_COMMAND_SBC,
+			};
+
+		#define OPCODE_PAGE_PENALTY_CONTAINS(_TYPE_) \
+			(OPCODE_PAGE_PENALTY_SET.find(_TYPE_) != OPCODE_PAGE_PENALTY_SET.end())
+
+		enum {
+			PROCESSOR_FLAG_CARRY = 0x01,
+			PROCESSOR_FLAG_ZERO = 0x02,
+			PROCESSOR_FLAG_INTERRUPT_DISABLE = 0x04,
+			PROCESSOR_FLAG_DECIMAL = 0x08,
+			PROCESSOR_FLAG_BREAK = 0x10,
+			PROCESSOR_FLAG_UNUSED = 0x20,
+			PROCESSOR_FLAG_OVERFLOW = 0x40,
+			PROCESSOR_FLAG_NEGATIVE = 0x80,
+		};
+
+		static const std::string PROCESSOR_FLAG_STR = "czidbuvn";
+
+		enum {
+			PROCESSOR_INTERRUPT_MASKABLE = 0x01,
+			PROCESSOR_INTERRUPT_NON_MASKABLE = 0x02,
+		};
+
+		#define PROCESSOR_INTERRUPT_CYCLE 7
+		#define PROCESSOR_RESET_CYCLE 7
+		#define PROCESSOR_STACK_POINTER_RESET 0xfd
+
+		typedef enum {
+			PROCESSOR_STATE_RUNNING = 0,
+			PROCESSOR_STATE_STOPPED,
+			PROCESSOR_STATE_WAITING,
+		} processor_state_t;
+
+		#define PROCESSOR_STATE_MAX PROCESSOR_STATE_WAITING
+
+		static const std::string PROCESSOR_STATE_STR[] = {
+			"RUNNING", "STOPPED", "WAITING",
+			};
+
+		#define PROCESSOR_STATE_STRING(_TYPE_) \
+			((_TYPE_) > PROCESSOR_STATE_MAX ? STRING_UNKNOWN : STRING_CHECK(PROCESSOR_STATE_STR[_TYPE_]))
+
+		enum {
+			VECTOR_NON_MASKABLE = 0xfffa,
+			VECTOR_RESET = 0xfffc,
+			VECTOR_MASKABLE = 0xfffe,
+		};
+	}
+}
+
+#endif // CC65C_EMULATOR_DEFINE_H_
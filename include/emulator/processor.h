@@ -0,0 +1,294 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_EMULATOR_PROCESSOR_H_
+#define CC65C_EMULATOR_PROCESSOR_H_
+
+#include <bitset>
+#include <mutex>
+#include "define.h"
+#include "../assembler/object.h"
+
+namespace cc65c {
+
+	namespace emulator {
+
+		class processor;
+
+		typedef void (processor::*execute_t)(
+			__in uint16_t operand
+			);
+
+		enum {
+			INSTRUCTION_HANDLER = 0,
+			INSTRUCTION_LENGTH,
+			INSTRUCTION_OPERAND,
+		};
+
+		typedef std::tuple<cc65c::emulator::execute_t, uint8_t, uint16_t> instruction_t;
+
+		enum {
+			PROFILE_CYCLE = 0,
+			PROFILE_INSTRUCTION,
+		};
+
+		typedef std::pair<uint64_t, uint64_t> profile_t;
+
+		class processor {
+
+			public:
+
+				processor(void);
+
+				processor(
+					__in const processor &other
+					);
+
+				virtual ~processor(void);
+
+				processor &operator=(
+					__in const processor &other
+					);
+
+				uint8_t &accumulator(void);
+
+				static std::string as_string(
+					__in const processor &reference,
+					__in_opt bool verbose = false
+					);
+
+				bool block_cache(void);
+
+				virtual void clear(void);
+
+				uint64_t cycles(void);
+
+				uint8_t &index_x(void);
+
+				uint8_t &index_y(void);
+
+				uint64_t instructions(void);
+
+				void interrupt(
+					__in_opt bool maskable = true
+					);
+
+				void load(
+					__in uint16_t address,
+					__in const std::vector<uint8_t> &data
+					);
+
+				void load(
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+					__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end
+					);
+
+				const std::vector<cc65c::emulator::profile_t> &profile(void);
+
+				bool profiling(void);
+
+				uint16_t &program_counter(void);
+
+				uint8_t read(
+					__in uint16_t address
+					);
+
+				void reset(void);
+
+				uint64_t run(
+					__in uint64_t cycles
+					);
+
+				void set_block_cache(
+					__in bool enabled
+					);
+
+				void set_profiling(
+					__in bool enabled
+					);
+
+				uint8_t &stack_pointer(void);
+
+				cc65c::emulator::processor_state_t state(void);
+
+				uint8_t &status(void);
+
+				uint32_t step(void);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void write(
+					__in uint16_t address,
+					__in uint8_t value
+					);
+
+			protected:
+
+				void add(
+					__in uint8_t value
+					);
+
+				void branch(
+					__in bool taken,
+					__in uint8_t offset
+					);
+
+				void compare(
+					__in uint8_t left,
+					__in uint8_t right
+					);
+
+				void compile(
+					__in uint16_t address
+					);
+
+				template <bool _PROFILE_> uint32_t dispatch(void);
+
+				template <bool _PROFILE_> void dispatch_block(
+					__in uint64_t end
+					);
+
+				template <uint8_t _OPCODE_> void execute(
+					__in uint16_t operand
+					);
+
+				void flag(
+					__in uint8_t mask,
+					__in bool value
+					);
+
+				void flush(void);
+
+				void invalidate(
+					__in uint16_t address,
+					__in size_t length
+					);
+
+				uint8_t pull(void);
+
+				uint16_t pull_word(void);
+
+				void push(
+					__in uint8_t value
+					);
+
+				void push_word(
+					__in uint16_t value
+					);
+
+				uint8_t read_memory(
+					__in uint16_t address
+					);
+
+				uint16_t read_word(
+					__in uint16_t address
+					);
+
+				uint16_t read_word_zero_page(
+					__in uint8_t address
+					);
+
+				void reference(
+					__in uint16_t page,
+					__in uint16_t entry
+					);
+
+				uint8_t result(
+					__in uint8_t value
+					);
+
+				uint8_t rotate_left(
+					__in uint8_t value
+					);
+
+				uint8_t rotate_right(
+					__in uint8_t value
+					);
+
+				void service(void);
+
+				uint8_t shift_left(
+					__in uint8_t value
+					);
+
+				uint8_t shift_right(
+					__in uint8_t value
+					);
+
+				void subtract(
+					__in uint8_t value
+					);
+
+				void vector(
+					__in uint16_t address,
+					__in bool software
+					);
+
+				void write_memory(
+					__in uint16_t address,
+					__in uint8_t value
+					);
+
+				static const cc65c::emulator::execute_t EXECUTE[];
+
+				uint8_t m_accumulator;
+
+				std::vector<std::vector<cc65c::emulator::instruction_t>> m_block;
+
+				std::bitset<MEMORY_PAGE_COUNT> m_block_cached;
+
+				bool m_block_enabled;
+
+				std::vector<std::vector<uint16_t>> m_block_page;
+
+				uint64_t m_cycle;
+
+				std::bitset<MEMORY_PAGE_COUNT> m_dirty;
+
+				bool m_dirty_pending;
+
+				uint8_t m_index_x;
+
+				uint8_t m_index_y;
+
+				uint64_t m_instruction;
+
+				uint8_t m_interrupt;
+
+				uint8_t m_memory[MEMORY_LENGTH];
+
+				std::recursive_mutex m_processor_mutex;
+
+				std::vector<cc65c::emulator::profile_t> m_profile;
+
+				bool m_profile_enabled;
+
+				uint16_t m_program_counter;
+
+				uint8_t m_stack_pointer;
+
+				cc65c::emulator::processor_state_t m_state;
+
+				uint8_t m_status;
+		};
+	}
+}
+
+#endif // CC65C_EMULATOR_PROCESSOR_H_
@@ -0,0 +1,128 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_EMULATOR_PROFILER_H_
+#define CC65C_EMULATOR_PROFILER_H_
+
+#include "processor.h"
+#include "../assembler/generator.h"
+
+namespace cc65c {
+
+	namespace emulator {
+
+		#define PROFILER_LABEL_ANONYMOUS "<anonymous>"
+
+		enum {
+			PROFILER_LABEL_ADDRESS = 0,
+			PROFILER_LABEL_COLUMN,
+			PROFILER_LABEL_CYCLE,
+			PROFILER_LABEL_INSTRUCTION,
+			PROFILER_LABEL_NAME,
+			PROFILER_LABEL_PATH,
+			PROFILER_LABEL_ROW,
+		};
+
+		typedef std::tuple<uint16_t, cc65c::core::stream_t, uint64_t, uint64_t, std::string, std::string, 
+			cc65c::core::stream_t> profiler_label_t;
+
+		enum {
+			PROFILER_LINE_ADDRESS = 0,
+			PROFILER_LINE_COLUMN,
+			PROFILER_LINE_CYCLE,
+			PROFILER_LINE_INSTRUCTION,
+			PROFILER_LINE_LENGTH,
+			PROFILER_LINE_PATH,
+			PROFILER_LINE_ROW,
+			PROFILER_LINE_TEXT,
+		};
+
+		typedef std::tuple<uint16_t, cc65c::core::stream_t, uint64_t, uint64_t, size_t, std::string, 
+			cc65c::core::stream_t, std::string> profiler_line_t;
+
+		class profiler {
+
+			public:
+
+				profiler(void);
+
+				profiler(
+					__in const profiler &other
+					);
+
+				virtual ~profiler(void);
+
+				profiler &operator=(
+					__in const profiler &other
+					);
+
+				static std::string as_string(
+					__in const profiler &reference,
+					__in_opt bool verbose = false
+					);
+
+				virtual void clear(void);
+
+				void collect(
+					__inout cc65c::assembler::generator &input,
+					__inout cc65c::emulator::processor &source
+					);
+
+				uint64_t cycles(void);
+
+				std::string hotspot(
+					__in_opt size_t count = 0
+					);
+
+				uint64_t instructions(void);
+
+				std::vector<cc65c::emulator::profiler_label_t>::const_iterator label_begin(void);
+
+				std::vector<cc65c::emulator::profiler_label_t>::const_iterator label_end(void);
+
+				std::vector<cc65c::emulator::profiler_line_t>::const_iterator line_begin(void);
+
+				std::vector<cc65c::emulator::profiler_line_t>::const_iterator line_end(void);
+
+				std::string listing(void);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+			protected:
+
+				static double percent(
+					__in uint64_t value,
+					__in uint64_t total
+					);
+
+				uint64_t m_cycle;
+
+				uint64_t m_instruction;
+
+				std::vector<cc65c::emulator::profiler_label_t> m_label;
+
+				std::vector<cc65c::emulator::profiler_line_t> m_line;
+
+				std::recursive_mutex m_profiler_mutex;
+		};
+	}
+}
+
+#endif // CC65C_EMULATOR_PROFILER_H_
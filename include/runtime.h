@@ -19,6 +19,8 @@
 #ifndef CC65C_RUNTIME_H_
 #define CC65C_RUNTIME_H_
 
+#include "assembler/artifact.h"
+#include "assembler/cache.h"
 #include "assembler/symbol.h"
 #include "core/exception.h"
 #include "core/singleton.h"
@@ -61,6 +63,10 @@ namespace cc65c {
 
 			void teardown(void);
 
+			cc65c::assembler::artifact &m_artifact;
+
+			cc65c::assembler::cache &m_cache;
+
 			cc65c::assembler::symbol &m_symbol;
 
 			cc65c::core::trace &m_trace;
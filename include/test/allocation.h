@@ -0,0 +1,178 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_TEST_ALLOCATION_H_
+#define CC65C_TEST_ALLOCATION_H_
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <tuple>
+#include "../core/counter.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define ALLOCATION_PHASE_MAX COUNTER_PHASE_NONE
+		#define ALLOCATION_PHASE_ALL (ALLOCATION_PHASE_MAX + 1)
+
+		enum {
+			ALLOCATION_METADATA_BYTES = 0,
+			ALLOCATION_METADATA_COUNT,
+			ALLOCATION_METADATA_RELEASE,
+		};
+
+		typedef std::tuple<uint64_t, uint64_t, uint64_t> allocation_metadata_t;
+
+		class allocation {
+
+			public:
+
+				static void allocate(
+					__in size_t size
+					);
+
+				static void deallocate(void);
+
+				static bool installed(void);
+
+				static cc65c::test::allocation_metadata_t metadata(
+					__in_opt size_t phase = ALLOCATION_PHASE_ALL
+					);
+
+				static void start(void);
+
+				static void stop(void);
+
+			protected:
+
+				allocation(void) = delete;
+
+				allocation(
+					__in const allocation &other
+					) = delete;
+
+				allocation &operator=(
+					__in const allocation &other
+					) = delete;
+
+				static std::atomic<bool> m_active;
+
+				static std::atomic<uint64_t> m_bytes[ALLOCATION_PHASE_MAX + 1];
+
+				static std::atomic<uint64_t> m_count[ALLOCATION_PHASE_MAX + 1];
+
+				static std::atomic<bool> m_installed;
+
+				static std::atomic<uint64_t> m_release[ALLOCATION_PHASE_MAX + 1];
+
+				static std::thread::id m_thread;
+		};
+	}
+}
+
+#ifdef CC65C_TEST_ALLOCATION_HARNESS
+
+void * 
+operator new(
+	__in std::size_t size
+	)
+{
+	void *result;
+
+	cc65c::test::allocation::allocate(size);
+
+	result = std::malloc(size ? size : 1);
+	if(!result) {
+		throw std::bad_alloc();
+	}
+
+	return result;
+}
+
+void * 
+operator new(
+	__in std::size_t size,
+	__in const std::nothrow_t &tag
+	) noexcept
+{
+	cc65c::test::allocation::allocate(size);
+
+	return std::malloc(size ? size : 1);
+}
+
+void * 
+operator new[](
+	__in std::size_t size
+	)
+{
+	return operator new(size);
+}
+
+void * 
+operator new[](
+	__in std::size_t size,
+	__in const std::nothrow_t &tag
+	) noexcept
+{
+	return operator new(size, tag);
+}
+
+void 
+operator delete(
+	__in void *pointer
+	) noexcept
+{
+
+	if(pointer) {
+		cc65c::test::allocation::deallocate();
+		std::free(pointer);
+	}
+}
+
+void 
+operator delete(
+	__in void *pointer,
+	__in const std::nothrow_t &tag
+	) noexcept
+{
+	operator delete(pointer);
+}
+
+void 
+operator delete[](
+	__in void *pointer
+	) noexcept
+{
+	operator delete(pointer);
+}
+
+void 
+operator delete[](
+	__in void *pointer,
+	__in const std::nothrow_t &tag
+	) noexcept
+{
+	operator delete(pointer);
+}
+
+#endif // CC65C_TEST_ALLOCATION_HARNESS
+
+#endif // CC65C_TEST_ALLOCATION_H_
@@ -20,7 +20,7 @@
 #define CC65C_TEST_FIXTURE_H_
 
 #include <mutex>
-#include "../define.h"
+#include "allocation.h"
 
 namespace cc65c {
 
@@ -34,12 +34,23 @@ namespace cc65c {
 
 		#define STATUS_MAX STATUS_SUCCESS
 
+		enum {
+			FIXTURE_DURATION_SETUP = 0,
+			FIXTURE_DURATION_TEARDOWN,
+			FIXTURE_DURATION_TEST,
+		};
+
+		typedef std::tuple<double, double, double> fixture_duration_t;
+
+		#define FIXTURE_DURATION_UNLIMITED 0.0
+
 		class fixture {
 
 			public:
 
 				fixture(
-					__in const std::string &name
+					__in const std::string &name,
+					__in_opt double duration_max = FIXTURE_DURATION_UNLIMITED
 					);
 
 				fixture(
@@ -52,6 +63,14 @@ namespace cc65c {
 					__in const fixture &other
 					);
 
+				void allocation_begin(void);
+
+				cc65c::test::status_t allocation_end(
+					__in size_t units,
+					__in double budget,
+					__in_opt size_t phase = ALLOCATION_PHASE_ALL
+					);
+
 				static std::string as_name(
 					__in const fixture &reference
 					);
@@ -61,6 +80,10 @@ namespace cc65c {
 					__in_opt bool verbose = false
 					);
 
+				cc65c::test::fixture_duration_t duration(void);
+
+				double duration_max(void);
+
 				const std::string &name(void);
 
 				virtual cc65c::test::status_t on_setup(void) = 0;
@@ -73,6 +96,10 @@ namespace cc65c {
 
 				cc65c::test::status_t run(void);
 
+				void set_duration_max(
+					__in double duration_max
+					);
+
 				cc65c::test::status_t status(void);
 
 				virtual std::string to_string(
@@ -81,6 +108,10 @@ namespace cc65c {
 
 			protected:
 
+				cc65c::test::fixture_duration_t m_duration;
+
+				double m_duration_max;
+
 				std::mutex m_mutex;
 
 				std::string m_name;
@@ -19,9 +19,13 @@
 #ifndef CC65C_TEST_SUITE_H_
 #define CC65C_TEST_SUITE_H_
 
+#include <atomic>
+#include <exception>
 #include <map>
 #include "fixture.h"
 
+#define SUITE_JOBS_DEFAULT 1
+
 namespace cc65c {
 
 	namespace test {
@@ -63,6 +67,10 @@ namespace cc65c {
 					__in const std::string &name
 					);
 
+				void duration(
+					__inout std::map<std::string, cc65c::test::fixture_duration_t> &output
+					);
+
 				const std::string &name(void);
 
 				void remove(void);
@@ -78,7 +86,8 @@ namespace cc65c {
 					);
 
 				cc65c::test::status_t run(
-					__inout std::map<std::string, cc65c::test::status_t> &output
+					__inout std::map<std::string, cc65c::test::status_t> &output,
+					__in_opt size_t jobs = SUITE_JOBS_DEFAULT
 					);
 
 				cc65c::test::status_t run(
@@ -107,6 +116,14 @@ namespace cc65c {
 					__in const std::string &name
 					);
 
+				static void run_worker(
+					__in const std::vector<std::reference_wrapper<cc65c::test::fixture>> &entry,
+					__inout std::atomic<size_t> &next,
+					__inout std::vector<cc65c::test::status_t> &status,
+					__inout std::vector<std::exception_ptr> &error,
+					__inout std::atomic<bool> &abort
+					);
+
 				std::map<std::string, std::reference_wrapper<cc65c::test::fixture>> m_fixture;
 
 				std::mutex m_fixture_mutex;
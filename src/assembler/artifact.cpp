@@ -0,0 +1,644 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../../include/assembler/artifact.h"
+#include "../../include/core/hash.h"
+#include "../../include/runtime.h"
+#include "artifact_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define ARTIFACT_MAGIC 0x41434343
+		#define ARTIFACT_STATISTICS_LENGTH 0x40
+		#define ARTIFACT_VERSION 2
+
+		#define ARTIFACT_READ(_DATA_, _POSITION_, _VALUE_) \
+			if(((_POSITION_) + sizeof(_VALUE_)) > (_DATA_).size()) { \
+				return false; \
+			} \
+			std::memcpy(&(_VALUE_), &(_DATA_)[_POSITION_], sizeof(_VALUE_)); \
+			(_POSITION_) += sizeof(_VALUE_);
+		#define ARTIFACT_WRITE(_DATA_, _VALUE_) \
+			(_DATA_).append((const char *) &(_VALUE_), sizeof(_VALUE_))
+
+		artifact::artifact(void) :
+			m_hits(0),
+			m_misses(0)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		artifact::~artifact(void)
+		{
+			TRACE_ENTRY();
+
+			uninitialize();
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		artifact::as_string(
+			__in const artifact &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << CC65C_ASSEMBLER_ARTIFACT_HEADER
+				<< " " << cc65c::core::singleton<cc65c::assembler::artifact>::as_string(reference, verbose);
+
+			if(verbose) {
+				result << ", Instance=" << SCALAR_AS_HEX(uintptr_t, &reference);
+			}
+
+			if(reference.m_initialized) {
+				result << ", Hit/Miss=" << reference.m_hits << "/" << reference.m_misses;
+
+				if(!reference.m_directory.empty()) {
+					result << ", Directory[" << reference.m_directory.size() << "]=\"" 
+						<< reference.m_directory << "\"";
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		artifact::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			m_hits = 0;
+			m_misses = 0;
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		artifact::directory(void)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			result = m_directory;
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		bool 
+		artifact::fetch(
+			__in const std::string &input,
+			__in const std::map<std::string, int32_t> &define,
+			__in const std::vector<std::string> &output,
+			__in_opt bool relax,
+			__in_opt bool peephole
+			)
+		{
+			std::string data;
+			bool result = false;
+			uint64_t key, manifest;
+			std::vector<std::pair<std::string, uint64_t>> dependency;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			if(!cc65c::core::singleton<cc65c::assembler::artifact>::is_initialized()) {
+				THROW_CC65C_ASSEMBLER_ARTIFACT_EXCEPTION(CC65C_ASSEMBLER_ARTIFACT_EXCEPTION_UNINITIALIZED);
+			}
+
+			if(!m_directory.empty()) {
+				result = (key_manifest(input, define, output, relax, peephole, manifest)
+					&& read(path(manifest, ARTIFACT_MANIFEST_EXTENSION), data)
+					&& load_manifest(data, dependency)
+					&& key_result(manifest, dependency, key)
+					&& read(path(key, ARTIFACT_RESULT_EXTENSION), data)
+					&& load_result(data, output));
+				record(result);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		size_t 
+		artifact::hits(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			result = m_hits;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		artifact::initialize(void)
+		{
+			TRACE_ENTRY();
+
+			if(cc65c::core::singleton<cc65c::assembler::artifact>::is_initialized()) {
+				THROW_CC65C_ASSEMBLER_ARTIFACT_EXCEPTION(CC65C_ASSEMBLER_ARTIFACT_EXCEPTION_INITIALIZED);
+			}
+
+			cc65c::core::singleton<cc65c::assembler::artifact>::set_initialized(true);
+			TRACE_INFORMATION("Build cache initialized");
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		artifact::key_manifest(
+			__in const std::string &input,
+			__in const std::map<std::string, int32_t> &define,
+			__in const std::vector<std::string> &output,
+			__in bool relax,
+			__in bool peephole,
+			__inout uint64_t &key
+			)
+		{
+			uint64_t value;
+			bool result, present;
+			std::string data, entry;
+			std::map<std::string, int32_t>::const_iterator define_iter;
+			std::vector<std::string>::const_iterator output_iter;
+
+			TRACE_ENTRY();
+
+			result = read(input, entry);
+			if(result) {
+				data = cc65c::runtime::version(true);
+				data.append(1, '\0');
+				data.append(input);
+				data.append(1, '\0');
+				value = cc65c::core::hash::generate(entry);
+				ARTIFACT_WRITE(data, value);
+
+				for(define_iter = define.begin(); define_iter != define.end(); ++define_iter) {
+					data.append(define_iter->first);
+					data.append(1, '\0');
+					ARTIFACT_WRITE(data, define_iter->second);
+				}
+
+				for(output_iter = output.begin(); output_iter != output.end(); ++output_iter) {
+					present = !output_iter->empty();
+					ARTIFACT_WRITE(data, present);
+				}
+
+				ARTIFACT_WRITE(data, relax);
+				ARTIFACT_WRITE(data, peephole);
+
+				key = cc65c::core::hash::generate(data);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		artifact::key_result(
+			__in uint64_t manifest,
+			__in const std::vector<std::pair<std::string, uint64_t>> &dependency,
+			__inout uint64_t &key
+			)
+		{
+			std::string data;
+			bool result = true;
+			std::vector<std::pair<std::string, uint64_t>>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			ARTIFACT_WRITE(data, manifest);
+
+			for(iter = dependency.begin(); iter != dependency.end(); ++iter) {
+				data.append(iter->first);
+				data.append(1, '\0');
+				ARTIFACT_WRITE(data, iter->second);
+			}
+
+			key = cc65c::core::hash::generate(data);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		artifact::load_manifest(
+			__in const std::string &data,
+			__inout std::vector<std::pair<std::string, uint64_t>> &dependency
+			)
+		{
+			std::string entry;
+			uint64_t stored;
+			size_t position = 0;
+			uint32_t count, length, magic, version;
+
+			TRACE_ENTRY();
+
+			ARTIFACT_READ(data, position, magic);
+			ARTIFACT_READ(data, position, version);
+			ARTIFACT_READ(data, position, count);
+
+			if((magic != ARTIFACT_MAGIC) || (version != ARTIFACT_VERSION)) {
+				return false;
+			}
+
+			for(; count; --count) {
+				ARTIFACT_READ(data, position, length);
+
+				if((position + length) > data.size()) {
+					return false;
+				}
+
+				dependency.push_back(std::make_pair(data.substr(position, length), 0));
+				position += length;
+				ARTIFACT_READ(data, position, stored);
+
+				if(!read(dependency.back().first, entry)) {
+					return false;
+				}
+
+				dependency.back().second = cc65c::core::hash::generate(entry);
+				if(dependency.back().second != stored) {
+					return false;
+				}
+			}
+
+			TRACE_EXIT();
+			return true;
+		}
+
+		bool 
+		artifact::load_result(
+			__in const std::string &data,
+			__in const std::vector<std::string> &output
+			)
+		{
+			size_t index, position = 0;
+			uint32_t count, length, magic, version;
+
+			TRACE_ENTRY();
+
+			ARTIFACT_READ(data, position, magic);
+			ARTIFACT_READ(data, position, version);
+			ARTIFACT_READ(data, position, count);
+
+			if((magic != ARTIFACT_MAGIC) || (version != ARTIFACT_VERSION) || (count != output.size())) {
+				return false;
+			}
+
+			for(index = 0; index < output.size(); ++index) {
+				ARTIFACT_READ(data, position, length);
+
+				if((position + length) > data.size()) {
+					return false;
+				}
+
+				if(!output.at(index).empty() && !write(output.at(index), data.substr(position, length))) {
+					return false;
+				}
+
+				position += length;
+			}
+
+			TRACE_EXIT();
+			return true;
+		}
+
+		size_t 
+		artifact::misses(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			result = m_misses;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::string 
+		artifact::path(
+			__in const std::string &name
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			result = m_directory;
+
+			if(result.back() != '/') {
+				result += "/";
+			}
+
+			result += name;
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::string 
+		artifact::path(
+			__in uint64_t key,
+			__in const std::string &extension
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << std::setw(sizeof(uint64_t) * 2) << std::setfill('0') << std::hex << key << extension;
+
+			TRACE_EXIT();
+			return path(result.str());
+		}
+
+		bool 
+		artifact::read(
+			__in const std::string &path,
+			__inout std::string &data
+			)
+		{
+			bool result;
+			std::ifstream file;
+
+			TRACE_ENTRY();
+
+			file = std::ifstream(path.c_str(), std::ios::binary | std::ios::in);
+
+			result = file.good();
+			if(result) {
+				data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+				file.close();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		artifact::record(
+			__in bool hit
+			)
+		{
+			int file;
+			ssize_t length;
+			unsigned long long count[2] = { 0 };
+			char buffer[ARTIFACT_STATISTICS_LENGTH] = { 0 };
+
+			TRACE_ENTRY();
+
+			if(hit) {
+				++m_hits;
+			} else {
+				++m_misses;
+			}
+
+			mkdir(m_directory.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+
+			file = open(path(ARTIFACT_STATISTICS).c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+			if(file >= 0) {
+
+				if(!flock(file, LOCK_EX)) {
+					length = pread(file, buffer, sizeof(buffer) - 1, 0);
+					if(length > 0) {
+						std::sscanf(buffer, "%llu %llu", &count[0], &count[1]);
+					}
+
+					++count[hit ? 0 : 1];
+					length = std::snprintf(buffer, sizeof(buffer), "%llu %llu\n", count[0], count[1]);
+
+					if(!ftruncate(file, 0) && (pwrite(file, buffer, length, 0) != length)) {
+						TRACE_WARNING("Failed to update build cache statistics");
+					}
+
+					flock(file, LOCK_UN);
+				}
+
+				close(file);
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		artifact::set_directory(
+			__in const std::string &directory
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			m_directory = directory;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		artifact::statistics(
+			__inout size_t &hits,
+			__inout size_t &misses
+			)
+		{
+			std::string data;
+			unsigned long long count[2] = { 0 };
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			hits = m_hits;
+			misses = m_misses;
+
+			if(!m_directory.empty() && read(path(ARTIFACT_STATISTICS), data) 
+					&& (std::sscanf(data.c_str(), "%llu %llu", &count[0], &count[1]) == 2)) {
+				hits = count[0];
+				misses = count[1];
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		artifact::store(
+			__in const std::string &input,
+			__in const std::map<std::string, int32_t> &define,
+			__in const std::set<std::string> &dependency,
+			__in const std::vector<std::string> &output,
+			__in_opt bool relax,
+			__in_opt bool peephole
+			)
+		{
+			bool result;
+			uint64_t manifest, key;
+			std::string data, entry;
+			uint32_t count, length, magic = ARTIFACT_MAGIC, version = ARTIFACT_VERSION;
+			std::set<std::string>::const_iterator dependency_iter;
+			std::vector<std::string>::const_iterator output_iter;
+			std::vector<std::pair<std::string, uint64_t>> hashed;
+			std::vector<std::pair<std::string, uint64_t>>::const_iterator hashed_iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_artifact_mutex);
+
+			if(!cc65c::core::singleton<cc65c::assembler::artifact>::is_initialized()) {
+				THROW_CC65C_ASSEMBLER_ARTIFACT_EXCEPTION(CC65C_ASSEMBLER_ARTIFACT_EXCEPTION_UNINITIALIZED);
+			}
+
+			result = (!m_directory.empty() && key_manifest(input, define, output, relax, peephole, manifest));
+
+			for(dependency_iter = dependency.begin(); result && (dependency_iter != dependency.end()); 
+					++dependency_iter) {
+				result = read(*dependency_iter, entry);
+				if(result) {
+					hashed.push_back(std::make_pair(*dependency_iter, cc65c::core::hash::generate(entry)));
+				}
+			}
+
+			if(result) {
+				count = output.size();
+				ARTIFACT_WRITE(data, magic);
+				ARTIFACT_WRITE(data, version);
+				ARTIFACT_WRITE(data, count);
+
+				for(output_iter = output.begin(); result && (output_iter != output.end()); ++output_iter) {
+					entry.clear();
+
+					if(!output_iter->empty()) {
+						result = read(*output_iter, entry);
+					}
+
+					length = entry.size();
+					ARTIFACT_WRITE(data, length);
+					data.append(entry);
+				}
+			}
+
+			if(result && key_result(manifest, hashed, key)) {
+				mkdir(m_directory.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+
+				if(write(path(key, ARTIFACT_RESULT_EXTENSION), data)) {
+					data.clear();
+					count = hashed.size();
+					ARTIFACT_WRITE(data, magic);
+					ARTIFACT_WRITE(data, version);
+					ARTIFACT_WRITE(data, count);
+
+					for(hashed_iter = hashed.begin(); hashed_iter != hashed.end(); ++hashed_iter) {
+						length = hashed_iter->first.size();
+						ARTIFACT_WRITE(data, length);
+						data.append(hashed_iter->first);
+						ARTIFACT_WRITE(data, hashed_iter->second);
+					}
+
+					write(path(manifest, ARTIFACT_MANIFEST_EXTENSION), data);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		artifact::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			result = cc65c::assembler::artifact::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		artifact::uninitialize(void)
+		{
+			TRACE_ENTRY();
+
+			if(cc65c::core::singleton<cc65c::assembler::artifact>::is_initialized()) {
+				cc65c::core::singleton<cc65c::assembler::artifact>::set_initialized(false);
+				clear();
+				TRACE_INFORMATION("Build cache uninitialized");
+			}
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		artifact::write(
+			__in const std::string &path,
+			__in const std::string &data
+			)
+		{
+			bool result;
+			std::ofstream file;
+			std::string staging = (path + ".tmp");
+
+			TRACE_ENTRY();
+
+			file = std::ofstream(staging.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+
+			result = file.good();
+			if(result) {
+				file.write(data.c_str(), data.size());
+				file.close();
+
+				result = (file.good() && !std::rename(staging.c_str(), path.c_str()));
+				if(!result) {
+					std::remove(staging.c_str());
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,581 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <fstream>
+#include "../../include/assembler/cache.h"
+#include "../../include/assembler/parser.h"
+#include "../../include/core/hash.h"
+#include "cache_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define CACHE_MAGIC 0x50434343
+		#define CACHE_VERSION 3
+
+		#define CACHE_READ(_DATA_, _POSITION_, _VALUE_) \
+			if(((_POSITION_) + sizeof(_VALUE_)) > (_DATA_).size()) { \
+				return false; \
+			} \
+			std::memcpy(&(_VALUE_), &(_DATA_)[_POSITION_], sizeof(_VALUE_)); \
+			(_POSITION_) += sizeof(_VALUE_);
+		#define CACHE_WRITE(_DATA_, _VALUE_) \
+			(_DATA_).append((const char *) &(_VALUE_), sizeof(_VALUE_))
+
+		cache::cache(void) :
+			m_hits(0),
+			m_misses(0)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		cache::~cache(void)
+		{
+			TRACE_ENTRY();
+
+			uninitialize();
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		cache::as_string(
+			__in const cache &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << CC65C_ASSEMBLER_CACHE_HEADER
+				<< " " << cc65c::core::singleton<cc65c::assembler::cache>::as_string(reference, verbose);
+
+			if(verbose) {
+				result << ", Instance=" << SCALAR_AS_HEX(uintptr_t, &reference);
+			}
+
+			if(reference.m_initialized) {
+				result << ", Entry[" << reference.m_entry.size() << "]"
+					<< ", Hit/Miss=" << reference.m_hits << "/" << reference.m_misses;
+
+				if(!reference.m_directory.empty()) {
+					result << ", Directory[" << reference.m_directory.size() << "]=\"" 
+						<< reference.m_directory << "\"";
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		cache::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			m_dependency.clear();
+			m_entry.clear();
+			m_hits = 0;
+			m_misses = 0;
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		cache::deserialize(
+			__in const std::string &data,
+			__inout size_t &position,
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			int32_t value;
+			bool result = true, root;
+			uint8_t type;
+			std::string key;
+			size_t index = 0;
+			uint32_t child, column, length, row, subtype;
+
+			TRACE_ENTRY();
+
+			CACHE_READ(data, position, type);
+			CACHE_READ(data, position, subtype);
+			CACHE_READ(data, position, row);
+			CACHE_READ(data, position, column);
+			CACHE_READ(data, position, value);
+			CACHE_READ(data, position, length);
+
+			if((type > TOKEN_MAX) || ((position + length) > data.size())) {
+				return false;
+			}
+
+			key = data.substr(position, length);
+			position += length;
+			CACHE_READ(data, position, child);
+
+			cc65c::assembler::token tok((cc65c::assembler::token_t) type, subtype, row, column);
+			tok.key() = key;
+			tok.value() = value;
+
+			root = tree.empty();
+			index = tree.add(tok);
+
+			if(!root) {
+				tree.move_child_index(index);
+			}
+
+			for(; result && child; --child) {
+				result = deserialize(data, position, tree);
+			}
+
+			if(!root) {
+				tree.move_parent();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		std::string 
+		cache::directory(void)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			result = m_directory;
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		size_t 
+		cache::hits(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			result = m_hits;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		cache::initialize(void)
+		{
+			TRACE_ENTRY();
+
+			if(cc65c::core::singleton<cc65c::assembler::cache>::is_initialized()) {
+				THROW_CC65C_ASSEMBLER_CACHE_EXCEPTION(CC65C_ASSEMBLER_CACHE_EXCEPTION_INITIALIZED);
+			}
+
+			cc65c::core::singleton<cc65c::assembler::cache>::set_initialized(true);
+			TRACE_INFORMATION("Parse cache initialized");
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		cache::is_stale(
+			__in const std::map<std::string, uint64_t> &dependency
+			)
+		{
+			std::string data;
+			bool result = false;
+			std::map<std::string, uint64_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			for(iter = dependency.begin(); !result && (iter != dependency.end()); ++iter) {
+				result = (!read(iter->first, data) || (cc65c::core::hash::generate(data) != iter->second));
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		cache::load(
+			__in uint64_t key,
+			__inout std::vector<cc65c::assembler::tree> &entry
+			)
+		{
+			bool result;
+			std::ifstream file;
+			size_t position = 0;
+			uint64_t hash, stored;
+			std::string data, dependency, source;
+			uint32_t count, length, magic, version;
+
+			TRACE_ENTRY();
+
+			source = path(key);
+			file = std::ifstream(source.c_str(), std::ios::binary | std::ios::in);
+			if(!file) {
+				return false;
+			}
+
+			data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			file.close();
+
+			CACHE_READ(data, position, magic);
+			CACHE_READ(data, position, version);
+			CACHE_READ(data, position, stored);
+
+			result = ((magic == CACHE_MAGIC) && (version == CACHE_VERSION) && (stored == key));
+			if(result) {
+				m_dependency[key].clear();
+				CACHE_READ(data, position, count);
+
+				for(; count; --count) {
+					CACHE_READ(data, position, length);
+
+					if((position + length) > data.size()) {
+						return false;
+					}
+
+					dependency = data.substr(position, length);
+					position += length;
+					CACHE_READ(data, position, hash);
+					m_dependency[key][dependency] = hash;
+				}
+
+				result = !is_stale(m_dependency[key]);
+			}
+
+			CACHE_READ(data, position, count);
+
+			for(; result && count; --count) {
+				cc65c::assembler::tree statement;
+
+				result = deserialize(data, position, statement);
+				if(result) {
+					statement.move_root();
+					entry.push_back(statement);
+				}
+			}
+
+			if(!result) {
+				entry.clear();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		size_t 
+		cache::misses(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			result = m_misses;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		const std::vector<cc65c::assembler::tree> &
+		cache::parse(
+			__in const std::string &path
+			)
+		{
+			uint64_t key;
+			std::string data, source;
+			std::set<std::string> include;
+			std::vector<cc65c::assembler::tree> entry;
+			std::set<std::string>::const_iterator include_iter;
+			std::vector<cc65c::assembler::tree>::const_iterator iter;
+			std::map<uint64_t, std::vector<cc65c::assembler::tree>>::iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			if(!cc65c::core::singleton<cc65c::assembler::cache>::is_initialized()) {
+				THROW_CC65C_ASSEMBLER_CACHE_EXCEPTION(CC65C_ASSEMBLER_CACHE_EXCEPTION_UNINITIALIZED);
+			}
+
+			if(!read(path, data)) {
+				THROW_CC65C_ASSEMBLER_CACHE_EXCEPTION_FORMAT(CC65C_ASSEMBLER_CACHE_EXCEPTION_FILE_NOT_FOUND,
+					"Path[%u]=\"%s\"", path.size(), STRING_CHECK(path));
+			}
+
+			key = cc65c::core::hash::generate(data);
+
+			result = m_entry.find(key);
+			if((result != m_entry.end()) && is_stale(m_dependency[key])) {
+				m_entry.erase(result);
+				result = m_entry.end();
+			}
+
+			if(result == m_entry.end()) {
+
+				if(m_directory.empty() || !load(key, entry)) {
+					cc65c::assembler::parser input(path, true);
+
+					input.enumerate();
+
+					for(iter = input.tree_begin(); iter != input.tree_end(); ++iter) {
+
+						cc65c::assembler::tree statement(*iter);
+						if(statement.match(TREE_STATEMENT)) {
+							statement.move_root();
+							entry.push_back(statement);
+						}
+					}
+
+					m_dependency[key].clear();
+					include = input.macro_include();
+
+					for(include_iter = include.begin(); include_iter != include.end(); ++include_iter) {
+
+						if(read(*include_iter, source)) {
+							m_dependency[key][*include_iter] = cc65c::core::hash::generate(source);
+						}
+					}
+
+					if(!m_directory.empty()) {
+						store(key, entry);
+					}
+
+					++m_misses;
+				} else {
+					++m_hits;
+				}
+
+				result = m_entry.insert(std::make_pair(key, entry)).first;
+			} else {
+				++m_hits;
+			}
+
+			TRACE_EXIT();
+			return result->second;
+		}
+
+		std::string 
+		cache::path(
+			__in uint64_t key
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << m_directory;
+
+			if(m_directory.back() != '/') {
+				result << "/";
+			}
+
+			result << std::setw(sizeof(uint64_t) * 2) << std::setfill('0') << std::hex << key << CACHE_EXTENSION;
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		bool 
+		cache::read(
+			__in const std::string &path,
+			__inout std::string &data
+			)
+		{
+			bool result;
+			std::ifstream file;
+
+			TRACE_ENTRY();
+
+			file = std::ifstream(path.c_str(), std::ios::binary | std::ios::in);
+
+			result = file.good();
+			if(result) {
+				data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+				file.close();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		cache::serialize(
+			__inout std::string &data,
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			int32_t value;
+			uint8_t type;
+			size_t iter = 0;
+			uint32_t child, column, length, row, subtype;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			type = tok.type();
+			subtype = tok.subtype();
+			row = tok.row();
+			column = tok.column();
+			value = tok.value();
+			length = tok.key().size();
+			child = tree.node().size();
+
+			CACHE_WRITE(data, type);
+			CACHE_WRITE(data, subtype);
+			CACHE_WRITE(data, row);
+			CACHE_WRITE(data, column);
+			CACHE_WRITE(data, value);
+			CACHE_WRITE(data, length);
+			data.append(tok.key());
+			CACHE_WRITE(data, child);
+
+			for(; iter < child; ++iter) {
+				tree.move_child_index(iter);
+				serialize(data, tree);
+				tree.move_parent();
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		cache::set_directory(
+			__in const std::string &directory
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			m_directory = directory;
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		cache::size(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+
+			result = m_entry.size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		cache::store(
+			__in uint64_t key,
+			__in const std::vector<cc65c::assembler::tree> &entry
+			)
+		{
+			uint32_t length;
+			std::ofstream file;
+			std::string data, destination, staging;
+			std::vector<cc65c::assembler::tree>::const_iterator iter;
+			std::map<std::string, uint64_t>::const_iterator dependency_iter;
+			uint32_t count = m_dependency[key].size(), magic = CACHE_MAGIC, version = CACHE_VERSION;
+
+			TRACE_ENTRY();
+
+			CACHE_WRITE(data, magic);
+			CACHE_WRITE(data, version);
+			CACHE_WRITE(data, key);
+			CACHE_WRITE(data, count);
+
+			for(dependency_iter = m_dependency[key].begin(); dependency_iter != m_dependency[key].end(); 
+					++dependency_iter) {
+				length = dependency_iter->first.size();
+				CACHE_WRITE(data, length);
+				data.append(dependency_iter->first);
+				CACHE_WRITE(data, dependency_iter->second);
+			}
+
+			count = entry.size();
+			CACHE_WRITE(data, count);
+
+			for(iter = entry.begin(); iter != entry.end(); ++iter) {
+				cc65c::assembler::tree statement(*iter);
+				statement.move_root();
+				serialize(data, statement);
+			}
+
+			destination = path(key);
+			staging = (destination + ".tmp");
+
+			file = std::ofstream(staging.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+			if(file) {
+				file.write(data.c_str(), data.size());
+				file.close();
+
+				if(!file || std::rename(staging.c_str(), destination.c_str())) {
+					std::remove(staging.c_str());
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		cache::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			result = cc65c::assembler::cache::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		cache::uninitialize(void)
+		{
+			TRACE_ENTRY();
+
+			if(cc65c::core::singleton<cc65c::assembler::cache>::is_initialized()) {
+				cc65c::core::singleton<cc65c::assembler::cache>::set_initialized(false);
+				clear();
+				TRACE_INFORMATION("Parse cache uninitialized");
+			}
+
+			TRACE_EXIT();
+		}
+	}
+}
@@ -0,0 +1,2699 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <fcntl.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif // __AVX2__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../../include/assembler/cache.h"
+#include "../../include/assembler/generator.h"
+#include "generator_type.h"
+#include "../../include/core/counter.h"
+#include "../../include/core/trace.h"
+#include "../../include/emulator/define.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define EXCEPTION_TAB_COUNT 1
+
+		#define GENERATOR_PATH (m_include.empty() ? std::string() : m_include.back())
+
+		#define GENERATOR_PASS_MAX 0x40
+
+		#define GENERATOR_SHORTEN_LENGTH (ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ABSOLUTE) \
+			- ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ZERO_PAGE))
+
+		#define HEX_INVALID -1
+		#define HEX_SPACE -2
+
+		static const int8_t HEX_VALUE[] = {
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_SPACE, HEX_SPACE, HEX_SPACE, HEX_SPACE, HEX_SPACE, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_SPACE, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, 10, 11, 12, 13, 14, 15, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, 10, 11, 12, 13, 14, 15, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID, HEX_INVALID,
+			};
+
+#if defined(__AVX2__)
+		#define HEX_VECTOR_WIDTH 32
+
+		typedef __m256i hex_vector_t;
+
+		#define HEX_VECTOR_AND(_LEFT_, _RIGHT_) _mm256_and_si256(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_BYTE(_VALUE_) _mm256_set1_epi8(_VALUE_)
+		#define HEX_VECTOR_GREATER(_LEFT_, _RIGHT_) _mm256_cmpgt_epi8(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_LOAD(_INPUT_) _mm256_loadu_si256((const __m256i *) (_INPUT_))
+		#define HEX_VECTOR_MASK(_VALUE_) ((uint32_t) _mm256_movemask_epi8(_VALUE_))
+		#define HEX_VECTOR_MASK_FULL UINT32_MAX
+		#define HEX_VECTOR_OR(_LEFT_, _RIGHT_) _mm256_or_si256(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_PACK(_LEFT_, _RIGHT_) \
+			_mm256_permute4x64_epi64(_mm256_packus_epi16(_LEFT_, _RIGHT_), 0xd8)
+		#define HEX_VECTOR_SHIFT_LEFT(_VALUE_, _COUNT_) _mm256_slli_epi16(_VALUE_, _COUNT_)
+		#define HEX_VECTOR_SHIFT_RIGHT(_VALUE_, _COUNT_) _mm256_srli_epi16(_VALUE_, _COUNT_)
+		#define HEX_VECTOR_STORE(_OUTPUT_, _VALUE_) _mm256_storeu_si256((__m256i *) (_OUTPUT_), _VALUE_)
+		#define HEX_VECTOR_SUBTRACT(_LEFT_, _RIGHT_) _mm256_sub_epi8(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_WORD(_VALUE_) _mm256_set1_epi16(_VALUE_)
+#elif defined(__SSE2__)
+		#define HEX_VECTOR_WIDTH 16
+
+		typedef __m128i hex_vector_t;
+
+		#define HEX_VECTOR_AND(_LEFT_, _RIGHT_) _mm_and_si128(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_BYTE(_VALUE_) _mm_set1_epi8(_VALUE_)
+		#define HEX_VECTOR_GREATER(_LEFT_, _RIGHT_) _mm_cmpgt_epi8(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_LOAD(_INPUT_) _mm_loadu_si128((const __m128i *) (_INPUT_))
+		#define HEX_VECTOR_MASK(_VALUE_) ((uint32_t) _mm_movemask_epi8(_VALUE_))
+		#define HEX_VECTOR_MASK_FULL UINT16_MAX
+		#define HEX_VECTOR_OR(_LEFT_, _RIGHT_) _mm_or_si128(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_PACK(_LEFT_, _RIGHT_) _mm_packus_epi16(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_SHIFT_LEFT(_VALUE_, _COUNT_) _mm_slli_epi16(_VALUE_, _COUNT_)
+		#define HEX_VECTOR_SHIFT_RIGHT(_VALUE_, _COUNT_) _mm_srli_epi16(_VALUE_, _COUNT_)
+		#define HEX_VECTOR_STORE(_OUTPUT_, _VALUE_) _mm_storeu_si128((__m128i *) (_OUTPUT_), _VALUE_)
+		#define HEX_VECTOR_SUBTRACT(_LEFT_, _RIGHT_) _mm_sub_epi8(_LEFT_, _RIGHT_)
+		#define HEX_VECTOR_WORD(_VALUE_) _mm_set1_epi16(_VALUE_)
+#endif // __AVX2__
+
+		#define THROW_GENERATOR_EXCEPTION(_EXCEPT_, _PATH_, _ROW_, _COLUMN_) \
+			THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(_EXCEPT_, "\n%s", STRING_CHECK( \
+				as_exception_source(_PATH_, _ROW_, _COLUMN_)))
+
+		#define THROW_GENERATOR_EXCEPTION_FORMAT(_EXCEPT_, _PATH_, _ROW_, _COLUMN_, _FORMAT_, ...) \
+			THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_ "\n%s", __VA_ARGS__, STRING_CHECK( \
+				as_exception_source(_PATH_, _ROW_, _COLUMN_)))
+
+		generator::generator(void) :
+			m_command(0),
+			m_pass(0),
+			m_peephole_boundary(true),
+			m_peephole_enabled(false),
+			m_relax_enabled(false),
+			m_relayout_safe(true),
+			m_relocatable(false),
+			m_segment_current(SEGMENT_DEFAULT)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		generator::generator(
+			__in const std::string &input,
+			__in_opt bool is_file
+			) :
+				cc65c::assembler::parser(input, is_file),
+				m_command(0),
+				m_pass(0),
+				m_peephole_boundary(true),
+				m_peephole_enabled(false),
+				m_relax_enabled(false),
+				m_relayout_safe(true),
+				m_relocatable(false),
+				m_segment_current(SEGMENT_DEFAULT)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		generator::generator(
+			__in const generator &other
+			) :
+				cc65c::assembler::parser(other),
+				m_command(other.m_command),
+				m_define(other.m_define),
+				m_dependency(other.m_dependency),
+				m_expression(other.m_expression),
+				m_expression_index(other.m_expression_index),
+				m_fixup(other.m_fixup),
+				m_fixup_tree(other.m_fixup_tree),
+				m_include(other.m_include),
+				m_label(other.m_label),
+				m_listing(other.m_listing),
+				m_listing_source(other.m_listing_source),
+				m_pass(other.m_pass),
+				m_peephole(other.m_peephole),
+				m_peephole_boundary(other.m_peephole_boundary),
+				m_peephole_command(other.m_peephole_command),
+				m_peephole_enabled(other.m_peephole_enabled),
+				m_peephole_report(other.m_peephole_report),
+				m_relax(other.m_relax),
+				m_relax_branch(other.m_relax_branch),
+				m_relax_enabled(other.m_relax_enabled),
+				m_relax_fixup(other.m_relax_fixup),
+				m_relayout_safe(other.m_relayout_safe),
+				m_relocatable(other.m_relocatable),
+				m_segment(other.m_segment),
+				m_segment_current(other.m_segment_current),
+				m_shorten(other.m_shorten),
+				m_shorten_candidate(other.m_shorten_candidate),
+				m_shorten_fixup(other.m_shorten_fixup),
+				m_shorten_pinned(other.m_shorten_pinned),
+				m_table(other.m_table)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		generator::~generator(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		generator &
+		generator::operator=(
+			__in const generator &other
+			)
+		{
+			TRACE_ENTRY();
+
+			if(this != &other) {
+				cc65c::assembler::parser::operator=(other);
+				m_command = other.m_command;
+				m_define = other.m_define;
+				m_dependency = other.m_dependency;
+				m_expression = other.m_expression;
+				m_expression_index = other.m_expression_index;
+				m_fixup = other.m_fixup;
+				m_fixup_tree = other.m_fixup_tree;
+				m_include = other.m_include;
+				m_label = other.m_label;
+				m_listing = other.m_listing;
+				m_listing_source = other.m_listing_source;
+				m_pass = other.m_pass;
+				m_peephole = other.m_peephole;
+				m_peephole_boundary = other.m_peephole_boundary;
+				m_peephole_command = other.m_peephole_command;
+				m_peephole_enabled = other.m_peephole_enabled;
+				m_peephole_report = other.m_peephole_report;
+				m_relax = other.m_relax;
+				m_relax_branch = other.m_relax_branch;
+				m_relax_enabled = other.m_relax_enabled;
+				m_relax_fixup = other.m_relax_fixup;
+				m_relayout_safe = other.m_relayout_safe;
+				m_relocatable = other.m_relocatable;
+				m_segment = other.m_segment;
+				m_segment_current = other.m_segment_current;
+				m_shorten = other.m_shorten;
+				m_shorten_candidate = other.m_shorten_candidate;
+				m_shorten_fixup = other.m_shorten_fixup;
+				m_shorten_pinned = other.m_shorten_pinned;
+				m_table = other.m_table;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", this);
+			return *this;
+		}
+
+		uint16_t 
+		generator::address(void)
+		{
+			uint16_t result = 0;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			iter = m_segment.find(m_segment_current);
+			if((iter != m_segment.end()) && !iter->second.empty()) {
+				result = (iter->second.back().first + iter->second.back().second.size());
+			}
+
+			TRACE_EXIT_FORMAT("Result=%04x", result);
+			return result;
+		}
+
+		std::string 
+		generator::as_exception_source(
+			__in const std::string &path,
+			__in cc65c::core::stream_t row,
+			__in cc65c::core::stream_t column
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			if(path.empty()) {
+				result << cc65c::assembler::lexer::as_exception(row, column, true, EXCEPTION_TAB_COUNT);
+			} else {
+				result << "\t" << path << "@" << row << ":" << column;
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		std::string 
+		generator::as_string(
+			__in const generator &reference,
+			__in_opt bool verbose
+			)
+		{
+			size_t size = 0;
+			std::stringstream result;
+			std::vector<cc65c::assembler::block_t>::const_iterator block_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			for(iter = reference.m_segment.begin(); iter != reference.m_segment.end(); ++iter) {
+
+				for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+					size += block_iter->second.size();
+				}
+			}
+
+			result << "Segment[" << reference.m_segment.size() << "], Fixup[" << reference.m_fixup.size() 
+				<< "], Size=" << size << ", Passes=" << reference.m_pass << ", Peephole=" 
+				<< reference.m_peephole.size() << ", Relaxed=" << reference.m_relax.size() << ", Shortened=" 
+				<< reference.m_shorten.size() << ", Symbol={" 
+				<< cc65c::assembler::table::as_string(reference.m_table, verbose) << "}";
+
+			if(verbose) {
+
+				for(iter = reference.m_segment.begin(); iter != reference.m_segment.end(); ++iter) {
+					result << std::endl << "\t" << STRING_CHECK(iter->first) << "[" << iter->second.size() << "]";
+
+					for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+						result << std::endl << "\t\t" << SCALAR_AS_HEX(uint16_t, block_iter->first) 
+							<< "[" << block_iter->second.size() << "]";
+					}
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		cc65c::assembler::block_t &
+		generator::block(void)
+		{
+			TRACE_ENTRY();
+
+			std::vector<cc65c::assembler::block_t> &entry = m_segment[m_segment_current];
+			if(entry.empty()) {
+				entry.push_back(cc65c::assembler::block_t(0, std::vector<uint8_t>()));
+			}
+
+			cc65c::assembler::block_t &result = entry.back();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		generator::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			cc65c::assembler::parser::clear();
+			reset_generator();
+			m_expression.clear();
+			m_expression_index.clear();
+			m_table.clear();
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		generator::contains_symbol(
+			__in const std::string &name
+			)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			result = m_table.contains(name);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		generator::define(
+			__in const std::string &name,
+			__in int32_t value
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			m_define[name] = value;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::define_symbol(
+			__in const std::string &name,
+			__in cc65c::assembler::table_symbol_t type,
+			__in int32_t value
+			)
+		{
+			std::vector<size_t> resolved;
+			std::vector<size_t>::iterator iter;
+
+			TRACE_ENTRY();
+
+			m_table.define(m_table.intern(name), type, value, resolved);
+
+			for(iter = resolved.begin(); iter != resolved.end(); ++iter) {
+
+				if(!--std::get<FIXUP_METADATA_PENDING>(m_fixup.at(*iter))) {
+					patch(*iter);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		std::set<std::string>::const_iterator 
+		generator::dependency_begin(void)
+		{
+			std::set<std::string>::const_iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_dependency.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::set<std::string>::const_iterator 
+		generator::dependency_end(void)
+		{
+			std::set<std::string>::const_iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_dependency.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		generator::emit(
+			__in uint8_t value
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::assembler::block_t &entry = block();
+			if((entry.first + entry.second.size()) > UINT16_MAX) {
+				THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_BOUNDS,
+					"Segment=%s, Address=%x", STRING_CHECK(m_segment_current), entry.first + entry.second.size());
+			}
+
+			entry.second.push_back(value);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::emit(
+			__in const uint8_t *data,
+			__in size_t length
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::assembler::block_t &entry = block();
+			if((entry.first + entry.second.size() + length) > (UINT16_MAX + 1)) {
+				THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_BOUNDS,
+					"Segment=%s, Address=%x, Length=%u", STRING_CHECK(m_segment_current), 
+					entry.first + entry.second.size(), length);
+			}
+
+			entry.second.insert(entry.second.end(), data, data + length);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::emit_branch(
+			__in int32_t value,
+			__in const std::vector<size_t> &unresolved,
+			__inout cc65c::assembler::tree &tree,
+			__in size_t index,
+			__in uint16_t address,
+			__in size_t command,
+			__in uint32_t type
+			)
+		{
+			size_t growth, length;
+
+			TRACE_ENTRY();
+
+			if(m_relax_enabled && !m_relocatable) {
+				length = ((cc65c::assembler::generator::address() + 1) - address);
+				growth = (ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ABSOLUTE) 
+					- ((type == KEYWORD_COMMAND_BRA) ? length : 0));
+				m_relax_fixup[m_fixup.size()] = m_relax_branch.size();
+				m_relax_branch.push_back(std::make_tuple(address, m_segment[m_segment_current].size() - 1, command, 
+					m_fixup.size(), growth, length, address - block().first, false, m_segment_current, value, type));
+			}
+
+			emit_value(value, FIXUP_RELATIVE, unresolved, tree, index, address);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::emit_value(
+			__in int32_t value,
+			__in cc65c::assembler::fixup_t type,
+			__in const std::vector<size_t> &unresolved,
+			__inout cc65c::assembler::tree &tree,
+			__in size_t index,
+			__in uint16_t address
+			)
+		{
+			size_t block, offset;
+			cc65c::core::stream_t column, row;
+			std::vector<size_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			offset = cc65c::assembler::generator::block().second.size();
+			block = (m_segment[m_segment_current].size() - 1);
+
+			cc65c::assembler::token tok = tree.token();
+			column = tok.column();
+			row = tok.row();
+
+			emit(0);
+
+			if(type == FIXUP_ABSOLUTE_WORD) {
+				emit(0);
+			}
+
+			if(!enumerate_expression_tracked(tree, index, unresolved) 
+					&& ((type != FIXUP_RELATIVE) || m_relocatable)) {
+				write(m_segment_current, block, offset, value, type, GENERATOR_PATH, row, column);
+			} else {
+
+				if(m_fixup_tree.empty() || (m_fixup_tree.back().id() != tree.id())) {
+					m_fixup_tree.push_back(tree);
+				}
+
+				for(iter = unresolved.begin(); iter != unresolved.end(); ++iter) {
+					m_table.wait(*iter, m_fixup.size());
+				}
+
+				m_fixup.push_back(std::make_tuple(address, block, column, index, tree.node().id(), offset, 
+					GENERATOR_PATH, unresolved.size(), m_expression_index.at(std::make_pair(tree.node().id(), index)), 
+					row, m_segment_current, m_fixup_tree.size() - 1, type));
+
+				if(unresolved.empty()) {
+					patch(m_fixup.size() - 1);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		generator::enumerate(void)
+		{
+			size_t iteration = 0, result;
+			bool relaxed, relayout = false, rewritten, shortened;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			m_expression.clear();
+			m_expression_index.clear();
+			m_table.clear();
+			m_pass = 0;
+			m_peephole.clear();
+			m_relax.clear();
+			m_shorten.clear();
+			m_shorten_pinned.clear();
+
+			for(;;) {
+
+				if(!relayout) {
+					enumerate_input(false);
+					++m_pass;
+				}
+
+				++iteration;
+				relaxed = enumerate_relax();
+				rewritten = ((iteration <= GENERATOR_PASS_MAX) && enumerate_peephole());
+				shortened = enumerate_shorten(iteration > GENERATOR_PASS_MAX);
+
+				if(!relaxed && !rewritten && !shortened) {
+					break;
+				}
+
+				if(iteration == GENERATOR_PASS_MAX) {
+					TRACE_WARNING_FORMAT("Generator pass limit reached", "Passes=%u, Peephole=%u, Shortened=%u", 
+						iteration, m_peephole.size(), m_shorten.size());
+				}
+
+				relayout = (!rewritten && enumerate_relayout());
+			}
+
+			result = size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		generator::enumerate_command(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			uint16_t address, opcode;
+			bool indexed, nested = false;
+			int32_t target = 0, value = 0;
+			size_t command = m_command++, count, index = 0, index_target = 0;
+			uint32_t mode = ADDRESS_MODE_IMPLIED, type;
+			std::vector<size_t> unresolved, unresolved_target;
+			std::map<size_t, cc65c::assembler::peephole_rewrite_t>::const_iterator peephole_iter;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			address = cc65c::assembler::generator::address();
+			count = tree.node().size();
+			type = tok.subtype();
+
+			if(!count) {
+				mode = (ADDRESS_MODE_IMPLIED_CONTAINS(type) ? ADDRESS_MODE_IMPLIED : ADDRESS_MODE_STACK);
+			} else {
+				tree.move_child_index(index);
+				cc65c::assembler::token child = tree.token();
+				tree.move_parent();
+
+				if(child.match(TOKEN_KEYWORD_REGISTER, KEYWORD_REGISTER_A)) {
+					mode = ADDRESS_MODE_ACCUMULATOR;
+				} else if(child.match(TOKEN_SYMBOL_IMMEDIATE)) {
+					tree.move_child_index(index);
+					value = enumerate_expression(tree, index, origin(), address, unresolved);
+					tree.move_parent();
+					mode = ADDRESS_MODE_IMMEDIATE;
+					nested = true;
+				} else if(child.match(TOKEN_SYMBOL_BRACE, SYMBOL_BRACE_OPEN)) {
+					tree.move_child_index(index);
+					value = enumerate_expression(tree, index, origin(), address, unresolved);
+					indexed = (index < tree.node().size());
+					tree.move_parent();
+
+					if(indexed) {
+						mode = ((type == KEYWORD_COMMAND_JMP) ? ADDRESS_MODE_ABSOLUTE_INDEX_INDIRECT 
+							: ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT);
+					} else if(count > 2) {
+						mode = ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX;
+					} else {
+						mode = ((type == KEYWORD_COMMAND_JMP) ? ADDRESS_MODE_ABSOLUTE_INDIRECT 
+							: ADDRESS_MODE_ZERO_PAGE_INDIRECT);
+					}
+
+					nested = true;
+				} else {
+					value = enumerate_expression(tree, index, origin(), address, unresolved);
+
+					if(ADDRESS_MODE_RELATIVE_CONTAINS(type)) {
+						mode = ADDRESS_MODE_RELATIVE;
+
+						if(ADDRESS_MODE_RELATIVE_BIT_CONTAINS(type)) {
+							index_target = index;
+							target = enumerate_expression(tree, index, origin(), address, unresolved_target);
+						}
+					} else if(index < count) {
+						tree.move_child_index(index);
+						child = tree.token();
+						tree.move_parent();
+
+						if(child.match(TOKEN_KEYWORD_REGISTER, KEYWORD_REGISTER_X)) {
+							mode = enumerate_command_mode(command, type, value, unresolved, 
+								enumerate_expression_tracked(tree, 0, unresolved), ADDRESS_MODE_ZERO_PAGE_INDEX_X, 
+								ADDRESS_MODE_ABSOLUTE_INDEX_X);
+						} else {
+							mode = enumerate_command_mode(command, type, value, unresolved, 
+								enumerate_expression_tracked(tree, 0, unresolved), ADDRESS_MODE_ZERO_PAGE_INDEX_Y, 
+								ADDRESS_MODE_ABSOLUTE_INDEX_Y);
+						}
+					} else {
+						mode = enumerate_command_mode(command, type, value, unresolved, 
+							enumerate_expression_tracked(tree, 0, unresolved), ADDRESS_MODE_ZERO_PAGE, 
+							ADDRESS_MODE_ABSOLUTE);
+					}
+				}
+			}
+
+			opcode = ADDRESS_MODE_OPCODE_VALUE(type, mode);
+			if(opcode == OPCODE_NONE) {
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_MODE, GENERATOR_PATH, 
+					tok.row(), tok.column(), "Command=%s, Mode=%s", KEYWORD_COMMAND_STRING(type), 
+					ADDRESS_MODE_STRING(mode));
+			}
+
+			if(m_peephole_enabled && !m_relocatable) {
+				m_peephole_command.push_back(std::make_tuple(m_peephole_boundary, mode, command, unresolved.empty(), type, 
+					value));
+				m_peephole_boundary = false;
+
+				peephole_iter = m_peephole.find(command);
+				if(peephole_iter != m_peephole.end()) {
+
+					cc65c::assembler::peephole_report_t &report = m_peephole_report[std::get<PEEPHOLE_REWRITE_PATTERN>(
+						peephole_iter->second)];
+					if(std::get<PEEPHOLE_REWRITE_SITE>(peephole_iter->second)) {
+						++std::get<PEEPHOLE_REPORT_COUNT>(report);
+					}
+
+					std::get<PEEPHOLE_REPORT_BYTE>(report) += ADDRESS_MODE_LENGTH_VALUE(mode);
+					std::get<PEEPHOLE_REPORT_CYCLE>(report) += cc65c::emulator::OPCODE[opcode][
+						cc65c::emulator::OPCODE_METADATA_CYCLE];
+
+					if(std::get<PEEPHOLE_REWRITE_COMMAND>(peephole_iter->second) == PEEPHOLE_DROP) {
+						TRACE_EXIT();
+						return;
+					}
+
+					type = std::get<PEEPHOLE_REWRITE_COMMAND>(peephole_iter->second);
+					mode = std::get<PEEPHOLE_REWRITE_MODE>(peephole_iter->second);
+					opcode = ADDRESS_MODE_OPCODE_VALUE(type, mode);
+					std::get<PEEPHOLE_REPORT_BYTE>(report) -= ADDRESS_MODE_LENGTH_VALUE(mode);
+					std::get<PEEPHOLE_REPORT_CYCLE>(report) -= cc65c::emulator::OPCODE[opcode][
+						cc65c::emulator::OPCODE_METADATA_CYCLE];
+				}
+			}
+
+			if((mode == ADDRESS_MODE_RELATIVE) && (m_relax.find(command) != m_relax.end())) {
+				enumerate_command_relax(tree, type, value, unresolved, target, unresolved_target, index_target, address);
+
+				TRACE_EXIT();
+				return;
+			}
+
+			emit(opcode);
+
+			switch(mode) {
+				case ADDRESS_MODE_ACCUMULATOR:
+				case ADDRESS_MODE_IMPLIED:
+				case ADDRESS_MODE_STACK:
+					break;
+				case ADDRESS_MODE_RELATIVE:
+
+					if(ADDRESS_MODE_RELATIVE_BIT_CONTAINS(type)) {
+						emit_value(value, FIXUP_ABSOLUTE_BYTE, unresolved, tree, 0, address);
+						emit_branch(target, unresolved_target, tree, index_target, address, command, type);
+					} else {
+						emit_branch(value, unresolved, tree, 0, address, command, type);
+					}
+					break;
+				default:
+
+					if(nested) {
+						tree.move_child_index(0);
+					}
+
+					emit_value(value, (ADDRESS_MODE_LENGTH_VALUE(mode) > 2) ? FIXUP_ABSOLUTE_WORD : FIXUP_ABSOLUTE_BYTE, 
+						unresolved, tree, 0, address);
+
+					if(nested) {
+						tree.move_parent();
+					}
+					break;
+			}
+
+			TRACE_EXIT();
+		}
+
+		uint32_t 
+		generator::enumerate_command_mode(
+			__in size_t command,
+			__in uint32_t type,
+			__in int32_t value,
+			__in const std::vector<size_t> &unresolved,
+			__in bool tracked,
+			__in uint32_t mode_zero_page,
+			__in uint32_t mode_absolute
+			)
+		{
+			uint32_t result = mode_absolute;
+
+			TRACE_ENTRY();
+
+			if(ADDRESS_MODE_OPCODE_VALUE(type, mode_zero_page) != OPCODE_NONE) {
+
+				if(ADDRESS_MODE_OPCODE_VALUE(type, mode_absolute) == OPCODE_NONE) {
+					result = mode_zero_page;
+				} else if(unresolved.empty() && (value >= 0) && (value <= UINT8_MAX)) {
+					result = mode_zero_page;
+				} else if(tracked) {
+					cc65c::assembler::block_t &entry = cc65c::assembler::generator::block();
+					m_shorten_fixup[m_fixup.size()] = m_shorten_candidate.size();
+					m_shorten_candidate.push_back(std::make_tuple(cc65c::assembler::generator::address(), 
+						m_segment[m_segment_current].size() - 1, command, m_fixup.size(), false, entry.second.size(), 
+						ADDRESS_MODE_OPCODE_VALUE(type, mode_zero_page), false, m_segment_current, 0));
+
+					if(!unresolved.empty() && (m_shorten.find(command) != m_shorten.end()) 
+							&& (m_shorten_pinned.find(command) == m_shorten_pinned.end())) {
+						result = mode_zero_page;
+					}
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x(%s)", result, ADDRESS_MODE_STRING(result));
+			return result;
+		}
+
+		void 
+		generator::enumerate_command_relax(
+			__inout cc65c::assembler::tree &tree,
+			__in uint32_t type,
+			__in int32_t value,
+			__in const std::vector<size_t> &unresolved,
+			__in int32_t target,
+			__in const std::vector<size_t> &unresolved_target,
+			__in size_t index_target,
+			__in uint16_t address
+			)
+		{
+			TRACE_ENTRY();
+
+			if(ADDRESS_MODE_RELATIVE_INVERSE_CONTAINS(type)) {
+				emit(ADDRESS_MODE_OPCODE_VALUE(ADDRESS_MODE_RELATIVE_INVERSE_VALUE(type), ADDRESS_MODE_RELATIVE));
+
+				if(ADDRESS_MODE_RELATIVE_BIT_CONTAINS(type)) {
+					emit_value(value, FIXUP_ABSOLUTE_BYTE, unresolved, tree, 0, address);
+				}
+
+				emit(ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ABSOLUTE));
+			}
+
+			emit(ADDRESS_MODE_OPCODE_VALUE(KEYWORD_COMMAND_JMP, ADDRESS_MODE_ABSOLUTE));
+
+			if(ADDRESS_MODE_RELATIVE_BIT_CONTAINS(type)) {
+				emit_value(target, FIXUP_ABSOLUTE_WORD, unresolved_target, tree, index_target, address);
+			} else {
+				emit_value(value, FIXUP_ABSOLUTE_WORD, unresolved, tree, 0, address);
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::enumerate_condition(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			bool active, taken = false;
+			size_t index = 0, position;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			if(tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_IF_DEFINE)) {
+				tree.move_child_index(index++);
+				taken = contains_symbol(tree.token().key());
+				tree.move_parent();
+			} else if(tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_IF)) {
+				taken = (enumerate_expression_resolved(tree, index) != 0);
+			} else {
+				THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_STATEMENT, GENERATOR_PATH, 
+					tok.row(), tok.column());
+			}
+
+			index = enumerate_statement_list(tree, index, taken);
+
+			for(; index < tree.node().size(); ++index) {
+				tree.move_child_index(index);
+
+				if(!taken) {
+					position = 0;
+
+					cc65c::assembler::token branch = tree.token();
+					if(branch.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE)) {
+						active = true;
+					} else if(branch.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE_IF)) {
+						active = (enumerate_expression_resolved(tree, position) != 0);
+					} else {
+						tree.move_child_index(position++);
+						active = contains_symbol(tree.token().key());
+						tree.move_parent();
+					}
+
+					enumerate_statement_list(tree, position, active);
+					taken = active;
+				}
+
+				tree.move_parent();
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::enumerate_define(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			bool literal;
+			std::string name;
+			uint16_t address;
+			int32_t count, value;
+			size_t index = 0, position;
+			std::vector<size_t> unresolved;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			switch(tok.subtype()) {
+				case KEYWORD_DEFINE_DATA_BYTE:
+				case KEYWORD_DEFINE_DATA_WORD:
+
+					while(index < tree.node().size()) {
+						tree.move_child_index(index);
+						cc65c::assembler::token child = tree.token();
+						literal = (child.match(TOKEN_LITERAL) && !tree.node().size());
+						tree.move_parent();
+
+						if(literal && tok.match(TOKEN_KEYWORD_DEFINE, KEYWORD_DEFINE_DATA_BYTE)
+								&& ((index + 1) < tree.node().size())) {
+							tree.move_child_index(index + 1);
+							literal = (!tree.token().match(TOKEN_SYMBOL_ARITHMETIC) 
+								&& !tree.token().match(TOKEN_OPERATOR_BINARY));
+							tree.move_parent();
+						}
+
+						if(literal && tok.match(TOKEN_KEYWORD_DEFINE, KEYWORD_DEFINE_DATA_BYTE)) {
+							std::string &key = child.key();
+
+							for(position = 0; position < key.size(); ++position) {
+								emit(key.at(position));
+							}
+
+							++index;
+						} else {
+							position = index;
+							address = cc65c::assembler::generator::address();
+							value = enumerate_expression(tree, index, origin(), address, unresolved);
+							emit_value(value, tok.match(TOKEN_KEYWORD_DEFINE, KEYWORD_DEFINE_DATA_BYTE) 
+								? FIXUP_ABSOLUTE_BYTE : FIXUP_ABSOLUTE_WORD, unresolved, tree, position, address);
+							unresolved.clear();
+						}
+					}
+					break;
+				case KEYWORD_DEFINE_DEFINE_BYTE:
+					tree.move_child_index(index++);
+					name = tree.token().key();
+					tree.move_parent();
+
+					if(contains_symbol(name)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_DUPLICATE_SYMBOL, 
+							GENERATOR_PATH, tok.row(), tok.column(), "Symbol=\"%s\"", STRING_CHECK(name));
+					}
+
+					define_symbol(name, TABLE_SYMBOL_DEFINE, enumerate_expression_resolved(tree, index));
+					break;
+				case KEYWORD_DEFINE_ORIGIN:
+					value = enumerate_expression_resolved(tree, index);
+
+					if((value < 0) || (value > UINT16_MAX)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_BOUNDS, 
+							GENERATOR_PATH, tok.row(), tok.column(), "Origin=%x", value);
+					}
+
+					if(!m_segment[m_segment_current].empty() && m_segment[m_segment_current].back().second.empty()) {
+						m_segment[m_segment_current].back().first = value;
+					} else {
+						m_segment[m_segment_current].push_back(cc65c::assembler::block_t(value, 
+							std::vector<uint8_t>()));
+					}
+					break;
+				case KEYWORD_DEFINE_RESERVE:
+					count = enumerate_expression_resolved(tree, index);
+					value = enumerate_expression_resolved(tree, index);
+
+					if((count < 0) || (value < INT8_MIN) || (value > UINT8_MAX)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, 
+							GENERATOR_PATH, tok.row(), tok.column(), "Count=%i, Value=%i", count, value);
+					}
+
+					for(; count > 0; --count) {
+						emit(value);
+					}
+					break;
+				case KEYWORD_DEFINE_SEGMENT:
+					tree.move_child_index(index);
+					m_segment_current = tree.token().key();
+					tree.move_parent();
+					break;
+				case KEYWORD_DEFINE_UNDEFINE:
+					tree.move_child_index(index);
+					name = tree.token().key();
+					tree.move_parent();
+
+					if(!m_table.contains(name, TABLE_SYMBOL_DEFINE)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SYMBOL, 
+							GENERATOR_PATH, tok.row(), tok.column(), "Symbol=\"%s\"", STRING_CHECK(name));
+					}
+
+					m_table.undefine(m_table.find(name));
+					m_relayout_safe = false;
+					break;
+				default:
+					THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_STATEMENT, GENERATOR_PATH, 
+						tok.row(), tok.column());
+			}
+
+			TRACE_EXIT();
+		}
+
+		int32_t 
+		generator::enumerate_expression(
+			__inout cc65c::assembler::tree &tree,
+			__inout size_t &index,
+			__in uint16_t origin,
+			__in uint16_t address,
+			__inout std::vector<size_t> &unresolved
+			)
+		{
+			int32_t result;
+			size_t position = index;
+			std::map<std::pair<cc65c::core::uuid_t, size_t>, size_t>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::pair<cc65c::core::uuid_t, size_t> key = std::make_pair(tree.node().id(), index);
+
+			iter = m_expression_index.find(key);
+			if(iter == m_expression_index.end()) {
+				cc65c::assembler::expression_program_t program;
+
+				if(!compile_expression(tree, position, [this](const std::string &name) {
+						return (int32_t) m_table.intern(name);
+						}, program)) {
+					cc65c::assembler::token tok = tree.token();
+					THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_EXPECTING_EXPRESSION, GENERATOR_PATH, 
+						tok.row(), tok.column());
+				}
+
+				iter = m_expression_index.insert(std::make_pair(key, m_expression.size())).first;
+				m_expression.push_back(program);
+			}
+
+			index = std::get<EXPRESSION_PROGRAM_END>(m_expression.at(iter->second));
+			result = enumerate_expression_evaluate(iter->second, origin, address, unresolved);
+
+			TRACE_EXIT_FORMAT("Result=%i", result);
+			return result;
+		}
+
+		int32_t 
+		generator::enumerate_expression_evaluate(
+			__in size_t program,
+			__in uint16_t origin,
+			__in uint16_t address,
+			__inout std::vector<size_t> &unresolved
+			)
+		{
+			size_t fault;
+			int32_t result = 0;
+
+			TRACE_ENTRY();
+
+			const cc65c::assembler::expression_program_t &entry = m_expression.at(program);
+
+			evaluate_expression(entry, [this, &unresolved, origin, address](
+					cc65c::assembler::expression_operation_t operation, int32_t operand, int32_t &value) {
+
+				switch(operation) {
+					case EXPRESSION_OPERATION_BASE:
+						value = origin;
+						break;
+					case EXPRESSION_OPERATION_POSITION:
+						value = address;
+						break;
+					default:
+
+						if(m_table.type(operand) == TABLE_SYMBOL_UNDEFINED) {
+
+							if(std::find(unresolved.begin(), unresolved.end(), (size_t) operand) == unresolved.end()) {
+								unresolved.push_back(operand);
+							}
+
+							return false;
+						}
+
+						value = m_table.value(operand);
+						break;
+				}
+
+				return true;
+			}, result, fault);
+
+			if((fault != EXPRESSION_FAULT_NONE) && unresolved.empty()) {
+				const cc65c::assembler::expression_instruction_t &instruction 
+					= std::get<EXPRESSION_PROGRAM_INSTRUCTION>(entry).at(fault);
+
+				if(std::get<EXPRESSION_INSTRUCTION_OPERATION>(instruction) == EXPRESSION_OPERATION_LITERAL) {
+					THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, GENERATOR_PATH, 
+						std::get<EXPRESSION_INSTRUCTION_ROW>(instruction), 
+						std::get<EXPRESSION_INSTRUCTION_COLUMN>(instruction));
+				}
+
+				THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_DIVIDE_BY_ZERO, GENERATOR_PATH, 
+					std::get<EXPRESSION_INSTRUCTION_ROW>(instruction), 
+					std::get<EXPRESSION_INSTRUCTION_COLUMN>(instruction));
+			}
+
+			TRACE_EXIT_FORMAT("Result=%i", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_expression_position(
+			__in size_t program
+			)
+		{
+			bool result = false;
+			std::vector<cc65c::assembler::expression_instruction_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			const std::vector<cc65c::assembler::expression_instruction_t> &code 
+				= std::get<EXPRESSION_PROGRAM_INSTRUCTION>(m_expression.at(program));
+
+			for(iter = code.begin(); !result && (iter != code.end()); ++iter) {
+
+				switch(std::get<EXPRESSION_INSTRUCTION_OPERATION>(*iter)) {
+					case EXPRESSION_OPERATION_IDENTIFIER:
+						result = (m_table.type(std::get<EXPRESSION_INSTRUCTION_OPERAND>(*iter)) == TABLE_SYMBOL_LABEL);
+						break;
+					case EXPRESSION_OPERATION_POSITION:
+						result = true;
+						break;
+					default:
+						break;
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		int32_t 
+		generator::enumerate_expression_resolved(
+			__inout cc65c::assembler::tree &tree,
+			__inout size_t &index
+			)
+		{
+			int32_t result;
+			size_t position = index;
+			std::vector<size_t> unresolved;
+
+			TRACE_ENTRY();
+
+			result = enumerate_expression(tree, index, origin(), address(), unresolved);
+			if(!unresolved.empty()) {
+				cc65c::assembler::token tok = tree.token();
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SYMBOL, 
+					GENERATOR_PATH, tok.row(), tok.column(), "Symbol=\"%s\"", 
+					STRING_CHECK(m_table.name(unresolved.front())));
+			}
+
+			if(enumerate_expression_position(m_expression_index.at(std::make_pair(tree.node().id(), position)))) {
+				m_relayout_safe = false;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%i", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_expression_tracked(
+			__inout cc65c::assembler::tree &tree,
+			__in size_t index,
+			__in const std::vector<size_t> &unresolved
+			)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			result = (!unresolved.empty() || (!m_relocatable && enumerate_expression_position(
+				m_expression_index.at(std::make_pair(tree.node().id(), index)))));
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		generator::enumerate_include(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			std::string path;
+			std::vector<cc65c::assembler::tree>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			tree.move_child_index(0);
+			path = tree.token().key();
+			tree.move_parent();
+			m_dependency.insert(path);
+
+			switch(tok.subtype()) {
+				case KEYWORD_INCLUDE_BINARY:
+					enumerate_include_binary(tree, path);
+					break;
+				case KEYWORD_INCLUDE_HEX:
+					enumerate_include_hex(tree, path);
+					break;
+				case KEYWORD_INCLUDE_SOURCE: {
+
+						if((path == cc65c::assembler::stream::path()) 
+								|| (std::find(m_include.begin(), m_include.end(), path) != m_include.end())) {
+							THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_INCLUDE, 
+								GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\"", path.size(), 
+								STRING_CHECK(path));
+						}
+
+						const std::vector<cc65c::assembler::tree> &input = cc65c::assembler::cache::acquire().parse(path);
+						m_include.push_back(path);
+
+						for(iter = input.begin(); iter != input.end(); ++iter) {
+							cc65c::assembler::tree entry(*iter);
+							entry.move_root();
+							enumerate_statement(entry);
+						}
+
+						m_include.pop_back();
+					} break;
+				default:
+					THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_STATEMENT, GENERATOR_PATH, 
+						tok.row(), tok.column());
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::enumerate_include_binary(
+			__inout cc65c::assembler::tree &tree,
+			__in const std::string &path
+			)
+		{
+			int file;
+			int32_t value;
+			void *data = MAP_FAILED;
+			struct stat status;
+			bool sliced = false;
+			size_t base, index = 1, length = 0, offset = 0;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+
+			if(index < tree.node().size()) {
+				value = enumerate_expression_resolved(tree, index);
+				if(value < 0) {
+					THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, 
+						GENERATOR_PATH, tok.row(), tok.column(), "Offset=%i", value);
+				}
+
+				offset = value;
+			}
+
+			if(index < tree.node().size()) {
+				value = enumerate_expression_resolved(tree, index);
+				if(value < 0) {
+					THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, 
+						GENERATOR_PATH, tok.row(), tok.column(), "Length=%i", value);
+				}
+
+				length = value;
+				sliced = true;
+			}
+
+			file = open(path.c_str(), O_RDONLY);
+			if((file < 0) || fstat(file, &status)) {
+
+				if(file >= 0) {
+					close(file);
+				}
+
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FILE_NOT_FOUND, 
+					GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\"", path.size(), STRING_CHECK(path));
+			}
+
+			if(!sliced && (offset <= (size_t) status.st_size)) {
+				length = (status.st_size - offset);
+			}
+
+			if((offset + length) > (size_t) status.st_size) {
+				close(file);
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, 
+					GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\", Offset=%u, Length=%u, Size=%u", 
+					path.size(), STRING_CHECK(path), offset, length, (size_t) status.st_size);
+			}
+
+			base = (offset - (offset % sysconf(_SC_PAGESIZE)));
+
+			if(length) {
+				data = mmap(nullptr, (offset - base) + length, PROT_READ, MAP_PRIVATE, file, base);
+			}
+
+			close(file);
+
+			if(length) {
+
+				if(data == MAP_FAILED) {
+					THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FILE_NOT_FOUND, 
+						GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\"", path.size(), STRING_CHECK(path));
+				}
+
+				madvise(data, (offset - base) + length, MADV_SEQUENTIAL);
+
+				try {
+					emit(((const uint8_t *) data) + (offset - base), length);
+				} catch(...) {
+					munmap(data, (offset - base) + length);
+					throw;
+				}
+
+				munmap(data, (offset - base) + length);
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::enumerate_include_hex(
+			__inout cc65c::assembler::tree &tree,
+			__in const std::string &path
+			)
+		{
+			int file;
+			size_t length;
+			uint8_t byte = 0;
+			int8_t high, low;
+			void *data = MAP_FAILED;
+			struct stat status;
+			size_t count = 0, decoded, index = 0, invalid, position, resume = 0;
+			const uint8_t *input;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+
+			file = open(path.c_str(), O_RDONLY);
+			if((file < 0) || fstat(file, &status)) {
+
+				if(file >= 0) {
+					close(file);
+				}
+
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FILE_NOT_FOUND, 
+					GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\"", path.size(), STRING_CHECK(path));
+			}
+
+			length = status.st_size;
+			if(length) {
+				data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+			}
+
+			close(file);
+
+			if(length) {
+
+				if(data == MAP_FAILED) {
+					THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FILE_NOT_FOUND, 
+						GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\"", path.size(), STRING_CHECK(path));
+				}
+
+				input = (const uint8_t *) data;
+				std::vector<uint8_t> &output = block().second;
+				position = output.size();
+				output.resize(position + (length / 2));
+
+				while(index < length) {
+
+					if(!count && (index >= resume)) {
+						decoded = enumerate_include_hex_vector(input + index, length - index, output.data() + position, 
+							invalid);
+						resume = (index + invalid + 1);
+						position += (decoded / 2);
+						index += decoded;
+
+						if(index >= length) {
+							break;
+						}
+					}
+
+					high = HEX_VALUE[input[index]];
+
+					if((index + 1) < length) {
+						low = HEX_VALUE[input[index + 1]];
+
+						if(!count && ((high | low) >= 0)) {
+							output[position++] = ((high << 4) | low);
+							index += 2;
+							continue;
+						}
+					}
+
+					if(high == HEX_SPACE) {
+						++index;
+						continue;
+					} else if(high == HEX_INVALID) {
+						break;
+					}
+
+					byte = ((byte << 4) | high);
+					if(++count == 2) {
+						output[position++] = byte;
+						byte = 0;
+						count = 0;
+					}
+
+					++index;
+				}
+
+				munmap(data, length);
+				output.resize(position);
+
+				if((index < length) || count) {
+					THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_MALFORMED_HEXIDECIMAL, 
+						GENERATOR_PATH, tok.row(), tok.column(), "Path[%u]=\"%s\", Offset=%u", path.size(), 
+						STRING_CHECK(path), index);
+				}
+
+				if((block().first + output.size()) > (UINT16_MAX + 1)) {
+					THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_BOUNDS,
+						"Segment=%s, Address=%x", STRING_CHECK(m_segment_current), block().first + output.size());
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		generator::enumerate_include_hex_vector(
+			__in const uint8_t *input,
+			__in size_t length,
+			__inout uint8_t *output,
+			__inout size_t &invalid
+			)
+		{
+			size_t result = 0;
+#ifdef HEX_VECTOR_WIDTH
+			uint32_t mask;
+			size_t index;
+			hex_vector_t digit, letter, lower, value[2];
+#endif // HEX_VECTOR_WIDTH
+
+			TRACE_ENTRY();
+
+			invalid = length;
+
+#ifdef HEX_VECTOR_WIDTH
+			while((invalid == length) && ((result + (HEX_VECTOR_WIDTH * 2)) <= length)) {
+
+				for(index = 0; index < 2; ++index) {
+					value[index] = HEX_VECTOR_LOAD(input + result + (index * HEX_VECTOR_WIDTH));
+					lower = HEX_VECTOR_OR(value[index], HEX_VECTOR_BYTE(0x20));
+					digit = HEX_VECTOR_AND(HEX_VECTOR_GREATER(value[index], HEX_VECTOR_BYTE('0' - 1)), 
+						HEX_VECTOR_GREATER(HEX_VECTOR_BYTE('9' + 1), value[index]));
+					letter = HEX_VECTOR_AND(HEX_VECTOR_GREATER(lower, HEX_VECTOR_BYTE('a' - 1)), 
+						HEX_VECTOR_GREATER(HEX_VECTOR_BYTE('f' + 1), lower));
+
+					mask = HEX_VECTOR_MASK(HEX_VECTOR_OR(digit, letter));
+					if(mask != HEX_VECTOR_MASK_FULL) {
+						invalid = (result + (index * HEX_VECTOR_WIDTH) + __builtin_ctz(~mask));
+						break;
+					}
+
+					value[index] = HEX_VECTOR_OR(HEX_VECTOR_AND(digit, HEX_VECTOR_SUBTRACT(value[index], 
+						HEX_VECTOR_BYTE('0'))), HEX_VECTOR_AND(letter, HEX_VECTOR_SUBTRACT(lower, 
+						HEX_VECTOR_BYTE('a' - 10))));
+					value[index] = HEX_VECTOR_OR(HEX_VECTOR_SHIFT_LEFT(HEX_VECTOR_AND(value[index], 
+						HEX_VECTOR_WORD(UINT8_MAX)), 4), HEX_VECTOR_SHIFT_RIGHT(value[index], 8));
+				}
+
+				if(invalid == length) {
+					HEX_VECTOR_STORE(output + (result / 2), HEX_VECTOR_PACK(value[0], value[1]));
+					result += (HEX_VECTOR_WIDTH * 2);
+				}
+			}
+#endif // HEX_VECTOR_WIDTH
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		size_t 
+		generator::enumerate_input(
+			__in bool relocatable
+			)
+		{
+			size_t fixup, index, result;
+			std::map<std::string, int32_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			reset_generator();
+			cc65c::assembler::parser::reset();
+			cc65c::assembler::parser::set_condition(m_define);
+			m_relocatable = relocatable;
+
+			for(iter = m_define.begin(); iter != m_define.end(); ++iter) {
+				define_symbol(iter->first, TABLE_SYMBOL_DEFINE, iter->second);
+			}
+
+			while(cc65c::assembler::parser::has_next()) {
+
+				cc65c::assembler::tree &entry = cc65c::assembler::parser::move_next();
+				if(entry.match(TREE_STATEMENT)) {
+					entry.move_root();
+					enumerate_statement(entry);
+				}
+			}
+
+			cc65c::assembler::parser::reset();
+
+			if(!relocatable && m_table.has_pending(index, fixup)) {
+				cc65c::assembler::fixup_metadata_t &entry = m_fixup.at(fixup);
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SYMBOL,
+					std::get<FIXUP_METADATA_PATH>(entry), std::get<FIXUP_METADATA_ROW>(entry), 
+					std::get<FIXUP_METADATA_COLUMN>(entry), "Symbol=\"%s\"", STRING_CHECK(m_table.name(index)));
+			}
+
+			result = size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		generator::enumerate_label(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			if(contains_symbol(tok.key())) {
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_DUPLICATE_SYMBOL, GENERATOR_PATH, 
+					tok.row(), tok.column(), "Symbol=\"%s\"", STRING_CHECK(tok.key()));
+			}
+
+			define_symbol(tok.key(), TABLE_SYMBOL_LABEL, address());
+
+			std::vector<cc65c::assembler::block_t> &entry = m_segment[m_segment_current];
+			m_label.push_back(std::make_tuple(entry.empty() ? 0 : (entry.size() - 1), m_table.find(tok.key()), 
+				entry.empty() ? 0 : entry.back().second.size(), m_segment_current));
+
+			TRACE_EXIT();
+		}
+
+		cc65c::assembler::object 
+		generator::enumerate_object(void)
+		{
+			int32_t addend;
+			std::string name;
+			size_t fixup, index;
+			cc65c::assembler::table_symbol_t type;
+			std::map<std::string, size_t> import;
+			std::map<std::string, size_t>::iterator iter;
+			std::vector<cc65c::assembler::object_symbol_t> symbol;
+			std::vector<cc65c::assembler::object_relocation_t> relocation;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			m_expression.clear();
+			m_expression_index.clear();
+			m_table.clear();
+			m_pass = 1;
+			m_peephole.clear();
+			m_relax.clear();
+			m_shorten.clear();
+			m_shorten_pinned.clear();
+			enumerate_input(true);
+
+			for(index = 0; index < m_table.size(); ++index) {
+
+				type = m_table.type(index);
+				if(type != TABLE_SYMBOL_UNDEFINED) {
+					symbol.push_back(std::make_tuple(m_table.name(index), type, m_table.value(index)));
+				}
+			}
+
+			for(fixup = 0; fixup < m_fixup.size(); ++fixup) {
+
+				cc65c::assembler::fixup_metadata_t &entry = m_fixup.at(fixup);
+				if(!std::get<FIXUP_METADATA_PENDING>(entry)) {
+					continue;
+				}
+
+				if(!enumerate_relocation(fixup, name, addend)) {
+					THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNSUPPORTED_RELOCATION, 
+						std::get<FIXUP_METADATA_PATH>(entry), std::get<FIXUP_METADATA_ROW>(entry), 
+						std::get<FIXUP_METADATA_COLUMN>(entry));
+				}
+
+				iter = import.find(name);
+				if(iter == import.end()) {
+					iter = import.insert(std::make_pair(name, symbol.size())).first;
+					symbol.push_back(std::make_tuple(name, TABLE_SYMBOL_UNDEFINED, 0));
+				}
+
+				relocation.push_back(std::make_tuple(addend, std::get<FIXUP_METADATA_BLOCK>(entry), 
+					std::get<FIXUP_METADATA_COLUMN>(entry), std::get<FIXUP_METADATA_OFFSET>(entry), 
+					std::get<FIXUP_METADATA_ROW>(entry), std::get<FIXUP_METADATA_SEGMENT>(entry), iter->second, 
+					std::get<FIXUP_METADATA_TYPE>(entry)));
+			}
+
+			cc65c::assembler::object result(cc65c::assembler::stream::path(), m_segment, symbol, relocation);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		bool 
+		generator::enumerate_peephole(void)
+		{
+			uint8_t flags;
+			uint32_t type;
+			bool decimal = false, matched, result;
+			size_t index, pattern;
+			std::vector<cc65c::assembler::peephole_command_t>::const_iterator iter;
+			std::map<size_t, cc65c::assembler::peephole_rewrite_t> rewrite;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_RESOLVE);
+
+			for(iter = m_peephole_command.begin(); iter != m_peephole_command.end(); ++iter) {
+
+				type = std::get<PEEPHOLE_COMMAND_TYPE>(*iter);
+				if((type != KEYWORD_COMMAND_CLD) && PEEPHOLE_FLAG_CONTAINS(type) 
+						&& (PEEPHOLE_FLAG_WRITE(type) & PEEPHOLE_FLAG_DECIMAL)) {
+					decimal = true;
+					break;
+				}
+			}
+
+			for(index = 0; (index + 1) < m_peephole_command.size(); ++index) {
+
+				const cc65c::assembler::peephole_command_t &first = m_peephole_command.at(index);
+				const cc65c::assembler::peephole_command_t &second = m_peephole_command.at(index + 1);
+				if(std::get<PEEPHOLE_COMMAND_BOUNDARY>(second)) {
+					continue;
+				}
+
+				for(pattern = 0; pattern <= PEEPHOLE_PATTERN_MAX; ++pattern) {
+
+					const uint32_t *entry = PEEPHOLE_PATTERN[pattern];
+					flags = entry[PEEPHOLE_METADATA_FLAG];
+
+					if((std::get<PEEPHOLE_COMMAND_TYPE>(first) != entry[PEEPHOLE_METADATA_FIRST_COMMAND])
+							|| (std::get<PEEPHOLE_COMMAND_TYPE>(second) != entry[PEEPHOLE_METADATA_SECOND_COMMAND])
+							|| ((entry[PEEPHOLE_METADATA_FIRST_MODE] != PEEPHOLE_MODE_ANY) 
+								&& (std::get<PEEPHOLE_COMMAND_MODE>(first) != entry[PEEPHOLE_METADATA_FIRST_MODE]))
+							|| ((entry[PEEPHOLE_METADATA_SECOND_MODE] != PEEPHOLE_MODE_ANY) 
+								&& (std::get<PEEPHOLE_COMMAND_MODE>(second) != entry[PEEPHOLE_METADATA_SECOND_MODE]))
+							|| (decimal && (flags & PEEPHOLE_FLAG_DECIMAL))) {
+						continue;
+					}
+
+					switch(entry[PEEPHOLE_METADATA_OPERAND]) {
+						case PEEPHOLE_OPERAND_ONE:
+							matched = (std::get<PEEPHOLE_COMMAND_RESOLVED>(second) 
+								&& (std::get<PEEPHOLE_COMMAND_VALUE>(second) == 1));
+							break;
+						case PEEPHOLE_OPERAND_SAME:
+							matched = (std::get<PEEPHOLE_COMMAND_RESOLVED>(first) 
+								&& std::get<PEEPHOLE_COMMAND_RESOLVED>(second)
+								&& (std::get<PEEPHOLE_COMMAND_MODE>(first) == std::get<PEEPHOLE_COMMAND_MODE>(second))
+								&& (std::get<PEEPHOLE_COMMAND_VALUE>(first) == std::get<PEEPHOLE_COMMAND_VALUE>(second)));
+							break;
+						default:
+							matched = true;
+							break;
+					}
+
+					if(!matched || !enumerate_peephole_dead(index + 2, flags & ~PEEPHOLE_FLAG_DECIMAL)) {
+						continue;
+					}
+
+					if(entry[PEEPHOLE_METADATA_FIRST_REPLACE_COMMAND] != PEEPHOLE_KEEP) {
+						rewrite[std::get<PEEPHOLE_COMMAND_ORDINAL>(first)] = std::make_tuple(
+							entry[PEEPHOLE_METADATA_FIRST_REPLACE_COMMAND], entry[PEEPHOLE_METADATA_FIRST_REPLACE_MODE], 
+							pattern, true);
+					}
+
+					if(entry[PEEPHOLE_METADATA_SECOND_REPLACE_COMMAND] != PEEPHOLE_KEEP) {
+						rewrite[std::get<PEEPHOLE_COMMAND_ORDINAL>(second)] = std::make_tuple(
+							entry[PEEPHOLE_METADATA_SECOND_REPLACE_COMMAND], entry[PEEPHOLE_METADATA_SECOND_REPLACE_MODE], 
+							pattern, entry[PEEPHOLE_METADATA_FIRST_REPLACE_COMMAND] == PEEPHOLE_KEEP);
+					}
+
+					++index;
+					break;
+				}
+			}
+
+			result = (rewrite != m_peephole);
+			if(result) {
+				m_peephole = rewrite;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_peephole_dead(
+			__in size_t index,
+			__in uint8_t flags
+			)
+		{
+			uint32_t type;
+			bool result = !flags;
+
+			TRACE_ENTRY();
+
+			for(; !result && (index < m_peephole_command.size()); ++index) {
+
+				const cc65c::assembler::peephole_command_t &entry = m_peephole_command.at(index);
+				type = std::get<PEEPHOLE_COMMAND_TYPE>(entry);
+
+				if(std::get<PEEPHOLE_COMMAND_BOUNDARY>(entry) || !PEEPHOLE_FLAG_CONTAINS(type) 
+						|| (PEEPHOLE_FLAG_READ(type) & flags)) {
+					break;
+				}
+
+				flags &= ~PEEPHOLE_FLAG_WRITE(type);
+				result = !flags;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_relax(void)
+		{
+			bool found, result = false;
+			int32_t displacement, origin, target;
+			std::vector<std::pair<uint16_t, size_t>>::const_iterator shift_iter;
+			std::vector<cc65c::assembler::relax_branch_t>::const_iterator iter;
+			std::map<std::pair<std::string, size_t>, std::vector<std::pair<uint16_t, size_t>>> shift;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_RESOLVE);
+
+			do {
+				found = false;
+
+				for(iter = m_relax_branch.begin(); iter != m_relax_branch.end(); ++iter) {
+
+					if(!std::get<RELAX_BRANCH_RESOLVED>(*iter) 
+							|| (m_relax.find(std::get<RELAX_BRANCH_COMMAND>(*iter)) != m_relax.end())) {
+						continue;
+					}
+
+					const cc65c::assembler::block_t &block = m_segment[std::get<RELAX_BRANCH_SEGMENT>(*iter)].at(
+						std::get<RELAX_BRANCH_BLOCK>(*iter));
+					std::vector<std::pair<uint16_t, size_t>> &entry = shift[std::make_pair(
+						std::get<RELAX_BRANCH_SEGMENT>(*iter), std::get<RELAX_BRANCH_BLOCK>(*iter))];
+
+					origin = std::get<RELAX_BRANCH_ADDRESS>(*iter);
+					target = std::get<RELAX_BRANCH_TARGET>(*iter);
+
+					for(shift_iter = entry.begin(); shift_iter != entry.end(); ++shift_iter) {
+
+						if(shift_iter->first < std::get<RELAX_BRANCH_ADDRESS>(*iter)) {
+							origin += shift_iter->second;
+						}
+
+						if((target >= block.first) && (target <= (int32_t) (block.first + block.second.size()))
+								&& (shift_iter->first < std::get<RELAX_BRANCH_TARGET>(*iter))) {
+							target += shift_iter->second;
+						}
+					}
+
+					displacement = (target - (origin + (int32_t) std::get<RELAX_BRANCH_LENGTH>(*iter)));
+					if((displacement < INT8_MIN) || (displacement > INT8_MAX)) {
+						m_relax.insert(std::get<RELAX_BRANCH_COMMAND>(*iter));
+						entry.push_back(std::make_pair(std::get<RELAX_BRANCH_ADDRESS>(*iter), 
+							std::get<RELAX_BRANCH_GROWTH>(*iter)));
+						found = true;
+						result = true;
+					}
+				}
+			} while(found);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_relayout(void)
+		{
+			size_t index, offset, pinned;
+			bool result = (m_relayout_safe && !m_peephole_enabled);
+			std::map<size_t, size_t>::iterator fixup_iter;
+			std::vector<cc65c::assembler::shorten_candidate_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_RESOLVE);
+
+			for(fixup_iter = m_relax_fixup.begin(); result && (fixup_iter != m_relax_fixup.end());) {
+
+				const cc65c::assembler::relax_branch_t &branch = m_relax_branch.at(fixup_iter->second);
+				if(m_relax.find(std::get<RELAX_BRANCH_COMMAND>(branch)) == m_relax.end()) {
+					++fixup_iter;
+					continue;
+				}
+
+				offset = (std::get<RELAX_BRANCH_OFFSET>(branch) + std::get<RELAX_BRANCH_LENGTH>(branch));
+				result = enumerate_relayout_shift(std::get<RELAX_BRANCH_SEGMENT>(branch), 
+					std::get<RELAX_BRANCH_BLOCK>(branch), offset, std::get<RELAX_BRANCH_GROWTH>(branch));
+				if(result) {
+					cc65c::assembler::fixup_metadata_t &entry = m_fixup.at(fixup_iter->first);
+					std::vector<uint8_t> &block = m_segment[std::get<RELAX_BRANCH_SEGMENT>(branch)].at(
+						std::get<RELAX_BRANCH_BLOCK>(branch)).second;
+
+					block.insert(block.begin() + offset, std::get<RELAX_BRANCH_GROWTH>(branch), 0);
+
+					if(ADDRESS_MODE_RELATIVE_INVERSE_CONTAINS(std::get<RELAX_BRANCH_TYPE>(branch))) {
+						block.at(std::get<RELAX_BRANCH_OFFSET>(branch)) = ADDRESS_MODE_OPCODE_VALUE(
+							ADDRESS_MODE_RELATIVE_INVERSE_VALUE(std::get<RELAX_BRANCH_TYPE>(branch)), ADDRESS_MODE_RELATIVE);
+						block.at(offset - 1) = ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ABSOLUTE);
+						block.at(offset) = ADDRESS_MODE_OPCODE_VALUE(KEYWORD_COMMAND_JMP, ADDRESS_MODE_ABSOLUTE);
+						std::get<FIXUP_METADATA_OFFSET>(entry) = (offset + 1);
+					} else {
+						block.at(std::get<RELAX_BRANCH_OFFSET>(branch)) = ADDRESS_MODE_OPCODE_VALUE(KEYWORD_COMMAND_JMP, 
+							ADDRESS_MODE_ABSOLUTE);
+					}
+
+					std::get<FIXUP_METADATA_TYPE>(entry) = FIXUP_ABSOLUTE_WORD;
+				}
+
+				fixup_iter = m_relax_fixup.erase(fixup_iter);
+			}
+
+			for(iter = m_shorten_candidate.begin(); result && (iter != m_shorten_candidate.end()); ++iter) {
+
+				cc65c::assembler::fixup_metadata_t &entry = m_fixup.at(std::get<SHORTEN_CANDIDATE_FIXUP>(*iter));
+				if((std::get<FIXUP_METADATA_TYPE>(entry) != FIXUP_ABSOLUTE_WORD)
+						|| (m_shorten.find(std::get<SHORTEN_CANDIDATE_COMMAND>(*iter)) == m_shorten.end())
+						|| (m_shorten_pinned.find(std::get<SHORTEN_CANDIDATE_COMMAND>(*iter)) 
+							!= m_shorten_pinned.end())) {
+					continue;
+				}
+
+				offset = std::get<SHORTEN_CANDIDATE_OFFSET>(*iter);
+				result = enumerate_relayout_shift(std::get<SHORTEN_CANDIDATE_SEGMENT>(*iter), 
+					std::get<SHORTEN_CANDIDATE_BLOCK>(*iter), offset + ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ABSOLUTE), 
+					-((int32_t) GENERATOR_SHORTEN_LENGTH));
+				if(result) {
+					std::vector<uint8_t> &block = m_segment[std::get<SHORTEN_CANDIDATE_SEGMENT>(*iter)].at(
+						std::get<SHORTEN_CANDIDATE_BLOCK>(*iter)).second;
+
+					block.at(offset) = std::get<SHORTEN_CANDIDATE_OPCODE>(*iter);
+					block.erase(block.begin() + offset + ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ZERO_PAGE), 
+						block.begin() + offset + ADDRESS_MODE_LENGTH_VALUE(ADDRESS_MODE_ABSOLUTE));
+					std::get<FIXUP_METADATA_TYPE>(entry) = FIXUP_ABSOLUTE_BYTE;
+				}
+			}
+
+			pinned = m_shorten_pinned.size();
+
+			try {
+
+				for(index = 0; result && (index < m_fixup.size()); ++index) {
+
+					if(!std::get<FIXUP_METADATA_PENDING>(m_fixup.at(index))) {
+						patch(index);
+					}
+				}
+			} catch(cc65c::core::exception &exc) {
+				result = false;
+			}
+
+			result = (result && (pinned == m_shorten_pinned.size()));
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_relayout_shift(
+			__in const std::string &segment,
+			__in size_t block,
+			__in size_t offset,
+			__in int32_t delta
+			)
+		{
+			bool result;
+			std::vector<size_t> resolved;
+			std::vector<cc65c::assembler::label_metadata_t>::iterator label_iter;
+			std::vector<cc65c::assembler::fixup_metadata_t>::iterator fixup_iter;
+			std::vector<cc65c::assembler::listing_metadata_t>::iterator listing_iter;
+			std::vector<cc65c::assembler::relax_branch_t>::iterator relax_iter;
+			std::vector<cc65c::assembler::shorten_candidate_t>::iterator shorten_iter;
+
+			TRACE_ENTRY();
+
+			const cc65c::assembler::block_t &entry = m_segment[segment].at(block);
+			result = ((int32_t) (entry.first + entry.second.size() + delta) <= (UINT16_MAX + 1));
+			if(result) {
+
+				for(fixup_iter = m_fixup.begin(); fixup_iter != m_fixup.end(); ++fixup_iter) {
+
+					if((std::get<FIXUP_METADATA_BLOCK>(*fixup_iter) == block) 
+							&& (std::get<FIXUP_METADATA_OFFSET>(*fixup_iter) >= offset)
+							&& (std::get<FIXUP_METADATA_SEGMENT>(*fixup_iter) == segment)) {
+						std::get<FIXUP_METADATA_ADDRESS>(*fixup_iter) += delta;
+						std::get<FIXUP_METADATA_OFFSET>(*fixup_iter) += delta;
+					}
+				}
+
+				for(label_iter = m_label.begin(); label_iter != m_label.end(); ++label_iter) {
+
+					if((std::get<LABEL_METADATA_BLOCK>(*label_iter) == block) 
+							&& (std::get<LABEL_METADATA_OFFSET>(*label_iter) >= offset)
+							&& (std::get<LABEL_METADATA_SEGMENT>(*label_iter) == segment)) {
+						std::get<LABEL_METADATA_OFFSET>(*label_iter) += delta;
+						m_table.define(std::get<LABEL_METADATA_INDEX>(*label_iter), TABLE_SYMBOL_LABEL, 
+							m_table.value(std::get<LABEL_METADATA_INDEX>(*label_iter)) + delta, resolved);
+					}
+				}
+
+				for(listing_iter = m_listing.begin(); listing_iter != m_listing.end(); ++listing_iter) {
+
+					if((std::get<LISTING_METADATA_BLOCK>(*listing_iter) != block)
+							|| (std::get<LISTING_METADATA_SEGMENT>(*listing_iter) != segment)) {
+						continue;
+					}
+
+					if(std::get<LISTING_METADATA_OFFSET>(*listing_iter) >= offset) {
+						std::get<LISTING_METADATA_OFFSET>(*listing_iter) += delta;
+					} else if((std::get<LISTING_METADATA_OFFSET>(*listing_iter) 
+							+ std::get<LISTING_METADATA_LENGTH>(*listing_iter)) >= offset) {
+						std::get<LISTING_METADATA_LENGTH>(*listing_iter) += delta;
+					}
+				}
+
+				for(relax_iter = m_relax_branch.begin(); relax_iter != m_relax_branch.end(); ++relax_iter) {
+
+					if((std::get<RELAX_BRANCH_BLOCK>(*relax_iter) == block) 
+							&& (std::get<RELAX_BRANCH_OFFSET>(*relax_iter) >= offset)
+							&& (std::get<RELAX_BRANCH_SEGMENT>(*relax_iter) == segment)) {
+						std::get<RELAX_BRANCH_ADDRESS>(*relax_iter) += delta;
+						std::get<RELAX_BRANCH_OFFSET>(*relax_iter) += delta;
+					}
+				}
+
+				for(shorten_iter = m_shorten_candidate.begin(); shorten_iter != m_shorten_candidate.end(); 
+						++shorten_iter) {
+
+					if((std::get<SHORTEN_CANDIDATE_BLOCK>(*shorten_iter) == block) 
+							&& (std::get<SHORTEN_CANDIDATE_OFFSET>(*shorten_iter) >= offset)
+							&& (std::get<SHORTEN_CANDIDATE_SEGMENT>(*shorten_iter) == segment)) {
+						std::get<SHORTEN_CANDIDATE_ADDRESS>(*shorten_iter) += delta;
+						std::get<SHORTEN_CANDIDATE_OFFSET>(*shorten_iter) += delta;
+					}
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_relocation(
+			__in size_t index,
+			__inout std::string &symbol,
+			__inout int32_t &addend
+			)
+		{
+			size_t position;
+			bool result = true;
+			std::vector<size_t> unresolved;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::fixup_metadata_t &entry = m_fixup.at(index);
+			cc65c::assembler::tree &tree = m_fixup_tree.at(std::get<FIXUP_METADATA_TREE>(entry));
+			tree.move_child(std::get<FIXUP_METADATA_NODE>(entry));
+			position = std::get<FIXUP_METADATA_INDEX>(entry);
+
+			tree.move_child_index(position);
+			result = (tree.token().match(TOKEN_IDENTIFIER) && !tree.node().size());
+			symbol = tree.token().key();
+			tree.move_parent();
+
+			for(++position; result && (position < tree.node().size()); ++position) {
+				tree.move_child_index(position);
+
+				cc65c::assembler::token tok = tree.token();
+				if(!tok.match(TOKEN_SYMBOL_ARITHMETIC) && !tok.match(TOKEN_OPERATOR_BINARY)) {
+					tree.move_parent();
+					break;
+				}
+
+				result = (tok.match(TOKEN_SYMBOL_ARITHMETIC, SYMBOL_ARITHMETIC_ADDITION) 
+					|| tok.match(TOKEN_SYMBOL_ARITHMETIC, SYMBOL_ARITHMETIC_SUBTRACTION));
+				tree.move_parent();
+			}
+
+			if(result) {
+				addend = enumerate_expression_evaluate(std::get<FIXUP_METADATA_PROGRAM>(entry), 
+					m_segment[std::get<FIXUP_METADATA_SEGMENT>(entry)].at(std::get<FIXUP_METADATA_BLOCK>(entry)).first, 
+					std::get<FIXUP_METADATA_ADDRESS>(entry), unresolved);
+				result = ((unresolved.size() == 1) && (unresolved.front() == m_table.find(symbol)));
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		generator::enumerate_shorten(
+			__in bool frozen
+			)
+		{
+			bool found, result;
+			int32_t target;
+			std::set<size_t> shorten;
+			std::set<size_t>::const_iterator command_iter;
+			std::vector<std::pair<uint16_t, size_t>>::const_iterator shift_iter;
+			std::vector<cc65c::assembler::shorten_candidate_t>::const_iterator iter;
+			std::map<std::pair<std::string, size_t>, std::vector<std::pair<uint16_t, size_t>>> shift;
+			std::map<std::pair<std::string, size_t>, std::vector<std::pair<uint16_t, size_t>>>::const_iterator 
+				block_iter;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_RESOLVE);
+
+			for(command_iter = m_shorten.begin(); command_iter != m_shorten.end(); ++command_iter) {
+
+				if(m_shorten_pinned.find(*command_iter) == m_shorten_pinned.end()) {
+					shorten.insert(*command_iter);
+				}
+			}
+
+			do {
+				found = false;
+
+				for(iter = m_shorten_candidate.begin(); !frozen && (iter != m_shorten_candidate.end()); ++iter) {
+
+					if(!std::get<SHORTEN_CANDIDATE_RESOLVED>(*iter) 
+							|| (shorten.find(std::get<SHORTEN_CANDIDATE_COMMAND>(*iter)) != shorten.end())
+							|| (m_shorten_pinned.find(std::get<SHORTEN_CANDIDATE_COMMAND>(*iter)) 
+								!= m_shorten_pinned.end())) {
+						continue;
+					}
+
+					target = std::get<SHORTEN_CANDIDATE_VALUE>(*iter);
+
+					for(block_iter = shift.begin(); std::get<SHORTEN_CANDIDATE_LABEL>(*iter) && (block_iter != shift.end()); 
+							++block_iter) {
+						const cc65c::assembler::block_t &block = m_segment[block_iter->first.first].at(
+							block_iter->first.second);
+
+						if((std::get<SHORTEN_CANDIDATE_VALUE>(*iter) < block.first) 
+								|| (std::get<SHORTEN_CANDIDATE_VALUE>(*iter) 
+									> (int32_t) (block.first + block.second.size()))) {
+							continue;
+						}
+
+						for(shift_iter = block_iter->second.begin(); shift_iter != block_iter->second.end(); 
+								++shift_iter) {
+
+							if(shift_iter->first < std::get<SHORTEN_CANDIDATE_VALUE>(*iter)) {
+								target -= shift_iter->second;
+							}
+						}
+					}
+
+					if((target >= 0) && (target <= UINT8_MAX)) {
+						shorten.insert(std::get<SHORTEN_CANDIDATE_COMMAND>(*iter));
+						shift[std::make_pair(std::get<SHORTEN_CANDIDATE_SEGMENT>(*iter), 
+							std::get<SHORTEN_CANDIDATE_BLOCK>(*iter))].push_back(std::make_pair(
+								std::get<SHORTEN_CANDIDATE_ADDRESS>(*iter), GENERATOR_SHORTEN_LENGTH));
+						found = true;
+					}
+				}
+			} while(found);
+
+			result = (shorten != m_shorten);
+			if(result) {
+				m_shorten = shorten;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		generator::enumerate_statement(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			size_t block = 0, offset = 0;
+			std::string segment = m_segment_current;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_EMIT);
+
+			iter = m_segment.find(segment);
+			if((iter != m_segment.end()) && !iter->second.empty()) {
+				block = (iter->second.size() - 1);
+				offset = iter->second.back().second.size();
+			}
+
+			cc65c::assembler::token tok = tree.token();
+			if(!tok.match(TOKEN_KEYWORD_COMMAND)) {
+				m_peephole_boundary = true;
+			}
+
+			switch(tok.type()) {
+				case TOKEN_KEYWORD_COMMAND:
+					enumerate_command(tree);
+					break;
+				case TOKEN_KEYWORD_CONDITION:
+					enumerate_condition(tree);
+					break;
+				case TOKEN_KEYWORD_DEFINE:
+					enumerate_define(tree);
+					break;
+				case TOKEN_KEYWORD_INCLUDE:
+					enumerate_include(tree);
+					break;
+				case TOKEN_LABEL:
+					enumerate_label(tree);
+					break;
+				default:
+					THROW_GENERATOR_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_STATEMENT, GENERATOR_PATH, 
+						tok.row(), tok.column());
+			}
+
+			if(!tok.match(TOKEN_KEYWORD_COMMAND)) {
+				m_peephole_boundary = true;
+			}
+
+			if(!tok.match(TOKEN_KEYWORD_CONDITION) && !tok.match(TOKEN_KEYWORD_INCLUDE, KEYWORD_INCLUDE_SOURCE)) {
+				size_t length = 0;
+
+				iter = m_segment.find(segment);
+				if((iter != m_segment.end()) && (block < iter->second.size())) {
+					length = (iter->second.at(block).second.size() - offset);
+				}
+
+				m_listing.push_back(std::make_tuple(block, tok.column(), tok.match(TOKEN_LABEL) ? tok.key() : std::string(), 
+					length, offset, GENERATOR_PATH, tok.row(), segment));
+			}
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		generator::enumerate_statement_list(
+			__inout cc65c::assembler::tree &tree,
+			__in size_t index,
+			__in bool active
+			)
+		{
+			TRACE_ENTRY();
+
+			for(; index < tree.node().size(); ++index) {
+				tree.move_child_index(index);
+
+				cc65c::assembler::token tok = tree.token();
+				if(tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE)
+						|| tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE_IF)
+						|| tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE_IF_DEFINE)) {
+					tree.move_parent();
+					break;
+				}
+
+				if(active) {
+					enumerate_statement(tree);
+				}
+
+				tree.move_parent();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", index);
+			return index;
+		}
+
+		bool 
+		generator::has_label(
+			__in const std::string &name
+			)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_table.contains(name, TABLE_SYMBOL_LABEL);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		uint16_t 
+		generator::label(
+			__in const std::string &name
+			)
+		{
+			uint16_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			if(!m_table.contains(name, TABLE_SYMBOL_LABEL)) {
+				THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SYMBOL,
+					"Symbol=\"%s\"", STRING_CHECK(name));
+			}
+
+			result = m_table.value(m_table.find(name));
+
+			TRACE_EXIT_FORMAT("Result=%04x", result);
+			return result;
+		}
+
+		std::vector<cc65c::assembler::listing_metadata_t>::const_iterator 
+		generator::listing_begin(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			std::vector<cc65c::assembler::listing_metadata_t>::const_iterator result = m_listing.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::vector<cc65c::assembler::listing_metadata_t>::const_iterator 
+		generator::listing_end(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			std::vector<cc65c::assembler::listing_metadata_t>::const_iterator result = m_listing.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		const std::string &
+		generator::listing_line(
+			__in const std::string &path,
+			__in cc65c::core::stream_t row
+			)
+		{
+			const std::string *result;
+			std::map<std::string, cc65c::assembler::stream>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			if(path.empty()) {
+				result = &cc65c::assembler::stream::line(row);
+			} else {
+
+				iter = m_listing_source.find(path);
+				if(iter == m_listing_source.end()) {
+					iter = m_listing_source.insert(std::make_pair(path, cc65c::assembler::stream(path, true))).first;
+
+					while(iter->second.has_next()) {
+						iter->second.move_next();
+					}
+				}
+
+				result = &iter->second.line(row);
+			}
+
+			TRACE_EXIT_FORMAT("Result[%u]=\"%s\"", result->size(), STRING_CHECK(*result));
+			return *result;
+		}
+
+		uint16_t 
+		generator::origin(void)
+		{
+			uint16_t result = 0;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			iter = m_segment.find(m_segment_current);
+			if((iter != m_segment.end()) && !iter->second.empty()) {
+				result = iter->second.back().first;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%04x", result);
+			return result;
+		}
+
+		void 
+		generator::patch(
+			__in size_t index
+			)
+		{
+			int32_t displacement, value;
+			std::vector<size_t> unresolved;
+			std::map<size_t, size_t>::iterator iter;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_RESOLVE);
+
+			cc65c::assembler::fixup_metadata_t &entry = m_fixup.at(index);
+			value = enumerate_expression_evaluate(std::get<FIXUP_METADATA_PROGRAM>(entry), 
+				m_segment[std::get<FIXUP_METADATA_SEGMENT>(entry)].at(std::get<FIXUP_METADATA_BLOCK>(entry)).first, 
+				std::get<FIXUP_METADATA_ADDRESS>(entry), unresolved);
+
+			if(!unresolved.empty()) {
+				THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SYMBOL, 
+					std::get<FIXUP_METADATA_PATH>(entry), std::get<FIXUP_METADATA_ROW>(entry), 
+					std::get<FIXUP_METADATA_COLUMN>(entry), "Symbol=\"%s\"", 
+					STRING_CHECK(m_table.name(unresolved.front())));
+			}
+
+			iter = m_relax_fixup.find(index);
+			if(iter != m_relax_fixup.end()) {
+				cc65c::assembler::relax_branch_t &branch = m_relax_branch.at(iter->second);
+				std::get<RELAX_BRANCH_RESOLVED>(branch) = true;
+				std::get<RELAX_BRANCH_TARGET>(branch) = value;
+
+				displacement = (value - (std::get<RELAX_BRANCH_ADDRESS>(branch) 
+					+ std::get<RELAX_BRANCH_LENGTH>(branch)));
+				if((displacement < INT8_MIN) || (displacement > INT8_MAX)) {
+					TRACE_EXIT();
+					return;
+				}
+			}
+
+			iter = m_shorten_fixup.find(index);
+			if(iter != m_shorten_fixup.end()) {
+				cc65c::assembler::shorten_candidate_t &candidate = m_shorten_candidate.at(iter->second);
+				std::get<SHORTEN_CANDIDATE_LABEL>(candidate) = enumerate_expression_position(
+					std::get<FIXUP_METADATA_PROGRAM>(entry));
+				std::get<SHORTEN_CANDIDATE_RESOLVED>(candidate) = true;
+				std::get<SHORTEN_CANDIDATE_VALUE>(candidate) = value;
+
+				if(((value < 0) || (value > UINT8_MAX)) 
+						&& (std::get<FIXUP_METADATA_TYPE>(entry) == FIXUP_ABSOLUTE_BYTE)) {
+					m_shorten_pinned.insert(std::get<SHORTEN_CANDIDATE_COMMAND>(candidate));
+
+					TRACE_EXIT();
+					return;
+				}
+			}
+
+			write(std::get<FIXUP_METADATA_SEGMENT>(entry), std::get<FIXUP_METADATA_BLOCK>(entry), 
+				std::get<FIXUP_METADATA_OFFSET>(entry), value, std::get<FIXUP_METADATA_TYPE>(entry), 
+				std::get<FIXUP_METADATA_PATH>(entry), std::get<FIXUP_METADATA_ROW>(entry), 
+				std::get<FIXUP_METADATA_COLUMN>(entry));
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		generator::passes(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_pass;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator 
+		generator::peephole_begin(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator result = m_peephole_report.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator 
+		generator::peephole_end(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator result = m_peephole_report.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		size_t 
+		generator::relaxed(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_relax.size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		generator::reset_generator(void)
+		{
+			TRACE_ENTRY();
+
+			m_command = 0;
+			m_dependency.clear();
+			m_fixup.clear();
+			m_fixup_tree.clear();
+			m_include.clear();
+			m_label.clear();
+			m_listing.clear();
+			m_listing_source.clear();
+			m_peephole_boundary = true;
+			m_peephole_command.clear();
+			m_peephole_report.clear();
+			m_relax_branch.clear();
+			m_relax_fixup.clear();
+			m_relayout_safe = true;
+			m_segment.clear();
+			m_segment_current = SEGMENT_DEFAULT;
+			m_shorten_candidate.clear();
+			m_shorten_fixup.clear();
+			m_table.reset();
+
+			TRACE_EXIT();
+		}
+
+		const std::vector<cc65c::assembler::block_t> &
+		generator::segment(
+			__in const std::string &name
+			)
+		{
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			iter = m_segment.find(name);
+			if(iter == m_segment.end()) {
+				THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SEGMENT,
+					"Segment=\"%s\"", STRING_CHECK(name));
+			}
+
+			TRACE_EXIT();
+			return iter->second;
+		}
+
+		std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator 
+		generator::segment_begin(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator result = m_segment.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator 
+		generator::segment_end(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator result = m_segment.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		generator::set(
+			__in const std::string &input,
+			__in_opt bool is_file
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			cc65c::assembler::parser::set(input, is_file);
+			reset_generator();
+			m_expression.clear();
+			m_expression_index.clear();
+			m_table.clear();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::set_peephole(
+			__in bool enabled
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			m_peephole_enabled = enabled;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		generator::set_relax(
+			__in bool enabled
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			m_relax_enabled = enabled;
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		generator::shortened(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_shorten.size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		size_t 
+		generator::size(void)
+		{
+			size_t result = 0;
+			std::vector<cc65c::assembler::block_t>::iterator block_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			for(iter = m_segment.begin(); iter != m_segment.end(); ++iter) {
+
+				for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+					result += block_iter->second.size();
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		size_t 
+		generator::symbol_count(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = m_table.size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::string 
+		generator::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = cc65c::assembler::generator::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		size_t 
+		generator::tree_count(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_generator_mutex);
+
+			result = cc65c::assembler::parser::size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		generator::write(
+			__in const std::string &segment,
+			__in size_t block,
+			__in size_t offset,
+			__in int32_t value,
+			__in cc65c::assembler::fixup_t type,
+			__in const std::string &path,
+			__in cc65c::core::stream_t row,
+			__in cc65c::core::stream_t column
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::assembler::block_t &entry = m_segment[segment].at(block);
+			switch(type) {
+				case FIXUP_ABSOLUTE_BYTE:
+
+					if((value < INT8_MIN) || (value > UINT8_MAX)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, path, row, 
+							column, "Value=%i", value);
+					}
+
+					entry.second.at(offset) = value;
+					break;
+				case FIXUP_ABSOLUTE_WORD:
+
+					if((value < INT16_MIN) || (value > UINT16_MAX)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, path, row, 
+							column, "Value=%i", value);
+					}
+
+					entry.second.at(offset) = value;
+					entry.second.at(offset + 1) = (value >> 8);
+					break;
+				case FIXUP_RELATIVE:
+					value -= (entry.first + offset + 1);
+
+					if((value < INT8_MIN) || (value > INT8_MAX)) {
+						THROW_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE, path, row, 
+							column, "Offset=%i", value);
+					}
+
+					entry.second.at(offset) = value;
+					break;
+				default:
+					THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_MODE,
+						"Type=%x", type);
+			}
+
+			TRACE_EXIT();
+		}
+	}
+}
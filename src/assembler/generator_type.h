@@ -0,0 +1,82 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CC65C_ASSEMBLER_GENERATOR_TYPE_H_
+#define CC65C_ASSEMBLER_GENERATOR_TYPE_H_
+
+#include "../../include/core/exception.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define CC65C_ASSEMBLER_GENERATOR_HEADER "[CC65C::ASSEMBLER::GENERATOR]"
+
+#ifndef NDEBUG
+		#define CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER CC65C_ASSEMBLER_GENERATOR_HEADER " "
+#else
+		#define CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER
+#endif // NDEBUG
+
+		enum {
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_DIVIDE_BY_ZERO = 0,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_DUPLICATE_SYMBOL,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_EXPECTING_EXPRESSION,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FILE_NOT_FOUND,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_INCLUDE,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_MODE,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_INVALID_STATEMENT,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_MALFORMED_HEXIDECIMAL,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_BOUNDS,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_OUT_OF_RANGE,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SEGMENT,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNDEFINED_SYMBOL,
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNSUPPORTED_RELOCATION,
+		};
+
+		#define CC65C_ASSEMBLER_GENERATOR_EXCEPTION_MAX CC65C_ASSEMBLER_GENERATOR_EXCEPTION_UNSUPPORTED_RELOCATION
+
+		static const std::string CC65C_ASSEMBLER_GENERATOR_EXCEPTION_STR[] = {
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Division by zero",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Duplicate symbol",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Expecting expression",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "File not found",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Recursive include",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Invalid addressing mode",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Invalid statement",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Malformed hexidecimal file",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Address out of bounds",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Value out of range",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Undefined segment",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Undefined symbol",
+			CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER "Unsupported relocation",
+			};
+
+		#define CC65C_ASSEMBLER_GENERATOR_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > CC65C_ASSEMBLER_GENERATOR_EXCEPTION_MAX ? CC65C_ASSEMBLER_GENERATOR_EXCEPTION_HEADER EXCEPTION_UNKNOWN : \
+			STRING_CHECK(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_CC65C_ASSEMBLER_GENERATOR_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_FORMAT(CC65C_ASSEMBLER_GENERATOR_EXCEPTION_STRING(_EXCEPT_), \
+				_FORMAT_, __VA_ARGS__)
+	}
+}
+
+#endif // CC65C_ASSEMBLER_GENERATOR_TYPE_H_
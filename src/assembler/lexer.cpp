@@ -18,6 +18,7 @@
 
 #include "../../include/assembler/lexer.h"
 #include "lexer_type.h"
+#include "../../include/core/counter.h"
 #include "../../include/core/trace.h"
 
 namespace cc65c {
@@ -62,7 +63,8 @@ namespace cc65c {
 		};
 
 		lexer::lexer(void) :
-			m_token_position(0)
+			m_token_position(0),
+			m_token_template(false)
 		{
 			TRACE_ENTRY();
 
@@ -76,7 +78,8 @@ namespace cc65c {
 			__in_opt bool is_file
 			) :
 				cc65c::assembler::stream(input, is_file),
-				m_token_position(0)
+				m_token_position(0),
+				m_token_template(false)
 		{
 			TRACE_ENTRY();
 
@@ -90,7 +93,8 @@ namespace cc65c {
 			) :
 				cc65c::assembler::stream(other),
 				m_token(other.m_token),
-				m_token_position(other.m_token_position)
+				m_token_position(other.m_token_position),
+				m_token_template(other.m_token_template)
 		{
 			TRACE_ENTRY();
 			TRACE_EXIT();
@@ -114,6 +118,7 @@ namespace cc65c {
 				cc65c::assembler::stream::operator=(other);
 				m_token = other.m_token;
 				m_token_position = other.m_token_position;
+				m_token_template = other.m_token_template;
 			}
 
 			TRACE_EXIT_FORMAT("Result=%p", this);
@@ -242,6 +247,7 @@ namespace cc65c {
 			m_token.front().set_metadata(cc65c::assembler::stream::row(), cc65c::assembler::stream::column());
 			m_token.back().set_metadata(cc65c::assembler::stream::row(), cc65c::assembler::stream::column());
 			m_token_position = 0;
+			m_token_template = false;
 
 			TRACE_EXIT();
 		}
@@ -919,12 +925,16 @@ namespace cc65c {
 					"Position=%u", m_token_position);
 			}
 
-			skip_whitespace();
+			if(!m_token_template) {
+				cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_LEX);
 
-			if(cc65c::assembler::stream::has_next() 
-					&& (m_token_position <= (m_token.size() - TOKEN_SENTINEL_COUNT))) {
-				enumerate_token();
-				m_token.back().set_metadata(cc65c::assembler::stream::row(), cc65c::assembler::stream::column());
+				skip_whitespace();
+
+				if(cc65c::assembler::stream::has_next() 
+						&& (m_token_position == (m_token.size() - TOKEN_SENTINEL_COUNT))) {
+					enumerate_token();
+					m_token.back().set_metadata(cc65c::assembler::stream::row(), cc65c::assembler::stream::column());
+				}
 			}
 
 			++m_token_position;
@@ -1090,6 +1100,149 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		void 
+		lexer::skip_condition(
+			__in_opt bool end
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_lexer_mutex);
+
+			if(has_next()) {
+				--m_token_position;
+				skip_condition_next(end);
+				++m_token_position;
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		lexer::skip_condition_next(
+			__in_opt bool end
+			)
+		{
+			size_t depth = 0;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_lexer_mutex);
+
+			while((m_token_position + 1) < (m_token.size() - 1)) {
+
+				cc65c::assembler::token &tok = m_token.at(m_token_position + 1);
+				if(tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_IF)
+						|| tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_IF_DEFINE)) {
+					++depth;
+				} else if(tok.match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_END_IF)) {
+
+					if(!depth) {
+						break;
+					}
+
+					--depth;
+				} else if(!depth && !end && tok.match(TOKEN_KEYWORD_CONDITION)) {
+					break;
+				}
+
+				m_token.erase(m_token.begin() + m_token_position + 1);
+			}
+
+			if(!m_token_template && ((m_token_position + 1) == (m_token.size() - 1))) {
+				skip_condition_stream(depth, end);
+				m_token.back().set_metadata(cc65c::assembler::stream::row(), cc65c::assembler::stream::column());
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		lexer::skip_condition_stream(
+			__inout size_t &depth,
+			__in bool end
+			)
+		{
+			std::string key;
+			bool label, result = false;
+			cc65c::core::stream_t column, row;
+			uint32_t subtype;
+			cc65c::assembler::token_t type;
+
+			TRACE_ENTRY();
+
+			while(!result) {
+				skip_whitespace();
+
+				if(!cc65c::assembler::stream::has_next()) {
+					break;
+				}
+
+				if(cc65c::assembler::stream::match(CHARACTER_SYMBOL, CHARACTER_COMMENT)) {
+					skip_comment();
+				} else if(cc65c::assembler::stream::match(CHARACTER_SYMBOL, CHARACTER_LITERAL_CHARACTER)) {
+					enumerate_token_literal_character();
+				} else if(cc65c::assembler::stream::match(CHARACTER_SYMBOL, CHARACTER_LITERAL_STRING)) {
+					enumerate_token_literal_string();
+				} else if(cc65c::assembler::stream::match(CHARACTER_ALPHA)
+						|| cc65c::assembler::stream::match(CHARACTER_DIGIT)
+						|| cc65c::assembler::stream::match(CHARACTER_SYMBOL, CHARACTER_UNDERSCORE)) {
+					key.clear();
+					label = false;
+					cc65c::assembler::stream::metadata(row, column);
+
+					for(;;) {
+						key += cc65c::assembler::stream::character();
+
+						if(!cc65c::assembler::stream::has_next()) {
+							break;
+						}
+
+						cc65c::assembler::stream::move_next();
+
+						if(!cc65c::assembler::stream::match(CHARACTER_ALPHA)
+								&& !cc65c::assembler::stream::match(CHARACTER_DIGIT)
+								&& !cc65c::assembler::stream::match(CHARACTER_SYMBOL, CHARACTER_UNDERSCORE)) {
+							label = cc65c::assembler::stream::match(CHARACTER_SYMBOL, CHARACTER_LABEL_TERMINATOR);
+							break;
+						}
+					}
+
+					if(label || !KEYWORD_CONDITION_CONTAINS(key)) {
+						continue;
+					}
+
+					cc65c::assembler::token::determine_type(key, type, subtype);
+
+					switch(subtype) {
+						case KEYWORD_CONDITION_END_IF:
+
+							if(!depth) {
+								result = true;
+							} else {
+								--depth;
+							}
+							break;
+						case KEYWORD_CONDITION_IF:
+						case KEYWORD_CONDITION_IF_DEFINE:
+							++depth;
+							break;
+						default:
+							result = (!depth && !end);
+							break;
+					}
+
+					if(result) {
+						add_token(type, subtype, row, column);
+					}
+				} else {
+					cc65c::assembler::stream::move_next();
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		void 
 		lexer::skip_whitespace(void)
 		{
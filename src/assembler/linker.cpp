@@ -0,0 +1,564 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <list>
+#include "../../include/assembler/linker.h"
+#include "linker_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		linker_worker::linker_worker(
+			__inout std::vector<cc65c::assembler::block_t> &segment,
+			__in const std::vector<cc65c::assembler::linker_relocation_t> &relocation
+			) :
+				m_relocation(relocation),
+				m_segment(segment)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		linker_worker::~linker_worker(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		void 
+		linker_worker::on_activate(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		void 
+		linker_worker::on_deactivate(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		void 
+		linker_worker::apply(void)
+		{
+			int32_t value;
+			std::vector<cc65c::assembler::linker_relocation_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			for(iter = m_relocation.begin(); iter != m_relocation.end(); ++iter) {
+				cc65c::assembler::block_t &entry = m_segment.at(std::get<LINKER_RELOCATION_BLOCK>(*iter));
+				size_t offset = std::get<LINKER_RELOCATION_OFFSET>(*iter);
+
+				if((offset + ((std::get<LINKER_RELOCATION_TYPE>(*iter) == FIXUP_ABSOLUTE_WORD) ? 1 : 0)) 
+						>= entry.second.size()) {
+					THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_OUT_OF_BOUNDS,
+						"Offset=%u\n\t%s@%u:%u", offset, STRING_CHECK(std::get<LINKER_RELOCATION_PATH>(*iter)), 
+						std::get<LINKER_RELOCATION_ROW>(*iter), std::get<LINKER_RELOCATION_COLUMN>(*iter));
+				}
+
+				value = std::get<LINKER_RELOCATION_VALUE>(*iter);
+				switch(std::get<LINKER_RELOCATION_TYPE>(*iter)) {
+					case FIXUP_ABSOLUTE_BYTE:
+
+						if((value < INT8_MIN) || (value > UINT8_MAX)) {
+							THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_OUT_OF_RANGE,
+								"Value=%i\n\t%s@%u:%u", value, STRING_CHECK(std::get<LINKER_RELOCATION_PATH>(*iter)), 
+								std::get<LINKER_RELOCATION_ROW>(*iter), std::get<LINKER_RELOCATION_COLUMN>(*iter));
+						}
+
+						entry.second.at(offset) = value;
+						break;
+					case FIXUP_ABSOLUTE_WORD:
+
+						if((value < INT16_MIN) || (value > UINT16_MAX)) {
+							THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_OUT_OF_RANGE,
+								"Value=%i\n\t%s@%u:%u", value, STRING_CHECK(std::get<LINKER_RELOCATION_PATH>(*iter)), 
+								std::get<LINKER_RELOCATION_ROW>(*iter), std::get<LINKER_RELOCATION_COLUMN>(*iter));
+						}
+
+						entry.second.at(offset) = value;
+						entry.second.at(offset + 1) = (value >> 8);
+						break;
+					case FIXUP_RELATIVE:
+						value -= (entry.first + offset + 1);
+
+						if((value < INT8_MIN) || (value > INT8_MAX)) {
+							THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_OUT_OF_RANGE,
+								"Offset=%i\n\t%s@%u:%u", value, STRING_CHECK(std::get<LINKER_RELOCATION_PATH>(*iter)), 
+								std::get<LINKER_RELOCATION_ROW>(*iter), std::get<LINKER_RELOCATION_COLUMN>(*iter));
+						}
+
+						entry.second.at(offset) = value;
+						break;
+					default:
+						THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_OUT_OF_RANGE,
+							"Type=%x", std::get<LINKER_RELOCATION_TYPE>(*iter));
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker_worker::on_loop(void)
+		{
+			TRACE_ENTRY();
+
+			try {
+				apply();
+			} catch(cc65c::core::exception &exc) {
+				m_signal_complete.set();
+				throw;
+			}
+
+			m_signal_complete.set();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker_worker::start(void)
+		{
+			TRACE_ENTRY();
+
+			cc65c::core::thread::activate(true);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker_worker::stop(void)
+		{
+			TRACE_ENTRY();
+
+			m_signal_complete.wait();
+			cc65c::core::thread::deactivate();
+
+			TRACE_EXIT();
+		}
+
+		linker::linker(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		linker::linker(
+			__in const linker &other
+			) :
+				m_object(other.m_object),
+				m_segment(other.m_segment),
+				m_table(other.m_table)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		linker::~linker(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		linker &
+		linker::operator=(
+			__in const linker &other
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			if(this != &other) {
+				m_object = other.m_object;
+				m_segment = other.m_segment;
+				m_table = other.m_table;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", this);
+			return *this;
+		}
+
+		void 
+		linker::add(
+			__in const cc65c::assembler::object &input
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			m_object.push_back(input);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker::add(
+			__in const std::string &input
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			m_object.push_back(cc65c::assembler::object(input));
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		linker::as_string(
+			__in const linker &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+			std::vector<cc65c::assembler::block_t>::const_iterator block_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			result << "Object[" << reference.m_object.size() << "], Segment[" << reference.m_segment.size() 
+				<< "], Symbol={" << cc65c::assembler::table::as_string(reference.m_table, false) << "}";
+
+			if(verbose) {
+
+				for(iter = reference.m_segment.begin(); iter != reference.m_segment.end(); ++iter) {
+					result << std::endl << "\t" << STRING_CHECK(iter->first) << "[" << iter->second.size() << "]";
+
+					for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+						result << std::endl << "\t\t" << SCALAR_AS_HEX(uint16_t, block_iter->first) 
+							<< "[" << block_iter->second.size() << "]";
+					}
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		linker::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			m_object.clear();
+			m_segment.clear();
+			m_table.clear();
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		linker::has_symbol(
+			__in const std::string &name
+			)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			result = m_table.contains(name);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		size_t 
+		linker::link(void)
+		{
+			size_t result;
+			std::map<std::string, std::vector<cc65c::assembler::linker_relocation_t>> relocation;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			m_segment.clear();
+			m_table.clear();
+			link_symbol();
+			link_segment(relocation);
+			link_overlap();
+			link_relocation(relocation);
+			result = size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void 
+		linker::link_overlap(void)
+		{
+			std::vector<std::pair<uint32_t, uint32_t>> range;
+			std::vector<std::pair<uint32_t, uint32_t>>::iterator range_iter;
+			std::vector<cc65c::assembler::block_t>::iterator block_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			for(iter = m_segment.begin(); iter != m_segment.end(); ++iter) {
+				range.clear();
+
+				for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+
+					if(!block_iter->second.empty()) {
+						range.push_back(std::make_pair(block_iter->first, block_iter->first + block_iter->second.size()));
+					}
+				}
+
+				std::sort(range.begin(), range.end());
+
+				for(range_iter = range.begin(); range_iter != range.end(); ++range_iter) {
+
+					if(((range_iter + 1) != range.end()) && (range_iter->second > (range_iter + 1)->first)) {
+						THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_OVERLAP,
+							"Segment=%s, Address=%04x", STRING_CHECK(iter->first), (range_iter + 1)->first);
+					}
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker::link_relocation(
+			__in const std::map<std::string, std::vector<cc65c::assembler::linker_relocation_t>> &relocation
+			)
+		{
+			bool failure = false;
+			cc65c::core::exception error;
+			std::list<cc65c::assembler::linker_worker> worker;
+			std::list<cc65c::assembler::linker_worker>::iterator worker_iter;
+			std::map<std::string, std::vector<cc65c::assembler::linker_relocation_t>>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			for(iter = relocation.begin(); iter != relocation.end(); ++iter) {
+				worker.emplace_back(m_segment[iter->first], iter->second);
+			}
+
+			for(worker_iter = worker.begin(); worker_iter != worker.end(); ++worker_iter) {
+				worker_iter->start();
+			}
+
+			for(worker_iter = worker.begin(); worker_iter != worker.end(); ++worker_iter) {
+
+				try {
+					worker_iter->stop();
+				} catch(cc65c::core::exception &exc) {
+
+					if(!failure) {
+						error = exc;
+						failure = true;
+					}
+				}
+			}
+
+			if(failure) {
+				throw error;
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker::link_segment(
+			__inout std::map<std::string, std::vector<cc65c::assembler::linker_relocation_t>> &relocation
+			)
+		{
+			size_t index;
+			std::map<std::string, size_t> base;
+			std::vector<cc65c::assembler::object>::iterator iter;
+			std::vector<cc65c::assembler::object_relocation_t>::iterator relocation_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator segment_iter;
+
+			TRACE_ENTRY();
+
+			for(iter = m_object.begin(); iter != m_object.end(); ++iter) {
+				base.clear();
+
+				std::map<std::string, std::vector<cc65c::assembler::block_t>> &segment = iter->segment();
+				for(segment_iter = segment.begin(); segment_iter != segment.end(); ++segment_iter) {
+					std::vector<cc65c::assembler::block_t> &entry = m_segment[segment_iter->first];
+					base.insert(std::make_pair(segment_iter->first, entry.size()));
+					entry.insert(entry.end(), segment_iter->second.begin(), segment_iter->second.end());
+				}
+
+				std::vector<cc65c::assembler::object_symbol_t> &symbol = iter->symbol();
+				std::vector<cc65c::assembler::object_relocation_t> &object_relocation = iter->relocation();
+
+				for(relocation_iter = object_relocation.begin(); relocation_iter != object_relocation.end(); 
+						++relocation_iter) {
+					const std::string &name = std::get<OBJECT_SYMBOL_NAME>(symbol.at(
+						std::get<OBJECT_RELOCATION_SYMBOL>(*relocation_iter)));
+
+					index = m_table.find(name);
+					if((index == TABLE_INDEX_INVALID) || (m_table.type(index) == TABLE_SYMBOL_UNDEFINED)) {
+						THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_UNDEFINED_SYMBOL,
+							"Symbol=\"%s\"\n\t%s@%u:%u", STRING_CHECK(name), STRING_CHECK(iter->source()), 
+							std::get<OBJECT_RELOCATION_ROW>(*relocation_iter), 
+							std::get<OBJECT_RELOCATION_COLUMN>(*relocation_iter));
+					}
+
+					relocation[std::get<OBJECT_RELOCATION_SEGMENT>(*relocation_iter)].push_back(std::make_tuple(
+						base.at(std::get<OBJECT_RELOCATION_SEGMENT>(*relocation_iter)) 
+							+ std::get<OBJECT_RELOCATION_BLOCK>(*relocation_iter),
+						std::get<OBJECT_RELOCATION_COLUMN>(*relocation_iter), 
+						std::get<OBJECT_RELOCATION_OFFSET>(*relocation_iter), iter->source(), 
+						std::get<OBJECT_RELOCATION_ROW>(*relocation_iter), std::get<OBJECT_RELOCATION_TYPE>(*relocation_iter), 
+						m_table.value(index) + std::get<OBJECT_RELOCATION_ADDEND>(*relocation_iter)));
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		linker::link_symbol(void)
+		{
+			size_t index;
+			std::vector<size_t> resolved;
+			std::vector<cc65c::assembler::object>::iterator iter;
+			std::vector<cc65c::assembler::object_symbol_t>::iterator symbol_iter;
+
+			TRACE_ENTRY();
+
+			for(iter = m_object.begin(); iter != m_object.end(); ++iter) {
+
+				std::vector<cc65c::assembler::object_symbol_t> &symbol = iter->symbol();
+				for(symbol_iter = symbol.begin(); symbol_iter != symbol.end(); ++symbol_iter) {
+
+					if(std::get<OBJECT_SYMBOL_TYPE>(*symbol_iter) == TABLE_SYMBOL_UNDEFINED) {
+						continue;
+					}
+
+					index = m_table.intern(std::get<OBJECT_SYMBOL_NAME>(*symbol_iter));
+					if(m_table.type(index) != TABLE_SYMBOL_UNDEFINED) {
+						THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_DUPLICATE_SYMBOL,
+							"Symbol=\"%s\", Source=%s", STRING_CHECK(std::get<OBJECT_SYMBOL_NAME>(*symbol_iter)), 
+							STRING_CHECK(iter->source()));
+					}
+
+					m_table.define(index, std::get<OBJECT_SYMBOL_TYPE>(*symbol_iter), 
+						std::get<OBJECT_SYMBOL_VALUE>(*symbol_iter), resolved);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator 
+		linker::segment_begin(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator result = m_segment.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator 
+		linker::segment_end(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator result = m_segment.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		size_t 
+		linker::size(void)
+		{
+			size_t result = 0;
+			std::vector<cc65c::assembler::block_t>::iterator block_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			for(iter = m_segment.begin(); iter != m_segment.end(); ++iter) {
+
+				for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+					result += block_iter->second.size();
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		int32_t 
+		linker::symbol(
+			__in const std::string &name
+			)
+		{
+			size_t index;
+			int32_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			index = m_table.find(name);
+			if((index == TABLE_INDEX_INVALID) || (m_table.type(index) == TABLE_SYMBOL_UNDEFINED)) {
+				THROW_CC65C_ASSEMBLER_LINKER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_LINKER_EXCEPTION_UNDEFINED_SYMBOL,
+					"Symbol=\"%s\"", STRING_CHECK(name));
+			}
+
+			result = m_table.value(index);
+
+			TRACE_EXIT_FORMAT("Result=%i", result);
+			return result;
+		}
+
+		std::string 
+		linker::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_linker_mutex);
+
+			result = cc65c::assembler::linker::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+	}
+}
@@ -168,11 +168,6 @@ namespace cc65c {
 					"Child=%p", m_node_child);
 			}
 
-			cc65c::assembler::symbol &instance = cc65c::assembler::symbol::acquire();
-			if(instance.is_initialized() && instance.contains_node(id)) {
-				instance.increment_node(id);
-			}
-
 			m_node_child->push_back(id);
 
 			TRACE_EXIT();
@@ -385,8 +380,6 @@ namespace cc65c {
 			__in_opt const std::vector<cc65c::core::uuid_t> &child
 			)
 		{
-			std::vector<cc65c::core::uuid_t>::const_iterator iter;
-
 			TRACE_ENTRY();
 
 			cc65c::assembler::symbol &instance = cc65c::assembler::symbol::acquire();
@@ -400,13 +393,6 @@ namespace cc65c {
 				if(instance.contains_node(parent)) {
 					instance.increment_node(parent);
 				}
-
-				for(iter = child.begin(); iter != child.end(); ++iter) {
-
-					if(instance.contains_node(*iter)) {
-						instance.increment_node(*iter);
-					}
-				}
 			}
 
 			TRACE_EXIT();
@@ -0,0 +1,481 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../../include/assembler/object.h"
+#include "object_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		object::object(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		object::object(
+			__in const std::string &input
+			)
+		{
+			TRACE_ENTRY();
+
+			read(input);
+
+			TRACE_EXIT();
+		}
+
+		object::object(
+			__in const std::string &source,
+			__in const std::map<std::string, std::vector<cc65c::assembler::block_t>> &segment,
+			__in const std::vector<cc65c::assembler::object_symbol_t> &symbol,
+			__in const std::vector<cc65c::assembler::object_relocation_t> &relocation
+			) :
+				m_relocation(relocation),
+				m_segment(segment),
+				m_source(source),
+				m_symbol(symbol)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		object::object(
+			__in const object &other
+			) :
+				m_relocation(other.m_relocation),
+				m_segment(other.m_segment),
+				m_source(other.m_source),
+				m_symbol(other.m_symbol)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		object::~object(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		object &
+		object::operator=(
+			__in const object &other
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			if(this != &other) {
+				m_relocation = other.m_relocation;
+				m_segment = other.m_segment;
+				m_source = other.m_source;
+				m_symbol = other.m_symbol;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", this);
+			return *this;
+		}
+
+		std::string 
+		object::as_string(
+			__in const object &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+			std::vector<cc65c::assembler::block_t>::const_iterator block_iter;
+			std::vector<cc65c::assembler::object_symbol_t>::const_iterator symbol_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			result << "Source[" << reference.m_source.size() << "]=\"" << STRING_CHECK(reference.m_source) << "\"" 
+				<< ", Segment[" << reference.m_segment.size() << "], Symbol[" << reference.m_symbol.size() 
+				<< "], Relocation[" << reference.m_relocation.size() << "]";
+
+			if(verbose) {
+
+				for(iter = reference.m_segment.begin(); iter != reference.m_segment.end(); ++iter) {
+					result << std::endl << "\t" << STRING_CHECK(iter->first) << "[" << iter->second.size() << "]";
+
+					for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+						result << std::endl << "\t\t" << SCALAR_AS_HEX(uint16_t, block_iter->first) 
+							<< "[" << block_iter->second.size() << "]";
+					}
+				}
+
+				for(symbol_iter = reference.m_symbol.begin(); symbol_iter != reference.m_symbol.end(); ++symbol_iter) {
+					result << std::endl << "\t" << TABLE_SYMBOL_STRING(std::get<OBJECT_SYMBOL_TYPE>(*symbol_iter)) 
+						<< " \"" << STRING_CHECK(std::get<OBJECT_SYMBOL_NAME>(*symbol_iter)) << "\"";
+
+					if(std::get<OBJECT_SYMBOL_TYPE>(*symbol_iter) != TABLE_SYMBOL_UNDEFINED) {
+						result << "=" << SCALAR_AS_HEX(uint16_t, std::get<OBJECT_SYMBOL_VALUE>(*symbol_iter));
+					}
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		object::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			m_relocation.clear();
+			m_segment.clear();
+			m_source.clear();
+			m_symbol.clear();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		object::read(
+			__in const std::string &input
+			)
+		{
+			int file;
+			struct stat status;
+			const uint8_t *data;
+			size_t block_count, count, index, length, offset = 0, size;
+			std::vector<std::string> segment;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			file = open(input.c_str(), O_RDONLY);
+			if(file < 0) {
+				THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_FILE_NOT_FOUND,
+					"Path[%u]=%s", input.size(), STRING_CHECK(input));
+			}
+
+			if(fstat(file, &status) || !status.st_size) {
+				close(file);
+				THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+					"Path[%u]=%s", input.size(), STRING_CHECK(input));
+			}
+
+			length = status.st_size;
+			data = (const uint8_t *) mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+
+			if(data == MAP_FAILED) {
+				THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+					"Path[%u]=%s", input.size(), STRING_CHECK(input));
+			}
+
+			clear();
+
+			try {
+
+				if(read_value(data, length, offset, sizeof(uint32_t)) != OBJECT_MAGIC) {
+					THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+						"Path[%u]=%s", input.size(), STRING_CHECK(input));
+				}
+
+				index = read_value(data, length, offset, sizeof(uint16_t));
+				if(index != OBJECT_VERSION) {
+					THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_UNSUPPORTED_VERSION,
+						"Path[%u]=%s, Version=%u", input.size(), STRING_CHECK(input), index);
+				}
+
+				m_source = read_string(data, length, offset);
+
+				for(count = read_value(data, length, offset, sizeof(uint32_t)); count > 0; --count) {
+					segment.push_back(read_string(data, length, offset));
+					std::vector<cc65c::assembler::block_t> &entry = m_segment[segment.back()];
+
+					for(block_count = read_value(data, length, offset, sizeof(uint32_t)); block_count > 0; 
+							--block_count) {
+						index = read_value(data, length, offset, sizeof(uint16_t));
+						size = read_value(data, length, offset, sizeof(uint32_t));
+
+						if((offset + size) > length) {
+							THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+								"Offset=%u, Size=%u", offset, size);
+						}
+
+						entry.push_back(cc65c::assembler::block_t(index, std::vector<uint8_t>(data + offset, 
+							data + offset + size)));
+						offset += size;
+					}
+				}
+
+				for(count = read_value(data, length, offset, sizeof(uint32_t)); count > 0; --count) {
+					std::string name = read_string(data, length, offset);
+
+					index = read_value(data, length, offset, sizeof(uint8_t));
+					if(index > TABLE_SYMBOL_MAX) {
+						THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+							"Offset=%u, Type=%x", offset, index);
+					}
+
+					m_symbol.push_back(std::make_tuple(name, (cc65c::assembler::table_symbol_t) index, 
+						(int32_t) read_value(data, length, offset, sizeof(uint32_t))));
+				}
+
+				for(count = read_value(data, length, offset, sizeof(uint32_t)); count > 0; --count) {
+					cc65c::assembler::object_relocation_t entry;
+
+					index = read_value(data, length, offset, sizeof(uint32_t));
+					if(index >= segment.size()) {
+						THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+							"Offset=%u, Segment=%u", offset, index);
+					}
+
+					std::get<OBJECT_RELOCATION_SEGMENT>(entry) = segment.at(index);
+					std::get<OBJECT_RELOCATION_BLOCK>(entry) = read_value(data, length, offset, sizeof(uint32_t));
+					std::get<OBJECT_RELOCATION_OFFSET>(entry) = read_value(data, length, offset, sizeof(uint32_t));
+
+					index = read_value(data, length, offset, sizeof(uint8_t));
+					if(index > FIXUP_MAX) {
+						THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+							"Offset=%u, Type=%x", offset, index);
+					}
+
+					std::get<OBJECT_RELOCATION_TYPE>(entry) = (cc65c::assembler::fixup_t) index;
+					std::get<OBJECT_RELOCATION_SYMBOL>(entry) = read_value(data, length, offset, sizeof(uint32_t));
+					std::get<OBJECT_RELOCATION_ADDEND>(entry) = read_value(data, length, offset, sizeof(uint32_t));
+					std::get<OBJECT_RELOCATION_ROW>(entry) = read_value(data, length, offset, sizeof(uint32_t));
+					std::get<OBJECT_RELOCATION_COLUMN>(entry) = read_value(data, length, offset, sizeof(uint32_t));
+
+					if((std::get<OBJECT_RELOCATION_SYMBOL>(entry) >= m_symbol.size())
+							|| (std::get<OBJECT_RELOCATION_BLOCK>(entry) 
+								>= m_segment[std::get<OBJECT_RELOCATION_SEGMENT>(entry)].size())) {
+						THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+							"Offset=%u", offset);
+					}
+
+					m_relocation.push_back(entry);
+				}
+			} catch(cc65c::core::exception &exc) {
+				munmap((void *) data, length);
+				clear();
+				throw;
+			}
+
+			munmap((void *) data, length);
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		object::read_string(
+			__in const uint8_t *data,
+			__in size_t length,
+			__inout size_t &offset
+			)
+		{
+			size_t size;
+			std::string result;
+
+			size = read_value(data, length, offset, sizeof(uint32_t));
+			if((offset + size) > length) {
+				THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+					"Offset=%u, Size=%u", offset, size);
+			}
+
+			result = std::string((const char *) data + offset, size);
+			offset += size;
+
+			return result;
+		}
+
+		uint32_t 
+		object::read_value(
+			__in const uint8_t *data,
+			__in size_t length,
+			__inout size_t &offset,
+			__in size_t width
+			)
+		{
+			size_t index;
+			uint32_t result = 0;
+
+			if((offset + width) > length) {
+				THROW_CC65C_ASSEMBLER_OBJECT_EXCEPTION_FORMAT(CC65C_ASSEMBLER_OBJECT_EXCEPTION_MALFORMED,
+					"Offset=%u, Width=%u", offset, width);
+			}
+
+			for(index = 0; index < width; ++index) {
+				result |= (((uint32_t) data[offset + index]) << (index * 8));
+			}
+
+			offset += width;
+
+			return result;
+		}
+
+		std::vector<cc65c::assembler::object_relocation_t> &
+		object::relocation(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			TRACE_EXIT();
+			return m_relocation;
+		}
+
+		std::map<std::string, std::vector<cc65c::assembler::block_t>> &
+		object::segment(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			TRACE_EXIT();
+			return m_segment;
+		}
+
+		std::string 
+		object::source(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%s", STRING_CHECK(m_source));
+			return m_source;
+		}
+
+		std::vector<cc65c::assembler::object_symbol_t> &
+		object::symbol(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			TRACE_EXIT();
+			return m_symbol;
+		}
+
+		std::string 
+		object::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			result = cc65c::assembler::object::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		object::write(
+			__in const std::string &output
+			)
+		{
+			size_t index;
+			std::vector<uint8_t> data;
+			std::map<std::string, size_t> segment;
+			std::vector<cc65c::assembler::block_t>::iterator block_iter;
+			std::vector<cc65c::assembler::object_symbol_t>::iterator symbol_iter;
+			std::vector<cc65c::assembler::object_relocation_t>::iterator relocation_iter;
+			std::map<std::string, std::vector<cc65c::assembler::block_t>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_object_mutex);
+
+			write_value(data, OBJECT_MAGIC, sizeof(uint32_t));
+			write_value(data, OBJECT_VERSION, sizeof(uint16_t));
+			write_string(data, m_source);
+			write_value(data, m_segment.size(), sizeof(uint32_t));
+
+			for(index = 0, iter = m_segment.begin(); iter != m_segment.end(); ++index, ++iter) {
+				segment.insert(std::make_pair(iter->first, index));
+				write_string(data, iter->first);
+				write_value(data, iter->second.size(), sizeof(uint32_t));
+
+				for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+					write_value(data, block_iter->first, sizeof(uint16_t));
+					write_value(data, block_iter->second.size(), sizeof(uint32_t));
+					data.insert(data.end(), block_iter->second.begin(), block_iter->second.end());
+				}
+			}
+
+			write_value(data, m_symbol.size(), sizeof(uint32_t));
+
+			for(symbol_iter = m_symbol.begin(); symbol_iter != m_symbol.end(); ++symbol_iter) {
+				write_string(data, std::get<OBJECT_SYMBOL_NAME>(*symbol_iter));
+				write_value(data, std::get<OBJECT_SYMBOL_TYPE>(*symbol_iter), sizeof(uint8_t));
+				write_value(data, std::get<OBJECT_SYMBOL_VALUE>(*symbol_iter), sizeof(uint32_t));
+			}
+
+			write_value(data, m_relocation.size(), sizeof(uint32_t));
+
+			for(relocation_iter = m_relocation.begin(); relocation_iter != m_relocation.end(); ++relocation_iter) {
+				write_value(data, segment.at(std::get<OBJECT_RELOCATION_SEGMENT>(*relocation_iter)), sizeof(uint32_t));
+				write_value(data, std::get<OBJECT_RELOCATION_BLOCK>(*relocation_iter), sizeof(uint32_t));
+				write_value(data, std::get<OBJECT_RELOCATION_OFFSET>(*relocation_iter), sizeof(uint32_t));
+				write_value(data, std::get<OBJECT_RELOCATION_TYPE>(*relocation_iter), sizeof(uint8_t));
+				write_value(data, std::get<OBJECT_RELOCATION_SYMBOL>(*relocation_iter), sizeof(uint32_t));
+				write_value(data, std::get<OBJECT_RELOCATION_ADDEND>(*relocation_iter), sizeof(uint32_t));
+				write_value(data, std::get<OBJECT_RELOCATION_ROW>(*relocation_iter), sizeof(uint32_t));
+				write_value(data, std::get<OBJECT_RELOCATION_COLUMN>(*relocation_iter), sizeof(uint32_t));
+			}
+
+			cc65c::core::stream(data).write(output);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		object::write_string(
+			__inout std::vector<uint8_t> &data,
+			__in const std::string &value
+			)
+		{
+			write_value(data, value.size(), sizeof(uint32_t));
+			data.insert(data.end(), value.begin(), value.end());
+		}
+
+		void 
+		object::write_value(
+			__inout std::vector<uint8_t> &data,
+			__in uint32_t value,
+			__in size_t width
+			)
+		{
+			size_t index;
+
+			for(index = 0; index < width; ++index) {
+				data.push_back(value >> (index * 8));
+			}
+		}
+	}
+}
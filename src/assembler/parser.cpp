@@ -16,8 +16,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <fstream>
 #include "../../include/assembler/parser.h"
 #include "parser_type.h"
+#include "../../include/core/counter.h"
 #include "../../include/core/trace.h"
 
 namespace cc65c {
@@ -37,6 +40,11 @@ namespace cc65c {
 				cc65c::assembler::lexer::as_exception(_ROW_, _COLUMN_, _VERB_, EXCEPTION_TAB_COUNT)))
 
 		parser::parser(void) :
+			m_condition_closed(false),
+			m_condition_effect(0),
+			m_condition_unknown(0),
+			m_macro_expansion_hit(0),
+			m_macro_expansion_miss(0),
 			m_tree_position(0)
 		{
 			TRACE_ENTRY();
@@ -51,6 +59,11 @@ namespace cc65c {
 			__in_opt bool is_file
 			) :
 				cc65c::assembler::lexer(input, is_file),
+				m_condition_closed(false),
+				m_condition_effect(0),
+				m_condition_unknown(0),
+				m_macro_expansion_hit(0),
+				m_macro_expansion_miss(0),
 				m_tree_position(0)
 		{
 			TRACE_ENTRY();
@@ -64,6 +77,17 @@ namespace cc65c {
 			__in const parser &other
 			) :
 				cc65c::assembler::lexer(other),
+				m_condition_closed(other.m_condition_closed),
+				m_condition_effect(other.m_condition_effect),
+				m_condition_symbol(other.m_condition_symbol),
+				m_condition_unknown(other.m_condition_unknown),
+				m_macro(other.m_macro),
+				m_macro_active(other.m_macro_active),
+				m_macro_expansion(other.m_macro_expansion),
+				m_macro_expansion_hit(other.m_macro_expansion_hit),
+				m_macro_expansion_miss(other.m_macro_expansion_miss),
+				m_macro_include(other.m_macro_include),
+				m_macro_include_parent(other.m_macro_include_parent),
 				m_tree(other.m_tree),
 				m_tree_position(other.m_tree_position)
 		{
@@ -86,6 +110,17 @@ namespace cc65c {
 
 			if(this != &other) {
 				cc65c::assembler::lexer::operator=(other);
+				m_condition_closed = other.m_condition_closed;
+				m_condition_effect = other.m_condition_effect;
+				m_condition_symbol = other.m_condition_symbol;
+				m_condition_unknown = other.m_condition_unknown;
+				m_macro = other.m_macro;
+				m_macro_active = other.m_macro_active;
+				m_macro_expansion = other.m_macro_expansion;
+				m_macro_expansion_hit = other.m_macro_expansion_hit;
+				m_macro_expansion_miss = other.m_macro_expansion_miss;
+				m_macro_include = other.m_macro_include;
+				m_macro_include_parent = other.m_macro_include_parent;
 				m_tree = other.m_tree;
 				m_tree_position = other.m_tree_position;
 			}
@@ -174,6 +209,16 @@ namespace cc65c {
 			std::lock_guard<std::recursive_mutex> lock(m_parser_mutex);
 
 			cc65c::assembler::lexer::reset();
+			m_condition_closed = false;
+			m_condition_effect = 0;
+			m_condition_symbol.clear();
+			m_condition_unknown = 0;
+			m_macro.clear();
+			m_macro_active.clear();
+			m_macro_expansion.clear();
+			m_macro_expansion_hit = 0;
+			m_macro_expansion_miss = 0;
+			m_macro_include.clear();
 			m_tree.clear();
 			m_tree_position = 0;
 			m_tree.push_back(cc65c::assembler::tree(TREE_BEGIN));
@@ -182,6 +227,259 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		bool 
+		parser::compile_expression(
+			__inout cc65c::assembler::tree &tree,
+			__inout size_t &index,
+			__in const cc65c::assembler::expression_intern_t &intern,
+			__inout cc65c::assembler::expression_program_t &program
+			)
+		{
+			bool result;
+			size_t depth = 0;
+			std::vector<cc65c::assembler::expression_instruction_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			result = compile_expression_term(tree, index, intern, program);
+			if(result) {
+				std::vector<cc65c::assembler::expression_instruction_t> &code 
+					= std::get<EXPRESSION_PROGRAM_INSTRUCTION>(program);
+
+				for(iter = code.begin(); iter != code.end(); ++iter) {
+
+					switch(std::get<EXPRESSION_INSTRUCTION_OPERATION>(*iter)) {
+						case EXPRESSION_OPERATION_BASE:
+						case EXPRESSION_OPERATION_IDENTIFIER:
+						case EXPRESSION_OPERATION_POSITION:
+						case EXPRESSION_OPERATION_SCALAR:
+
+							if(++depth > std::get<EXPRESSION_PROGRAM_DEPTH>(program)) {
+								std::get<EXPRESSION_PROGRAM_DEPTH>(program) = depth;
+							}
+							break;
+						case EXPRESSION_OPERATION_HIGH:
+						case EXPRESSION_OPERATION_LITERAL:
+						case EXPRESSION_OPERATION_LOW:
+						case EXPRESSION_OPERATION_NOT_BINARY:
+						case EXPRESSION_OPERATION_NOT_LOGICAL:
+							break;
+						default:
+							--depth;
+							break;
+					}
+				}
+
+				std::get<EXPRESSION_PROGRAM_END>(program) = index;
+				code.shrink_to_fit();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		parser::compile_expression_factor(
+			__inout cc65c::assembler::tree &tree,
+			__in const cc65c::assembler::expression_intern_t &intern,
+			__inout cc65c::assembler::expression_program_t &program
+			)
+		{
+			bool result = true;
+			size_t position = 0;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::token tok = tree.token();
+			switch(tok.type()) {
+				case TOKEN_IDENTIFIER:
+					compile_expression_instruction(program, EXPRESSION_OPERATION_IDENTIFIER, tok, intern(tok.key()));
+
+					if(tree.node().size()) {
+						result = compile_expression_term(tree, position, intern, program);
+						compile_expression_instruction(program, EXPRESSION_OPERATION_ADDITION, tok);
+					}
+					break;
+				case TOKEN_KEYWORD_MACRO:
+					result = compile_expression_term(tree, position, intern, program);
+
+					switch(tok.subtype()) {
+						case KEYWORD_MACRO_BYTE:
+						case KEYWORD_MACRO_LOW:
+							compile_expression_instruction(program, EXPRESSION_OPERATION_LOW, tok);
+							break;
+						case KEYWORD_MACRO_HIGH:
+							compile_expression_instruction(program, EXPRESSION_OPERATION_HIGH, tok);
+							break;
+						case KEYWORD_MACRO_WORD:
+							result = (result && compile_expression_term(tree, position, intern, program));
+							compile_expression_instruction(program, EXPRESSION_OPERATION_WORD, tok);
+							break;
+						default:
+							result = false;
+							break;
+					}
+					break;
+				case TOKEN_LITERAL:
+
+					if(tree.node().size()) {
+						result = compile_expression_term(tree, position, intern, program);
+					} else {
+						compile_expression_instruction(program, EXPRESSION_OPERATION_SCALAR, tok);
+					}
+
+					compile_expression_instruction(program, EXPRESSION_OPERATION_LITERAL, tok, 
+						std::get<EXPRESSION_PROGRAM_KEY>(program).size());
+					std::get<EXPRESSION_PROGRAM_KEY>(program).push_back(tok.key());
+					break;
+				case TOKEN_OPERATOR_UNARY:
+					result = compile_expression_term(tree, position, intern, program);
+					compile_expression_instruction(program, (tok.subtype() == OPERATOR_UNARY_NOT_BINARY) ? 
+						EXPRESSION_OPERATION_NOT_BINARY : EXPRESSION_OPERATION_NOT_LOGICAL, tok);
+					break;
+				case TOKEN_SCALAR:
+					compile_expression_instruction(program, EXPRESSION_OPERATION_SCALAR, tok, tok.value());
+					break;
+				case TOKEN_SYMBOL_POSITION:
+					compile_expression_instruction(program, (tok.subtype() == SYMBOL_POSITION_BASE) ? 
+						EXPRESSION_OPERATION_BASE : EXPRESSION_OPERATION_POSITION, tok);
+					break;
+				default:
+					result = false;
+					break;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		parser::compile_expression_instruction(
+			__inout cc65c::assembler::expression_program_t &program,
+			__in cc65c::assembler::expression_operation_t operation,
+			__inout cc65c::assembler::token &tok,
+			__in_opt int32_t operand
+			)
+		{
+			TRACE_ENTRY();
+
+			std::get<EXPRESSION_PROGRAM_INSTRUCTION>(program).push_back(std::make_tuple(tok.column(), operand, 
+				operation, tok.row()));
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		parser::compile_expression_term(
+			__inout cc65c::assembler::tree &tree,
+			__inout size_t &index,
+			__in const cc65c::assembler::expression_intern_t &intern,
+			__inout cc65c::assembler::expression_program_t &program
+			)
+		{
+			size_t position;
+			bool result = false;
+			cc65c::assembler::expression_operation_t operation;
+
+			TRACE_ENTRY();
+
+			if(index < tree.node().size()) {
+				tree.move_child_index(index++);
+				result = compile_expression_factor(tree, intern, program);
+				tree.move_parent();
+			}
+
+			while(result && (index < tree.node().size())) {
+				tree.move_child_index(index);
+
+				cc65c::assembler::token tok = tree.token();
+				if(!tok.match(TOKEN_SYMBOL_ARITHMETIC) && !tok.match(TOKEN_OPERATOR_BINARY)) {
+					tree.move_parent();
+					break;
+				}
+
+				position = 0;
+				result = compile_expression_term(tree, position, intern, program);
+				tree.move_parent();
+				++index;
+
+				if(!result) {
+					break;
+				}
+
+				if(tok.match(TOKEN_SYMBOL_ARITHMETIC)) {
+
+					switch(tok.subtype()) {
+						case SYMBOL_ARITHMETIC_ADDITION:
+							operation = EXPRESSION_OPERATION_ADDITION;
+							break;
+						case SYMBOL_ARITHMETIC_AND:
+							operation = EXPRESSION_OPERATION_AND;
+							break;
+						case SYMBOL_ARITHMETIC_DIVISION:
+							operation = EXPRESSION_OPERATION_DIVISION;
+							break;
+						case SYMBOL_ARITHMETIC_MODULUS:
+							operation = EXPRESSION_OPERATION_MODULUS;
+							break;
+						case SYMBOL_ARITHMETIC_MULTIPLICATION:
+							operation = EXPRESSION_OPERATION_MULTIPLICATION;
+							break;
+						case SYMBOL_ARITHMETIC_OR:
+							operation = EXPRESSION_OPERATION_OR;
+							break;
+						case SYMBOL_ARITHMETIC_SUBTRACTION:
+							operation = EXPRESSION_OPERATION_SUBTRACTION;
+							break;
+						case SYMBOL_ARITHMETIC_XOR:
+							operation = EXPRESSION_OPERATION_XOR;
+							break;
+						default:
+							result = false;
+							break;
+					}
+				} else {
+
+					switch(tok.subtype()) {
+						case OPERATOR_BINARY_AND:
+							operation = EXPRESSION_OPERATION_AND_LOGICAL;
+							break;
+						case OPERATOR_BINARY_EQUAL:
+							operation = EXPRESSION_OPERATION_EQUAL;
+							break;
+						case OPERATOR_BINARY_GREATER_THAN:
+							operation = EXPRESSION_OPERATION_GREATER_THAN;
+							break;
+						case OPERATOR_BINARY_GREATER_THAN_EQUAL:
+							operation = EXPRESSION_OPERATION_GREATER_THAN_EQUAL;
+							break;
+						case OPERATOR_BINARY_LESS_THAN:
+							operation = EXPRESSION_OPERATION_LESS_THAN;
+							break;
+						case OPERATOR_BINARY_LESS_THAN_EQUAL:
+							operation = EXPRESSION_OPERATION_LESS_THAN_EQUAL;
+							break;
+						case OPERATOR_BINARY_NOT_EQUAL:
+							operation = EXPRESSION_OPERATION_NOT_EQUAL;
+							break;
+						case OPERATOR_BINARY_OR:
+							operation = EXPRESSION_OPERATION_OR_LOGICAL;
+							break;
+						default:
+							result = false;
+							break;
+					}
+				}
+
+				if(result) {
+					compile_expression_instruction(program, operation, tok);
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
 		size_t 
 		parser::enumerate(void)
 		{
@@ -205,12 +503,28 @@ namespace cc65c {
 		void 
 		parser::enumerate_tree(void)
 		{
-			cc65c::assembler::tree statement(TREE_STATEMENT);
+			std::vector<cc65c::assembler::tree> statement;
+			std::vector<cc65c::assembler::tree>::reverse_iterator iter;
 
 			TRACE_ENTRY();
 
-			enumerate_tree_statement(statement);
-			add_tree(statement);
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_PARSE);
+
+			while(cc65c::assembler::lexer::has_next() && statement.empty()) {
+
+				if(cc65c::assembler::lexer::match(TOKEN_KEYWORD_MACRO, KEYWORD_MACRO_BEGIN)) {
+					enumerate_tree_macro_define();
+				} else if(cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)) {
+					enumerate_tree_macro_user(statement);
+				} else {
+					statement.push_back(cc65c::assembler::tree(TREE_STATEMENT));
+					enumerate_tree_statement(statement.back());
+				}
+			}
+
+			for(iter = statement.rbegin(); iter != statement.rend(); ++iter) {
+				add_tree(*iter);
+			}
 
 			TRACE_EXIT();
 		}
@@ -370,7 +684,19 @@ namespace cc65c {
 
 			enumerate_tree_expression(tree);
 
-			if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
+			if(ADDRESS_MODE_RELATIVE_BIT_CONTAINS(type)) {
+
+				if(!cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_SEPERATOR, true);
+				}
+
+				if(!cc65c::assembler::lexer::has_next()) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_EXPRESSION, true);
+				}
+
+				cc65c::assembler::lexer::move_next();
+				enumerate_tree_expression(tree);
+			} else if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
 
 				if(!cc65c::assembler::lexer::has_next()) {
 					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_REGISTER, true);
@@ -553,6 +879,38 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		void 
+		parser::enumerate_tree_condition_branch(
+			__inout cc65c::assembler::tree &tree,
+			__in cc65c::assembler::condition_t condition,
+			__inout bool &unknown
+			)
+		{
+			TRACE_ENTRY();
+
+			++m_condition_effect;
+
+			switch(condition) {
+				case CONDITION_FALSE:
+					cc65c::assembler::lexer::skip_condition();
+					break;
+				case CONDITION_TRUE:
+					m_condition_unknown += (unknown ? 1 : 0);
+					enumerate_tree_statement_list(tree);
+					m_condition_unknown -= (unknown ? 1 : 0);
+					cc65c::assembler::lexer::skip_condition(true);
+					break;
+				default:
+					unknown = true;
+					++m_condition_unknown;
+					enumerate_tree_statement_list(tree);
+					--m_condition_unknown;
+					break;
+			}
+
+			TRACE_EXIT();
+		}
+
 		void 
 		parser::enumerate_tree_condition_expression(
 			__inout cc65c::assembler::tree &tree
@@ -596,6 +954,7 @@ namespace cc65c {
 		{
 			bool move;
 			size_t index;
+			bool unknown = false;
 
 			TRACE_ENTRY();
 
@@ -617,7 +976,7 @@ namespace cc65c {
 			}
 
 			enumerate_tree_condition_expression(tree);
-			enumerate_tree_statement_list(tree);
+			enumerate_tree_condition_branch(tree, evaluate_condition(tree), unknown);
 
 			while(cc65c::assembler::lexer::match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE_IF)) {
 				index = tree.add(cc65c::assembler::lexer::token());
@@ -629,7 +988,7 @@ namespace cc65c {
 				cc65c::assembler::lexer::move_next();
 				tree.move_child_index(index);
 				enumerate_tree_condition_expression(tree);
-				enumerate_tree_statement_list(tree);
+				enumerate_tree_condition_branch(tree, evaluate_condition(tree), unknown);
 				tree.move_parent();
 			}
 
@@ -642,7 +1001,7 @@ namespace cc65c {
 
 				cc65c::assembler::lexer::move_next();
 				tree.move_child_index(index);
-				enumerate_tree_statement_list(tree);
+				enumerate_tree_condition_branch(tree, CONDITION_TRUE, unknown);
 				tree.move_parent();
 			}
 
@@ -668,6 +1027,9 @@ namespace cc65c {
 		{
 			bool move;
 			size_t index;
+			std::string name;
+			bool unknown = false;
+			cc65c::assembler::condition_t condition;
 
 			TRACE_ENTRY();
 
@@ -692,14 +1054,21 @@ namespace cc65c {
 				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
 			}
 
+			name = cc65c::assembler::lexer::token().key();
 			tree.add(cc65c::assembler::lexer::token());
 
 			if(!cc65c::assembler::lexer::has_next()) {
 				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_IF_DEFINE, true);
 			}
 
+			condition = evaluate_condition_define(name);
+
+			if(condition == CONDITION_FALSE) {
+				cc65c::assembler::lexer::skip_condition_next();
+			}
+
 			cc65c::assembler::lexer::move_next();
-			enumerate_tree_statement_list(tree);
+			enumerate_tree_condition_branch(tree, condition, unknown);
 
 			while(cc65c::assembler::lexer::match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_ELSE_IF_DEFINE)) {
 				index = tree.add(cc65c::assembler::lexer::token());
@@ -715,14 +1084,21 @@ namespace cc65c {
 					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
 				}
 
+				name = cc65c::assembler::lexer::token().key();
 				tree.add(cc65c::assembler::lexer::token());
 
 				if(!cc65c::assembler::lexer::has_next()) {
 					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_IF_DEFINE, true);
 				}
 
+				condition = evaluate_condition_define(name);
+
+				if(condition == CONDITION_FALSE) {
+					cc65c::assembler::lexer::skip_condition_next();
+				}
+
 				cc65c::assembler::lexer::move_next();
-				enumerate_tree_statement_list(tree);
+				enumerate_tree_condition_branch(tree, condition, unknown);
 				tree.move_parent();
 			}
 
@@ -735,7 +1111,7 @@ namespace cc65c {
 
 				cc65c::assembler::lexer::move_next();
 				tree.move_child_index(index);
-				enumerate_tree_statement_list(tree);
+				enumerate_tree_condition_branch(tree, CONDITION_TRUE, unknown);
 				tree.move_parent();
 			}
 
@@ -759,9 +1135,11 @@ namespace cc65c {
 			__inout cc65c::assembler::tree &tree
 			)
 		{
-			size_t index = 0;
+			std::string name;
 			uint32_t subtype;
-			bool move = false;
+			int32_t value = 0;
+			size_t index = 0, position;
+			bool move = false, resolved;
 
 			TRACE_ENTRY();
 
@@ -806,6 +1184,7 @@ namespace cc65c {
 						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
 					}
 
+					name = cc65c::assembler::lexer::token().key();
 					tree.add(cc65c::assembler::lexer::token());
 
 					if(!cc65c::assembler::lexer::has_next()) {
@@ -814,6 +1193,9 @@ namespace cc65c {
 
 					cc65c::assembler::lexer::move_next();
 					enumerate_tree_expression(tree);
+					position = 1;
+					resolved = evaluate_expression(tree, position, value);
+					update_condition(name, CONDITION_TRUE, resolved, value);
 					break;
 				case KEYWORD_DEFINE_ORIGIN:
 					enumerate_tree_expression(tree);
@@ -839,6 +1221,10 @@ namespace cc65c {
 						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
 					}
 
+					if(subtype == KEYWORD_DEFINE_UNDEFINE) {
+						update_condition(cc65c::assembler::lexer::token().key(), CONDITION_FALSE);
+					}
+
 					tree.add(cc65c::assembler::lexer::token());
 
 					if(cc65c::assembler::lexer::has_next()) {
@@ -1196,6 +1582,7 @@ namespace cc65c {
 		{
 			bool move;
 			size_t index;
+			uint32_t subtype;
 
 			TRACE_ENTRY();
 
@@ -1203,6 +1590,13 @@ namespace cc65c {
 				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_INCLUDE, true);
 			}
 
+			subtype = cc65c::assembler::lexer::token().subtype();
+			if(subtype == KEYWORD_INCLUDE_SOURCE) {
+				m_condition_closed = false;
+				++m_condition_effect;
+				m_condition_symbol.clear();
+			}
+
 			move = (tree.size() > 0);
 			index = tree.add(cc65c::assembler::lexer::token());
 
@@ -1222,10 +1616,34 @@ namespace cc65c {
 
 			tree.add(cc65c::assembler::lexer::token());
 
+			if(subtype == KEYWORD_INCLUDE_SOURCE) {
+				enumerate_tree_include_macro(cc65c::assembler::lexer::token().key());
+			}
+
 			if(cc65c::assembler::lexer::has_next()) {
 				cc65c::assembler::lexer::move_next();
 			}
 
+			if((subtype == KEYWORD_INCLUDE_BINARY) && cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
+
+				if(!cc65c::assembler::lexer::has_next()) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_EXPRESSION, true);
+				}
+
+				cc65c::assembler::lexer::move_next();
+				enumerate_tree_expression(tree);
+
+				if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
+
+					if(!cc65c::assembler::lexer::has_next()) {
+						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_EXPRESSION, true);
+					}
+
+					cc65c::assembler::lexer::move_next();
+					enumerate_tree_expression(tree);
+				}
+			}
+
 			if(move) {
 				tree.move_parent();
 			}
@@ -1233,6 +1651,43 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		void 
+		parser::enumerate_tree_include_macro(
+			__in const std::string &path
+			)
+		{
+			std::map<std::string, cc65c::assembler::macro_metadata_t>::iterator iter, macro_iter;
+
+			TRACE_ENTRY();
+
+			if((path != cc65c::assembler::stream::path())
+					&& (m_macro_include.find(path) == m_macro_include.end())
+					&& (m_macro_include_parent.find(path) == m_macro_include_parent.end())
+					&& std::ifstream(path.c_str(), std::ios::binary | std::ios::in)) {
+				cc65c::assembler::parser input(path, true);
+
+				input.m_macro_include_parent = m_macro_include_parent;
+				input.m_macro_include_parent.insert(cc65c::assembler::stream::path());
+				input.enumerate();
+
+				for(iter = input.m_macro.begin(); iter != input.m_macro.end(); ++iter) {
+
+					macro_iter = m_macro.find(iter->first);
+					if(macro_iter == m_macro.end()) {
+						m_macro.insert(*iter);
+					} else if(std::get<MACRO_METADATA_PATH>(macro_iter->second) 
+							!= std::get<MACRO_METADATA_PATH>(iter->second)) {
+						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_DUPLICATE_MACRO, true);
+					}
+				}
+
+				m_macro_include.insert(input.m_macro_include.begin(), input.m_macro_include.end());
+				m_macro_include.insert(path);
+			}
+
+			TRACE_EXIT();
+		}
+
 		void 
 		parser::enumerate_tree_label(
 			__inout cc65c::assembler::tree &tree
@@ -1244,6 +1699,7 @@ namespace cc65c {
 				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_LABEL, true);
 			}
 
+			update_condition(cc65c::assembler::lexer::token().key(), CONDITION_TRUE);
 			tree.add(cc65c::assembler::lexer::token());
 
 			if(cc65c::assembler::lexer::has_next()) {
@@ -1340,6 +1796,289 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		void 
+		parser::enumerate_tree_macro_define(void)
+		{
+			std::string name;
+			cc65c::assembler::macro_metadata_t entry;
+
+			TRACE_ENTRY();
+
+			if(!cc65c::assembler::lexer::match(TOKEN_KEYWORD_MACRO, KEYWORD_MACRO_BEGIN)) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_MACRO, true);
+			}
+
+			if(!cc65c::assembler::lexer::has_next()) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
+			}
+
+			cc65c::assembler::lexer::move_next();
+
+			if(!cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
+			}
+
+			name = cc65c::assembler::lexer::token().key();
+			if(m_macro.find(name) != m_macro.end()) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_DUPLICATE_MACRO, true);
+			}
+
+			if(!cc65c::assembler::lexer::has_next()) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_MACRO, true);
+			}
+
+			cc65c::assembler::lexer::move_next();
+
+			if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_BRACKET, SYMBOL_BRACKET_OPEN)) {
+
+				if(!cc65c::assembler::lexer::has_next()) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACKET, true);
+				}
+
+				cc65c::assembler::lexer::move_next();
+
+				while(!cc65c::assembler::lexer::match(TOKEN_SYMBOL_BRACKET, SYMBOL_BRACKET_CLOSE)) {
+
+					if(!cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)) {
+						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
+					}
+
+					std::get<MACRO_METADATA_PARAMETER>(entry).push_back(cc65c::assembler::lexer::token().key());
+
+					if(!cc65c::assembler::lexer::has_next()) {
+						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACKET, true);
+					}
+
+					cc65c::assembler::lexer::move_next();
+
+					if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
+
+						if(!cc65c::assembler::lexer::has_next()) {
+							THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
+						}
+
+						cc65c::assembler::lexer::move_next();
+					} else if(!cc65c::assembler::lexer::match(TOKEN_SYMBOL_BRACKET, SYMBOL_BRACKET_CLOSE)) {
+						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACKET, true);
+					}
+				}
+
+				if(!cc65c::assembler::lexer::has_next()) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_MACRO, true);
+				}
+
+				cc65c::assembler::lexer::move_next();
+			}
+
+			while(!cc65c::assembler::lexer::match(TOKEN_KEYWORD_MACRO, KEYWORD_MACRO_END)) {
+
+				if(!cc65c::assembler::lexer::has_next()
+						|| cc65c::assembler::lexer::match(TOKEN_KEYWORD_MACRO, KEYWORD_MACRO_BEGIN)) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_MACRO, true);
+				}
+
+				std::get<MACRO_METADATA_TEMPLATE>(entry).push_back(cc65c::assembler::lexer::token());
+				cc65c::assembler::lexer::move_next();
+			}
+
+			if(cc65c::assembler::lexer::has_next()) {
+				cc65c::assembler::lexer::move_next();
+			}
+
+			std::get<MACRO_METADATA_PATH>(entry) = cc65c::assembler::stream::path();
+			m_macro.insert(std::make_pair(name, entry));
+
+			TRACE_EXIT();
+		}
+
+		void 
+		parser::enumerate_tree_macro_user(
+			__inout std::vector<cc65c::assembler::tree> &statement
+			)
+		{
+			std::string name;
+			size_t begin, effect;
+			std::stringstream key;
+			bool template_saved;
+			size_t position_saved;
+			cc65c::core::stream_t column, row;
+			std::vector<cc65c::assembler::token> expansion;
+			std::vector<std::vector<cc65c::assembler::token>> argument;
+			std::vector<std::string>::const_iterator parameter_iter;
+			std::vector<cc65c::assembler::token>::iterator token_iter;
+			std::map<std::string, cc65c::assembler::macro_metadata_t>::iterator iter;
+			std::map<std::string, std::vector<cc65c::assembler::tree>>::iterator expansion_iter;
+			std::vector<std::vector<cc65c::assembler::token>>::iterator argument_iter;
+
+			TRACE_ENTRY();
+
+			if(!cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_IDENTIFIER, true);
+			}
+
+			name = cc65c::assembler::lexer::token().key();
+			row = cc65c::assembler::lexer::token().row();
+			column = cc65c::assembler::lexer::token().column();
+
+			iter = m_macro.find(name);
+			if(iter == m_macro.end()) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNDEFINED_MACRO, true);
+			}
+
+			if(m_macro_active.find(name) != m_macro_active.end()) {
+				THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_RECURSIVE_MACRO, true);
+			}
+
+			if(cc65c::assembler::lexer::has_next()) {
+				cc65c::assembler::lexer::move_next();
+			}
+
+			if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_BRACKET, SYMBOL_BRACKET_OPEN)) {
+
+				if(!cc65c::assembler::lexer::has_next()) {
+					THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACKET, true);
+				}
+
+				cc65c::assembler::lexer::move_next();
+
+				while(!cc65c::assembler::lexer::match(TOKEN_SYMBOL_BRACKET, SYMBOL_BRACKET_CLOSE)) {
+					cc65c::assembler::tree scratch;
+
+					begin = m_token_position;
+					enumerate_tree_expression(scratch);
+					argument.push_back(std::vector<cc65c::assembler::token>(m_token.begin() + begin, 
+						m_token.begin() + m_token_position));
+
+					if(cc65c::assembler::lexer::match(TOKEN_SYMBOL_SEPERATOR)) {
+
+						if(!cc65c::assembler::lexer::has_next()) {
+							THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_EXPRESSION, true);
+						}
+
+						cc65c::assembler::lexer::move_next();
+					} else if(!cc65c::assembler::lexer::match(TOKEN_SYMBOL_BRACKET, SYMBOL_BRACKET_CLOSE)) {
+						THROW_LEXER_EXCEPTION(CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACKET, true);
+					}
+				}
+
+				if(cc65c::assembler::lexer::has_next()) {
+					cc65c::assembler::lexer::move_next();
+				}
+			}
+
+			if(argument.size() != std::get<MACRO_METADATA_PARAMETER>(iter->second).size()) {
+				THROW_LEXER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_MACRO_ARGUMENT, 
+					row, column, true);
+			}
+
+			key << std::get<MACRO_METADATA_PATH>(iter->second).size() << ":" << std::get<MACRO_METADATA_PATH>(iter->second)
+				<< ":" << name;
+
+			for(argument_iter = argument.begin(); argument_iter != argument.end(); ++argument_iter) {
+				key << "(";
+
+				for(token_iter = argument_iter->begin(); token_iter != argument_iter->end(); ++token_iter) {
+					key << " " << token_iter->type() << ":" << token_iter->subtype();
+
+					switch(token_iter->type()) {
+						case TOKEN_IDENTIFIER:
+						case TOKEN_LABEL:
+						case TOKEN_LITERAL:
+							key << ":" << token_iter->key().size() << ":" << token_iter->key();
+							break;
+						case TOKEN_SCALAR:
+							key << ":" << token_iter->value();
+							break;
+						default:
+							break;
+					}
+				}
+
+				key << ")";
+			}
+
+			expansion_iter = m_macro_expansion.find(key.str());
+			if(expansion_iter != m_macro_expansion.end()) {
+				++m_macro_expansion_hit;
+				statement.insert(statement.end(), expansion_iter->second.begin(), expansion_iter->second.end());
+			} else {
+				++m_macro_expansion_miss;
+				expansion.push_back(cc65c::assembler::token(TOKEN_BEGIN, SUBTYPE_UNDEFINED, row, column));
+
+				for(token_iter = std::get<MACRO_METADATA_TEMPLATE>(iter->second).begin(); 
+						token_iter != std::get<MACRO_METADATA_TEMPLATE>(iter->second).end(); ++token_iter) {
+
+					if(token_iter->type() == TOKEN_IDENTIFIER) {
+						parameter_iter = std::find(std::get<MACRO_METADATA_PARAMETER>(iter->second).begin(), 
+							std::get<MACRO_METADATA_PARAMETER>(iter->second).end(), token_iter->key());
+
+						if(parameter_iter != std::get<MACRO_METADATA_PARAMETER>(iter->second).end()) {
+							argument_iter = argument.begin() 
+								+ (parameter_iter - std::get<MACRO_METADATA_PARAMETER>(iter->second).begin());
+
+							if(argument_iter->size() > 1) {
+								expansion.push_back(cc65c::assembler::token(TOKEN_SYMBOL_BRACKET, 
+									SYMBOL_BRACKET_OPEN, token_iter->row(), token_iter->column()));
+								expansion.insert(expansion.end(), argument_iter->begin(), argument_iter->end());
+								expansion.push_back(cc65c::assembler::token(TOKEN_SYMBOL_BRACKET, 
+									SYMBOL_BRACKET_CLOSE, token_iter->row(), token_iter->column()));
+							} else {
+								expansion.insert(expansion.end(), argument_iter->begin(), argument_iter->end());
+							}
+
+							continue;
+						}
+					}
+
+					expansion.push_back(*token_iter);
+				}
+
+				expansion.push_back(cc65c::assembler::token(TOKEN_END, SUBTYPE_UNDEFINED, row, column));
+				m_token.swap(expansion);
+				position_saved = m_token_position;
+				template_saved = m_token_template;
+				m_token_position = 0;
+				m_token_template = true;
+				m_macro_active.insert(name);
+				effect = m_condition_effect;
+				expansion_iter = m_macro_expansion.insert(std::make_pair(key.str(), 
+					std::vector<cc65c::assembler::tree>())).first;
+
+				try {
+					cc65c::assembler::lexer::move_next();
+
+					while(cc65c::assembler::lexer::has_next()) {
+
+						if(cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)) {
+							enumerate_tree_macro_user(expansion_iter->second);
+						} else {
+							expansion_iter->second.push_back(cc65c::assembler::tree(TREE_STATEMENT));
+							enumerate_tree_statement(expansion_iter->second.back());
+						}
+					}
+				} catch(...) {
+					m_macro_expansion.erase(expansion_iter);
+					m_macro_active.erase(name);
+					m_token.swap(expansion);
+					m_token_position = position_saved;
+					m_token_template = template_saved;
+					throw;
+				}
+
+				m_macro_active.erase(name);
+				m_token.swap(expansion);
+				m_token_position = position_saved;
+				m_token_template = template_saved;
+				statement.insert(statement.end(), expansion_iter->second.begin(), expansion_iter->second.end());
+
+				if(effect != m_condition_effect) {
+					m_macro_expansion.erase(expansion_iter);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		void 
 		parser::enumerate_tree_statement(
 			__inout cc65c::assembler::tree &tree
@@ -1376,20 +2115,285 @@ namespace cc65c {
 			__inout cc65c::assembler::tree &tree
 			)
 		{
+			std::vector<cc65c::assembler::tree> statement;
+			std::vector<cc65c::assembler::tree>::iterator iter;
+
 			TRACE_ENTRY();
 
-			while(cc65c::assembler::lexer::match(TOKEN_KEYWORD_COMMAND)
+			while(cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)
+					|| cc65c::assembler::lexer::match(TOKEN_KEYWORD_COMMAND)
 					|| cc65c::assembler::lexer::match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_IF)
 					|| cc65c::assembler::lexer::match(TOKEN_KEYWORD_CONDITION, KEYWORD_CONDITION_IF_DEFINE)
 					|| cc65c::assembler::lexer::match(TOKEN_KEYWORD_DEFINE)
 					|| cc65c::assembler::lexer::match(TOKEN_KEYWORD_INCLUDE)
 					|| cc65c::assembler::lexer::match(TOKEN_LABEL)) {
-				enumerate_tree_statement(tree);
+
+				if(cc65c::assembler::lexer::match(TOKEN_IDENTIFIER)) {
+					statement.clear();
+					enumerate_tree_macro_user(statement);
+
+					for(iter = statement.begin(); iter != statement.end(); ++iter) {
+						tree.add(*iter);
+					}
+				} else {
+					enumerate_tree_statement(tree);
+				}
 			}
 
 			TRACE_EXIT();
 		}
 
+		cc65c::assembler::condition_t 
+		parser::evaluate_condition(
+			__inout cc65c::assembler::tree &tree
+			)
+		{
+			int32_t value = 0;
+			size_t position = 0;
+			cc65c::assembler::condition_t result = CONDITION_UNKNOWN;
+
+			TRACE_ENTRY();
+
+			if(evaluate_expression(tree, position, value)) {
+				result = (value ? CONDITION_TRUE : CONDITION_FALSE);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		cc65c::assembler::condition_t 
+		parser::evaluate_condition_define(
+			__in const std::string &name
+			)
+		{
+			cc65c::assembler::condition_t result;
+			std::map<std::string, cc65c::assembler::condition_symbol_t>::iterator iter;
+
+			TRACE_ENTRY();
+
+			iter = m_condition_symbol.find(name);
+			if(iter != m_condition_symbol.end()) {
+				result = std::get<CONDITION_SYMBOL_DEFINED>(iter->second);
+			} else {
+				result = (m_condition_closed ? CONDITION_FALSE : CONDITION_UNKNOWN);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		parser::evaluate_expression(
+			__inout cc65c::assembler::tree &tree,
+			__inout size_t &index,
+			__inout int32_t &result
+			)
+		{
+			bool resolved = false;
+			std::vector<std::string> key;
+			size_t fault = EXPRESSION_FAULT_NONE;
+			cc65c::assembler::expression_program_t program;
+
+			TRACE_ENTRY();
+
+			cc65c::assembler::expression_intern_t intern = [&key](const std::string &name) {
+					key.push_back(name);
+					return (int32_t) (key.size() - 1);
+				};
+
+			cc65c::assembler::expression_lookup_t lookup = [this, &key](cc65c::assembler::expression_operation_t operation, 
+					int32_t operand, int32_t &value) {
+					std::map<std::string, cc65c::assembler::condition_symbol_t>::iterator iter;
+
+					if(operation != EXPRESSION_OPERATION_IDENTIFIER) {
+						return false;
+					}
+
+					iter = m_condition_symbol.find(key.at(operand));
+					if((iter == m_condition_symbol.end()) 
+							|| (std::get<CONDITION_SYMBOL_DEFINED>(iter->second) != CONDITION_TRUE)
+							|| !std::get<CONDITION_SYMBOL_RESOLVED>(iter->second)) {
+						return false;
+					}
+
+					value = std::get<CONDITION_SYMBOL_VALUE>(iter->second);
+					return true;
+				};
+
+			if(compile_expression(tree, index, intern, program)) {
+				resolved = (evaluate_expression(program, lookup, result, fault) && (fault == EXPRESSION_FAULT_NONE));
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x, Value=%i", resolved, result);
+			return resolved;
+		}
+
+		bool 
+		parser::evaluate_expression(
+			__in const cc65c::assembler::expression_program_t &program,
+			__in const cc65c::assembler::expression_lookup_t &lookup,
+			__inout int32_t &result,
+			__inout size_t &fault
+			)
+		{
+			int32_t *stack;
+			size_t top = 0;
+			bool resolved = true;
+			int32_t operand, right;
+			cc65c::assembler::expression_operation_t operation;
+			std::vector<cc65c::assembler::expression_instruction_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			const std::vector<cc65c::assembler::expression_instruction_t> &code 
+				= std::get<EXPRESSION_PROGRAM_INSTRUCTION>(program);
+			const std::vector<std::string> &key = std::get<EXPRESSION_PROGRAM_KEY>(program);
+
+			if(m_expression_stack.size() < std::get<EXPRESSION_PROGRAM_DEPTH>(program)) {
+				m_expression_stack.resize(std::get<EXPRESSION_PROGRAM_DEPTH>(program));
+			}
+
+			fault = EXPRESSION_FAULT_NONE;
+			stack = m_expression_stack.data();
+
+			for(iter = code.begin(); iter != code.end(); ++iter) {
+				operand = std::get<EXPRESSION_INSTRUCTION_OPERAND>(*iter);
+				operation = (cc65c::assembler::expression_operation_t) std::get<EXPRESSION_INSTRUCTION_OPERATION>(*iter);
+
+				switch(operation) {
+					case EXPRESSION_OPERATION_ADDITION:
+						right = stack[--top];
+						stack[top - 1] += right;
+						break;
+					case EXPRESSION_OPERATION_AND:
+						right = stack[--top];
+						stack[top - 1] &= right;
+						break;
+					case EXPRESSION_OPERATION_AND_LOGICAL:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] && right);
+						break;
+					case EXPRESSION_OPERATION_BASE:
+					case EXPRESSION_OPERATION_IDENTIFIER:
+					case EXPRESSION_OPERATION_POSITION:
+
+						if(!lookup(operation, operand, stack[top])) {
+							stack[top] = 0;
+							resolved = false;
+						}
+
+						++top;
+						break;
+					case EXPRESSION_OPERATION_DIVISION:
+					case EXPRESSION_OPERATION_MODULUS:
+						right = stack[--top];
+
+						if(!right) {
+
+							if(fault == EXPRESSION_FAULT_NONE) {
+								fault = (iter - code.begin());
+							}
+
+							stack[top - 1] = 0;
+						} else if(operation == EXPRESSION_OPERATION_DIVISION) {
+							stack[top - 1] /= right;
+						} else {
+							stack[top - 1] %= right;
+						}
+						break;
+					case EXPRESSION_OPERATION_EQUAL:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] == right);
+						break;
+					case EXPRESSION_OPERATION_GREATER_THAN:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] > right);
+						break;
+					case EXPRESSION_OPERATION_GREATER_THAN_EQUAL:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] >= right);
+						break;
+					case EXPRESSION_OPERATION_HIGH:
+						stack[top - 1] = ((stack[top - 1] >> 8) & UINT8_MAX);
+						break;
+					case EXPRESSION_OPERATION_LESS_THAN:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] < right);
+						break;
+					case EXPRESSION_OPERATION_LESS_THAN_EQUAL:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] <= right);
+						break;
+					case EXPRESSION_OPERATION_LITERAL:
+						right = stack[top - 1];
+
+						if((right < 0) || (((size_t) right) >= key.at(operand).size())) {
+
+							if(fault == EXPRESSION_FAULT_NONE) {
+								fault = (iter - code.begin());
+							}
+
+							stack[top - 1] = 0;
+						} else {
+							stack[top - 1] = (uint8_t) key.at(operand).at(right);
+						}
+						break;
+					case EXPRESSION_OPERATION_LOW:
+						stack[top - 1] &= UINT8_MAX;
+						break;
+					case EXPRESSION_OPERATION_MULTIPLICATION:
+						right = stack[--top];
+						stack[top - 1] *= right;
+						break;
+					case EXPRESSION_OPERATION_NOT_BINARY:
+						stack[top - 1] = ~stack[top - 1];
+						break;
+					case EXPRESSION_OPERATION_NOT_EQUAL:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] != right);
+						break;
+					case EXPRESSION_OPERATION_NOT_LOGICAL:
+						stack[top - 1] = !stack[top - 1];
+						break;
+					case EXPRESSION_OPERATION_OR:
+						right = stack[--top];
+						stack[top - 1] |= right;
+						break;
+					case EXPRESSION_OPERATION_OR_LOGICAL:
+						right = stack[--top];
+						stack[top - 1] = (stack[top - 1] || right);
+						break;
+					case EXPRESSION_OPERATION_SCALAR:
+						stack[top++] = operand;
+						break;
+					case EXPRESSION_OPERATION_SUBTRACTION:
+						right = stack[--top];
+						stack[top - 1] -= right;
+						break;
+					case EXPRESSION_OPERATION_WORD:
+						right = stack[--top];
+						stack[top - 1] = (((stack[top - 1] & UINT8_MAX) << 8) | (right & UINT8_MAX));
+						break;
+					case EXPRESSION_OPERATION_XOR:
+						right = stack[--top];
+						stack[top - 1] ^= right;
+						break;
+					default:
+
+						if(fault == EXPRESSION_FAULT_NONE) {
+							fault = (iter - code.begin());
+						}
+						break;
+				}
+			}
+
+			result = (top ? stack[0] : 0);
+
+			TRACE_EXIT_FORMAT("Result=%x, Value=%i", resolved, result);
+			return resolved;
+		}
+
 		bool 
 		parser::has_next(void)
 		{
@@ -1420,6 +2424,51 @@ namespace cc65c {
 			return result;
 		}
 
+		size_t 
+		parser::macro_expansion_hit(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_parser_mutex);
+
+			result = m_macro_expansion_hit;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		size_t 
+		parser::macro_expansion_miss(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_parser_mutex);
+
+			result = m_macro_expansion_miss;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::set<std::string> 
+		parser::macro_include(void)
+		{
+			std::set<std::string> result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_parser_mutex);
+
+			result = m_macro_include;
+
+			TRACE_EXIT_FORMAT("Result[%u]", result.size());
+			return result;
+		}
+
 		bool 
 		parser::match(
 			__in cc65c::assembler::tree_t type
@@ -1454,7 +2503,7 @@ namespace cc65c {
 			}
 
 			if(cc65c::assembler::lexer::has_next() 
-					&& (m_tree_position <= (m_tree.size() - TREE_SENTINEL_COUNT))) {
+					&& (m_tree_position == (m_tree.size() - TREE_SENTINEL_COUNT))) {
 				enumerate_tree();
 			}
 
@@ -1544,6 +2593,30 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		void 
+		parser::set_condition(
+			__in const std::map<std::string, int32_t> &define
+			)
+		{
+			std::map<std::string, int32_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_parser_mutex);
+
+			if(!m_tree_position && (m_tree.size() == TREE_SENTINEL_COUNT)) {
+				m_condition_closed = true;
+				m_condition_symbol.clear();
+
+				for(iter = define.begin(); iter != define.end(); ++iter) {
+					m_condition_symbol[iter->first] = cc65c::assembler::condition_symbol_t(CONDITION_TRUE, true, 
+						iter->second);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		size_t 
 		parser::size(void)
 		{
@@ -1578,6 +2651,27 @@ namespace cc65c {
 			return result;
 		}
 
+		void 
+		parser::update_condition(
+			__in const std::string &name,
+			__in cc65c::assembler::condition_t defined,
+			__in_opt bool resolved,
+			__in_opt int32_t value
+			)
+		{
+			TRACE_ENTRY();
+
+			++m_condition_effect;
+
+			if(m_condition_unknown) {
+				m_condition_symbol[name] = cc65c::assembler::condition_symbol_t(CONDITION_UNKNOWN, false, 0);
+			} else {
+				m_condition_symbol[name] = cc65c::assembler::condition_symbol_t(defined, resolved, value);
+			}
+
+			TRACE_EXIT();
+		}
+
 		cc65c::assembler::tree &
 		parser::tree(void)
 		{
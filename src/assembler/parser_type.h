@@ -34,7 +34,8 @@ namespace cc65c {
 #endif // NDEBUG
 
 		enum {
-			CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_ACCUMULATOR = 0,
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_DUPLICATE_MACRO = 0,
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_ACCUMULATOR,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_BRACE,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_BRACKET,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_EXPECTING_COMMAND,
@@ -57,10 +58,13 @@ namespace cc65c {
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_CONDITION,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_DEFINE,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_MACRO,
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_MACRO_ARGUMENT,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_MODE,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_INVALID_REGISTER,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_NO_NEXT_TREE,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_NO_PREVIOUS_TREE,
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_RECURSIVE_MACRO,
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_UNDEFINED_MACRO,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACE,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_BRACKET,
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_DEFINE,
@@ -73,6 +77,7 @@ namespace cc65c {
 		#define CC65C_ASSEMBLER_PARSER_EXCEPTION_MAX CC65C_ASSEMBLER_PARSER_EXCEPTION_UNTERMINATED_MACRO
 
 		static const std::string CC65C_ASSEMBLER_PARSER_EXCEPTION_STR[] = {
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Duplicate macro",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Expecting accumulator",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Expecting brace",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Expecting bracket",
@@ -96,10 +101,13 @@ namespace cc65c {
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Invalid condition",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Invalid define",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Invalid macro",
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Invalid macro argument count",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Invalid addressing mode",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Invalid register",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "No next tree in stream",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "No previous tree in stream",
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Recursive macro expansion",
+			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Undefined macro",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Unterminated brace",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Unterminated bracket",
 			CC65C_ASSEMBLER_PARSER_EXCEPTION_HEADER "Unterminated define",
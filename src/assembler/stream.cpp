@@ -18,6 +18,7 @@
 
 #include "../../include/assembler/stream.h"
 #include "stream_type.h"
+#include "../../include/core/counter.h"
 #include "../../include/core/trace.h"
 
 namespace cc65c {
@@ -434,6 +435,23 @@ namespace cc65c {
 			return iter->second;
 		}
 
+		const std::string &
+		stream::line(
+			__in cc65c::core::stream_t row
+			)
+		{
+			std::map<cc65c::core::stream_t, std::string>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_stream_mutex);
+
+			iter = find(row);
+
+			TRACE_EXIT_FORMAT("Result[%u]=\"%s\"", iter->second.size(), STRING_CHECK(iter->second));
+			return iter->second;
+		}
+
 		bool 
 		stream::match(
 			__in cc65c::assembler::character_t type
@@ -658,6 +676,7 @@ namespace cc65c {
 			TRACE_ENTRY();
 
 			std::lock_guard<std::recursive_mutex> lock(m_stream_mutex);
+			cc65c::core::counter_scope scope(cc65c::core::COUNTER_PHASE_STREAM);
 
 			clear();
 
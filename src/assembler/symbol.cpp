@@ -269,6 +269,7 @@ namespace cc65c {
 			*reference_child = node_child;
 			m_node.insert(std::make_pair(id, std::make_pair(std::make_tuple(reference_id, reference_parent, reference_child), 
 				REFERENCE_INIT)));
+			hold(id);
 
 			TRACE_EXIT();
 		}
@@ -314,6 +315,7 @@ namespace cc65c {
 
 			m_token.insert(std::make_pair(id, std::make_pair(std::make_tuple(column, reference_key, row, subtype, type, 
 				reference_value), REFERENCE_INIT)));
+			hold(id);
 
 			TRACE_EXIT();
 		}
@@ -396,6 +398,8 @@ namespace cc65c {
 				std::get<NODE_METADATA_CHILD>(entry->second.first) = nullptr;
 			}
 
+			release(entry->first);
+
 			TRACE_EXIT();
 		}
 
@@ -416,6 +420,8 @@ namespace cc65c {
 				std::get<TOKEN_METADATA_VALUE>(entry->second.first) = nullptr;
 			}
 
+			release(entry->first);
+
 			TRACE_EXIT();
 		}
 
@@ -553,6 +559,21 @@ namespace cc65c {
 			TRACE_EXIT();
 		}
 
+		void 
+		symbol::hold(
+			__in cc65c::core::uuid_t id
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::core::uuid &instance = cc65c::core::uuid::acquire();
+			if(instance.is_initialized() && instance.contains(id)) {
+				instance.increment(id);
+			}
+
+			TRACE_EXIT();
+		}
+
 		size_t 
 		symbol::increment_node(
 			__in cc65c::core::uuid_t id
@@ -663,6 +684,21 @@ namespace cc65c {
 			return result;
 		}
 
+		void 
+		symbol::release(
+			__in cc65c::core::uuid_t id
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::core::uuid &instance = cc65c::core::uuid::acquire();
+			if(instance.is_initialized() && instance.contains(id)) {
+				instance.decrement(id);
+			}
+
+			TRACE_EXIT();
+		}
+
 		std::string 
 		symbol::to_string(
 			__in_opt bool verbose
@@ -0,0 +1,533 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "../../include/assembler/table.h"
+#include "table_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define TABLE_HASH_BASIS 0x811c9dc5
+		#define TABLE_HASH_PRIME 0x01000193
+
+		#define TABLE_SLOT(_HASH_, _INDEX_) ((((uint64_t) (_HASH_)) << 32) | ((_INDEX_) + 1))
+		#define TABLE_SLOT_EMPTY 0
+		#define TABLE_SLOT_HASH(_SLOT_) ((uint32_t) ((_SLOT_) >> 32))
+		#define TABLE_SLOT_INDEX(_SLOT_) ((size_t) (((_SLOT_) & UINT32_MAX) - 1))
+
+		table::table(
+			__in_opt size_t reserve
+			) :
+				m_link_free(TABLE_INDEX_INVALID)
+		{
+			size_t capacity = TABLE_CAPACITY_MIN;
+
+			TRACE_ENTRY();
+
+			while(capacity < (reserve * 2)) {
+				capacity <<= 1;
+			}
+
+			m_entry.reserve(reserve);
+			m_slot.resize(capacity, TABLE_SLOT_EMPTY);
+
+			TRACE_EXIT();
+		}
+
+		table::table(
+			__in const table &other
+			) :
+				m_entry(other.m_entry),
+				m_link(other.m_link),
+				m_link_free(other.m_link_free),
+				m_slot(other.m_slot)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		table::~table(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		table &
+		table::operator=(
+			__in const table &other
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			if(this != &other) {
+				m_entry = other.m_entry;
+				m_link = other.m_link;
+				m_link_free = other.m_link_free;
+				m_slot = other.m_slot;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", this);
+			return *this;
+		}
+
+		uint32_t 
+		table::as_hash(
+			__in const std::string &name
+			)
+		{
+			uint32_t result = TABLE_HASH_BASIS;
+			std::string::const_iterator iter;
+
+			for(iter = name.begin(); iter != name.end(); ++iter) {
+				result = ((result ^ (uint8_t) *iter) * TABLE_HASH_PRIME);
+			}
+
+			return result;
+		}
+
+		std::string 
+		table::as_string(
+			__in const table &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+			std::vector<cc65c::assembler::table_entry_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			result << "Entry[" << reference.m_entry.size() << "], Capacity=" << reference.m_slot.size() 
+				<< ", Link[" << reference.m_link.size() << "]";
+
+			if(verbose) {
+
+				for(iter = reference.m_entry.begin(); iter != reference.m_entry.end(); ++iter) {
+					result << std::endl << "\t" << TABLE_SYMBOL_STRING(std::get<TABLE_ENTRY_TYPE>(*iter)) 
+						<< " \"" << STRING_CHECK(std::get<TABLE_ENTRY_NAME>(*iter)) << "\"";
+
+					if(std::get<TABLE_ENTRY_TYPE>(*iter) != TABLE_SYMBOL_UNDEFINED) {
+						result << "=" << SCALAR_AS_HEX(uint16_t, std::get<TABLE_ENTRY_VALUE>(*iter));
+					}
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		table::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			m_entry.clear();
+			m_link.clear();
+			m_link_free = TABLE_INDEX_INVALID;
+			std::fill(m_slot.begin(), m_slot.end(), TABLE_SLOT_EMPTY);
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		table::contains(
+			__in const std::string &name
+			)
+		{
+			uint64_t slot;
+			bool result = false;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			slot = m_slot.at(probe(name, as_hash(name)));
+			if(slot != TABLE_SLOT_EMPTY) {
+				result = (std::get<TABLE_ENTRY_TYPE>(m_entry.at(TABLE_SLOT_INDEX(slot))) != TABLE_SYMBOL_UNDEFINED);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		table::contains(
+			__in const std::string &name,
+			__in cc65c::assembler::table_symbol_t type
+			)
+		{
+			uint64_t slot;
+			bool result = false;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			slot = m_slot.at(probe(name, as_hash(name)));
+			if(slot != TABLE_SLOT_EMPTY) {
+				result = (std::get<TABLE_ENTRY_TYPE>(m_entry.at(TABLE_SLOT_INDEX(slot))) == type);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		table::define(
+			__in size_t index,
+			__in cc65c::assembler::table_symbol_t type,
+			__in int32_t value,
+			__inout std::vector<size_t> &resolved
+			)
+		{
+			size_t link, next, offset;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			if((type == TABLE_SYMBOL_UNDEFINED) || (type > TABLE_SYMBOL_MAX)) {
+				THROW_CC65C_ASSEMBLER_TABLE_EXCEPTION_FORMAT(CC65C_ASSEMBLER_TABLE_EXCEPTION_INVALID_TYPE,
+					"Type=%x", type);
+			}
+
+			cc65c::assembler::table_entry_t &result = entry(index);
+			std::get<TABLE_ENTRY_TYPE>(result) = type;
+			std::get<TABLE_ENTRY_VALUE>(result) = value;
+			offset = resolved.size();
+
+			for(link = std::get<TABLE_ENTRY_FIXUP>(result); link != TABLE_INDEX_INVALID; link = next) {
+				cc65c::assembler::table_link_t &current = m_link.at(link);
+				resolved.push_back(std::get<TABLE_LINK_FIXUP>(current));
+				next = std::get<TABLE_LINK_NEXT>(current);
+				std::get<TABLE_LINK_NEXT>(current) = m_link_free;
+				m_link_free = link;
+			}
+
+			std::get<TABLE_ENTRY_FIXUP>(result) = TABLE_INDEX_INVALID;
+			std::reverse(resolved.begin() + offset, resolved.end());
+
+			TRACE_EXIT();
+		}
+
+		cc65c::assembler::table_entry_t &
+		table::entry(
+			__in size_t index
+			)
+		{
+
+			if(index >= m_entry.size()) {
+				THROW_CC65C_ASSEMBLER_TABLE_EXCEPTION_FORMAT(CC65C_ASSEMBLER_TABLE_EXCEPTION_INVALID_INDEX,
+					"Index=%u", index);
+			}
+
+			return m_entry[index];
+		}
+
+		size_t 
+		table::find(
+			__in const std::string &name
+			)
+		{
+			uint64_t slot;
+			size_t result = TABLE_INDEX_INVALID;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			slot = m_slot.at(probe(name, as_hash(name)));
+			if(slot != TABLE_SLOT_EMPTY) {
+				result = TABLE_SLOT_INDEX(slot);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		bool 
+		table::has_pending(
+			__inout size_t &index,
+			__inout size_t &fixup
+			)
+		{
+			bool result = false;
+			std::vector<cc65c::assembler::table_entry_t>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			for(iter = m_entry.begin(); iter != m_entry.end(); ++iter) {
+
+				if(std::get<TABLE_ENTRY_FIXUP>(*iter) != TABLE_INDEX_INVALID) {
+					index = (iter - m_entry.begin());
+					fixup = std::get<TABLE_LINK_FIXUP>(m_link.at(std::get<TABLE_ENTRY_FIXUP>(*iter)));
+					result = true;
+					break;
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		size_t 
+		table::intern(
+			__in const std::string &name
+			)
+		{
+			size_t position, result;
+			uint32_t hash = as_hash(name);
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			position = probe(name, hash);
+			if(m_slot[position] == TABLE_SLOT_EMPTY) {
+
+				if(m_entry.size() >= UINT32_MAX) {
+					THROW_CC65C_ASSEMBLER_TABLE_EXCEPTION_FORMAT(CC65C_ASSEMBLER_TABLE_EXCEPTION_INVALID_INDEX,
+						"Index=%u", m_entry.size());
+				}
+
+				if(((m_entry.size() + 1) * 2) > m_slot.size()) {
+					rehash(m_slot.size() * 2);
+					position = probe(name, hash);
+				}
+
+				m_slot[position] = TABLE_SLOT(hash, m_entry.size());
+				m_entry.push_back(std::make_tuple(TABLE_INDEX_INVALID, name, TABLE_SYMBOL_UNDEFINED, 0));
+			}
+
+			result = TABLE_SLOT_INDEX(m_slot[position]);
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::string 
+		table::name(
+			__in size_t index
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			result = std::get<TABLE_ENTRY_NAME>(entry(index));
+
+			TRACE_EXIT_FORMAT("Result=%s", STRING_CHECK(result));
+			return result;
+		}
+
+		size_t 
+		table::probe(
+			__in const std::string &name,
+			__in uint32_t hash
+			)
+		{
+			uint64_t slot;
+			size_t mask = (m_slot.size() - 1), result = (hash & mask);
+
+			for(;;) {
+
+				slot = m_slot[result];
+				if((slot == TABLE_SLOT_EMPTY) || ((TABLE_SLOT_HASH(slot) == hash)
+						&& (std::get<TABLE_ENTRY_NAME>(m_entry[TABLE_SLOT_INDEX(slot)]) == name))) {
+					break;
+				}
+
+				result = ((result + 1) & mask);
+			}
+
+			return result;
+		}
+
+		void 
+		table::rehash(
+			__in size_t capacity
+			)
+		{
+			size_t mask = (capacity - 1), position;
+			std::vector<uint64_t>::iterator iter;
+			std::vector<uint64_t> slot(capacity, TABLE_SLOT_EMPTY);
+
+			TRACE_ENTRY();
+
+			for(iter = m_slot.begin(); iter != m_slot.end(); ++iter) {
+
+				if(*iter != TABLE_SLOT_EMPTY) {
+
+					for(position = (TABLE_SLOT_HASH(*iter) & mask); slot[position] != TABLE_SLOT_EMPTY; 
+							position = ((position + 1) & mask));
+
+					slot[position] = *iter;
+				}
+			}
+
+			m_slot.swap(slot);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		table::reset(void)
+		{
+			std::vector<cc65c::assembler::table_entry_t>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			for(iter = m_entry.begin(); iter != m_entry.end(); ++iter) {
+				std::get<TABLE_ENTRY_FIXUP>(*iter) = TABLE_INDEX_INVALID;
+				std::get<TABLE_ENTRY_TYPE>(*iter) = TABLE_SYMBOL_UNDEFINED;
+				std::get<TABLE_ENTRY_VALUE>(*iter) = 0;
+			}
+
+			m_link.clear();
+			m_link_free = TABLE_INDEX_INVALID;
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		table::size(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			result = m_entry.size();
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::string 
+		table::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			result = cc65c::assembler::table::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		cc65c::assembler::table_symbol_t 
+		table::type(
+			__in size_t index
+			)
+		{
+			cc65c::assembler::table_symbol_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			result = std::get<TABLE_ENTRY_TYPE>(entry(index));
+
+			TRACE_EXIT_FORMAT("Result=%x(%s)", result, TABLE_SYMBOL_STRING(result));
+			return result;
+		}
+
+		void 
+		table::undefine(
+			__in size_t index
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			cc65c::assembler::table_entry_t &result = entry(index);
+			std::get<TABLE_ENTRY_TYPE>(result) = TABLE_SYMBOL_UNDEFINED;
+			std::get<TABLE_ENTRY_VALUE>(result) = 0;
+
+			TRACE_EXIT();
+		}
+
+		int32_t 
+		table::value(
+			__in size_t index
+			)
+		{
+			int32_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			result = std::get<TABLE_ENTRY_VALUE>(entry(index));
+
+			TRACE_EXIT_FORMAT("Result=%i", result);
+			return result;
+		}
+
+		void 
+		table::wait(
+			__in size_t index,
+			__in size_t fixup
+			)
+		{
+			size_t link;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_table_mutex);
+
+			cc65c::assembler::table_entry_t &result = entry(index);
+			if(std::get<TABLE_ENTRY_TYPE>(result) != TABLE_SYMBOL_UNDEFINED) {
+				THROW_CC65C_ASSEMBLER_TABLE_EXCEPTION_FORMAT(CC65C_ASSEMBLER_TABLE_EXCEPTION_INVALID_TYPE,
+					"Type=%x", std::get<TABLE_ENTRY_TYPE>(result));
+			}
+
+			if(m_link_free != TABLE_INDEX_INVALID) {
+				link = m_link_free;
+				m_link_free = std::get<TABLE_LINK_NEXT>(m_link[link]);
+				m_link[link] = cc65c::assembler::table_link_t(fixup, std::get<TABLE_ENTRY_FIXUP>(result));
+			} else {
+				link = m_link.size();
+				m_link.push_back(cc65c::assembler::table_link_t(fixup, std::get<TABLE_ENTRY_FIXUP>(result)));
+			}
+
+			std::get<TABLE_ENTRY_FIXUP>(result) = link;
+
+			TRACE_EXIT();
+		}
+	}
+}
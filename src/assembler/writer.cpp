@@ -0,0 +1,559 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../../include/assembler/writer.h"
+#include "writer_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace assembler {
+
+		#define FILE_INVALID -1
+		#define FILL_LENGTH 0x100
+		#define LISTING_BYTE_COUNT 3
+		#define LISTING_COLUMN_MAX 32
+		#define LISTING_FILL ' '
+
+		static const char HEX_DIGIT[] = "0123456789ABCDEF";
+
+		writer::writer(void) :
+			m_buffer(WRITER_BUFFER_SIZE),
+			m_file(FILE_INVALID),
+			m_position(0),
+			m_size(0)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		writer::writer(
+			__in const std::string &output
+			) :
+				m_buffer(WRITER_BUFFER_SIZE),
+				m_file(FILE_INVALID),
+				m_position(0),
+				m_size(0)
+		{
+			TRACE_ENTRY();
+
+			open(output);
+
+			TRACE_EXIT();
+		}
+
+		writer::~writer(void)
+		{
+			TRACE_ENTRY();
+
+			try {
+				close();
+			} catch(...) { }
+
+			TRACE_EXIT();
+		}
+
+		std::vector<const cc65c::assembler::block_t *> 
+		writer::as_image(
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end
+			)
+		{
+			std::vector<cc65c::assembler::block_t>::const_iterator block_iter;
+			std::vector<const cc65c::assembler::block_t *> result;
+			std::vector<const cc65c::assembler::block_t *>::iterator iter;
+
+			TRACE_ENTRY();
+
+			for(; begin != end; ++begin) {
+
+				for(block_iter = begin->second.begin(); block_iter != begin->second.end(); ++block_iter) {
+
+					if(!block_iter->second.empty()) {
+						result.push_back(&*block_iter);
+					}
+				}
+			}
+
+			std::sort(result.begin(), result.end(), [](const cc65c::assembler::block_t *left, 
+					const cc65c::assembler::block_t *right) { return (left->first < right->first); });
+
+			for(iter = result.begin(); iter != result.end(); ++iter) {
+
+				if(((iter + 1) != result.end()) && (((*iter)->first + (*iter)->second.size()) > (*(iter + 1))->first)) {
+					THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_WRITER_EXCEPTION_OVERLAP,
+						"Block=%04x[%u], Next=%04x", (*iter)->first, (*iter)->second.size(), (*(iter + 1))->first);
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result[%u]", result.size());
+			return result;
+		}
+
+		std::string 
+		writer::as_string(
+			__in const writer &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << ((reference.m_file != FILE_INVALID) ? "Open" : "Closed");
+
+			if(reference.m_file != FILE_INVALID) {
+				result << ", Path[" << reference.m_path.size() << "]=\"" << STRING_CHECK(reference.m_path) << "\"";
+			}
+
+			result << ", Size=" << reference.m_size;
+
+			if(verbose) {
+				result << ", Buffer=" << reference.m_position << "/" << reference.m_buffer.size();
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		writer::close(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			if(m_file != FILE_INVALID) {
+
+				try {
+					flush();
+				} catch(...) {
+					::close(m_file);
+					m_file = FILE_INVALID;
+					throw;
+				}
+
+				::close(m_file);
+				m_file = FILE_INVALID;
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		writer::flush(void)
+		{
+			ssize_t count;
+			size_t offset = 0;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			if(m_file == FILE_INVALID) {
+				THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION(CC65C_ASSEMBLER_WRITER_EXCEPTION_CLOSED);
+			}
+
+			while(offset < m_position) {
+
+				count = ::write(m_file, &m_buffer[offset], m_position - offset);
+				if(count < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					}
+
+					THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_WRITER_EXCEPTION_WRITE_FAILED,
+						"Path[%u]=%s, Error=%s", m_path.size(), STRING_CHECK(m_path), std::strerror(errno));
+				}
+
+				offset += count;
+			}
+
+			m_position = 0;
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		writer::is_open(void)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			result = (m_file != FILE_INVALID);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		writer::open(
+			__in const std::string &output
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			if(m_file != FILE_INVALID) {
+				THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_WRITER_EXCEPTION_OPEN,
+					"Path[%u]=%s", m_path.size(), STRING_CHECK(m_path));
+			}
+
+			m_file = ::open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if(m_file == FILE_INVALID) {
+				THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_WRITER_EXCEPTION_FILE_NOT_CREATED,
+					"Path[%u]=%s, Error=%s", output.size(), STRING_CHECK(output), std::strerror(errno));
+			}
+
+			m_path = output;
+			m_position = 0;
+			m_size = 0;
+
+			TRACE_EXIT();
+		}
+
+		size_t 
+		writer::size(void)
+		{
+			size_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			result = m_size;
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		std::string 
+		writer::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			result = cc65c::assembler::writer::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		writer::write(
+			__in const uint8_t *data,
+			__in size_t length
+			)
+		{
+			ssize_t count;
+			size_t offset = 0;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			if(m_file == FILE_INVALID) {
+				THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION(CC65C_ASSEMBLER_WRITER_EXCEPTION_CLOSED);
+			}
+
+			if(length >= m_buffer.size()) {
+				flush();
+
+				while(offset < length) {
+
+					count = ::write(m_file, data + offset, length - offset);
+					if(count < 0) {
+
+						if(errno == EINTR) {
+							continue;
+						}
+
+						THROW_CC65C_ASSEMBLER_WRITER_EXCEPTION_FORMAT(CC65C_ASSEMBLER_WRITER_EXCEPTION_WRITE_FAILED,
+							"Path[%u]=%s, Error=%s", m_path.size(), STRING_CHECK(m_path), std::strerror(errno));
+					}
+
+					offset += count;
+				}
+			} else {
+
+				if((m_position + length) > m_buffer.size()) {
+					flush();
+				}
+
+				std::memcpy(&m_buffer[m_position], data, length);
+				m_position += length;
+			}
+
+			m_size += length;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		writer::write(
+			__in const std::string &data
+			)
+		{
+			TRACE_ENTRY();
+
+			write((const uint8_t *) data.c_str(), data.size());
+
+			TRACE_EXIT();
+		}
+
+		void 
+		writer::write_binary(
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end,
+			__in_opt uint8_t fill
+			)
+		{
+			size_t address, length;
+			std::vector<const cc65c::assembler::block_t *> image;
+			std::vector<const cc65c::assembler::block_t *>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			image = as_image(begin, end);
+			if(!image.empty()) {
+				address = image.front()->first;
+				std::vector<uint8_t> padding(FILL_LENGTH, fill);
+
+				for(iter = image.begin(); iter != image.end(); ++iter) {
+
+					for(; address < (*iter)->first; address += length) {
+						length = std::min((*iter)->first - address, padding.size());
+						write(&padding[0], length);
+					}
+
+					write(&(*iter)->second[0], (*iter)->second.size());
+					address += (*iter)->second.size();
+				}
+			}
+
+			flush();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		writer::write_hex(
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end
+			)
+		{
+			size_t length, offset;
+			std::vector<const cc65c::assembler::block_t *> image;
+			std::vector<const cc65c::assembler::block_t *>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			image = as_image(begin, end);
+			for(iter = image.begin(); iter != image.end(); ++iter) {
+
+				for(offset = 0; offset < (*iter)->second.size(); offset += length) {
+					length = std::min((size_t) WRITER_HEX_RECORD_LENGTH, (*iter)->second.size() - offset);
+					write_hex_record(WRITER_HEX_DATA, (*iter)->first + offset, &(*iter)->second[offset], length);
+				}
+			}
+
+			write_hex_record(WRITER_HEX_END, 0, nullptr, 0);
+			flush();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		writer::write_hex_record(
+			__in cc65c::assembler::writer_hex_t type,
+			__in uint16_t address,
+			__in const uint8_t *data,
+			__in size_t length
+			)
+		{
+			size_t index;
+			uint8_t checksum, value;
+			char *position, record[(WRITER_HEX_RECORD_LENGTH + 5) * 2 + 2];
+
+			TRACE_ENTRY();
+
+			position = record;
+			*position++ = ':';
+			checksum = (length + (address >> 8) + address + type);
+
+			for(index = 0; index < (length + 4); ++index) {
+
+				switch(index) {
+					case 0:
+						value = length;
+						break;
+					case 1:
+						value = (address >> 8);
+						break;
+					case 2:
+						value = address;
+						break;
+					case 3:
+						value = type;
+						break;
+					default:
+						value = data[index - 4];
+						checksum += value;
+						break;
+				}
+
+				*position++ = HEX_DIGIT[value >> 4];
+				*position++ = HEX_DIGIT[value & 0xf];
+			}
+
+			checksum = -checksum;
+			*position++ = HEX_DIGIT[checksum >> 4];
+			*position++ = HEX_DIGIT[checksum & 0xf];
+			*position++ = '\n';
+			write((const uint8_t *) record, position - record);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		writer::write_listing(
+			__inout cc65c::assembler::generator &input
+			)
+		{
+			int count;
+			uint16_t address;
+			std::string path;
+			size_t index, length, offset;
+			char field[LISTING_COLUMN_MAX];
+			const cc65c::assembler::block_t *block;
+			std::vector<cc65c::assembler::listing_metadata_t>::const_iterator iter;
+			std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator peephole_iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_writer_mutex);
+
+			for(iter = input.listing_begin(); iter != input.listing_end(); ++iter) {
+				block = nullptr;
+				length = std::get<LISTING_METADATA_LENGTH>(*iter);
+				offset = std::get<LISTING_METADATA_OFFSET>(*iter);
+
+				if(std::get<LISTING_METADATA_PATH>(*iter) != path) {
+					path = std::get<LISTING_METADATA_PATH>(*iter);
+
+					if(!path.empty()) {
+						write("; " + path + "\n");
+					}
+				}
+
+				try {
+					const std::vector<cc65c::assembler::block_t> &segment = input.segment(
+						std::get<LISTING_METADATA_SEGMENT>(*iter));
+
+					if(std::get<LISTING_METADATA_BLOCK>(*iter) < segment.size()) {
+						block = &segment.at(std::get<LISTING_METADATA_BLOCK>(*iter));
+					}
+				} catch(cc65c::core::exception &exc) { }
+
+				address = (block ? (block->first + offset) : 0);
+				length = (block ? std::min(length, block->second.size() - offset) : 0);
+				if(block) {
+					count = std::snprintf(field, LISTING_COLUMN_MAX, "%04X ", address);
+				} else {
+					count = std::snprintf(field, LISTING_COLUMN_MAX, "     ");
+				}
+
+				write((const uint8_t *) field, count);
+
+				for(index = 0; index < LISTING_BYTE_COUNT; ++index) {
+
+					if(index < length) {
+						count = std::snprintf(field, LISTING_COLUMN_MAX, " %02X", block->second.at(offset + index));
+					} else {
+						count = std::snprintf(field, LISTING_COLUMN_MAX, "   ");
+					}
+
+					write((const uint8_t *) field, count);
+				}
+
+				count = std::snprintf(field, LISTING_COLUMN_MAX, "  %5u  ", 
+					(unsigned) (std::get<LISTING_METADATA_ROW>(*iter) + 1));
+				write((const uint8_t *) field, count);
+
+				const std::string &line = input.listing_line(path, std::get<LISTING_METADATA_ROW>(*iter));
+
+				for(count = line.size(); (count > 0) && (line.at(count - 1) == LISTING_FILL); --count);
+				write((const uint8_t *) line.c_str(), count);
+				write((const uint8_t *) "\n", 1);
+
+				for(index = LISTING_BYTE_COUNT; index < length; ++index) {
+
+					if(!(index % LISTING_BYTE_COUNT)) {
+						count = std::snprintf(field, LISTING_COLUMN_MAX, "%04X ", (unsigned) (address + index));
+						write((const uint8_t *) field, count);
+					}
+
+					count = std::snprintf(field, LISTING_COLUMN_MAX, " %02X", block->second.at(offset + index));
+					write((const uint8_t *) field, count);
+
+					if(!((index + 1) % LISTING_BYTE_COUNT) || ((index + 1) == length)) {
+						write((const uint8_t *) "\n", 1);
+					}
+				}
+			}
+
+			for(peephole_iter = input.peephole_begin(); peephole_iter != input.peephole_end(); ++peephole_iter) {
+				write("; " + std::string(PEEPHOLE_PATTERN_STRING(peephole_iter->first)) + ": " 
+					+ std::to_string(std::get<PEEPHOLE_REPORT_COUNT>(peephole_iter->second)) + " rewrite(s), " 
+					+ std::to_string(std::get<PEEPHOLE_REPORT_BYTE>(peephole_iter->second)) + " byte(s), " 
+					+ std::to_string(std::get<PEEPHOLE_REPORT_CYCLE>(peephole_iter->second)) + " cycle(s) saved\n");
+			}
+
+			if(input.relaxed()) {
+				write("; " + std::to_string(input.relaxed()) + " branch(es) relaxed\n");
+			}
+
+			if(input.shortened()) {
+				write("; " + std::to_string(input.shortened()) + " instruction(s) shortened to zero page\n");
+			}
+
+			flush();
+
+			TRACE_EXIT();
+		}
+	}
+}
@@ -0,0 +1,403 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+#include "../../include/core/counter.h"
+#include "counter_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace core {
+
+#ifdef __linux__
+		static const uint64_t COUNTER_EVENT_CONFIG[] = {
+			PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS,
+			};
+#endif // __linux__
+
+		#define COUNTER_HANDLE_INVALID -1
+		#define COUNTER_NANOSECONDS_PER_SECOND 1000000000ULL
+
+		counter::counter(void) :
+			m_counter_cpu(0),
+			m_counter_current(COUNTER_PHASE_NONE),
+			m_counter_enabled(false),
+			m_counter_wall(0)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		counter::~counter(void)
+		{
+			TRACE_ENTRY();
+
+			uninitialize();
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		counter::as_string(
+			__in const counter &reference,
+			__in_opt bool verbose
+			)
+		{
+			size_t index;
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << CC65C_CORE_COUNTER_HEADER
+				<< " " << cc65c::core::singleton<cc65c::core::counter>::as_string(reference, verbose);
+
+			if(verbose) {
+				result << ", Instance=" << SCALAR_AS_HEX(uintptr_t, &reference);
+			}
+
+			if(reference.m_initialized) {
+				result << ", State=" << (!reference.m_counter_handle.empty() ? "Enabled" : "Unavailable")
+					<< ", Depth=" << reference.m_counter_phase.size();
+
+				if(verbose) {
+
+					for(index = 0; index < reference.m_counter_metadata.size(); ++index) {
+						result << ", " << COUNTER_PHASE_STRING(index) << "="
+							<< std::get<COUNTER_METADATA_ENTRY>(reference.m_counter_metadata.at(index));
+					}
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		bool 
+		counter::available(void)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_counter_mutex);
+			result = !m_counter_handle.empty();
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		counter::clear(void)
+		{
+			TRACE_ENTRY();
+
+			m_counter_current = COUNTER_PHASE_NONE;
+			m_counter_metadata.assign(COUNTER_PHASE_MAX + 1, cc65c::core::counter_metadata_t(0, 0,
+				std::vector<uint64_t>(COUNTER_EVENT_MAX + 1, 0), 0));
+			m_counter_phase.clear();
+			m_counter_sample.assign(COUNTER_EVENT_MAX + 1, 0);
+
+			TRACE_EXIT();
+		}
+
+		void 
+		counter::close(void)
+		{
+			std::vector<int>::reverse_iterator iter;
+
+			TRACE_ENTRY();
+
+			for(iter = m_counter_handle.rbegin(); iter != m_counter_handle.rend(); ++iter) {
+#ifdef __linux__
+				::close(*iter);
+#endif // __linux__
+			}
+
+			m_counter_handle.clear();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		counter::enter(
+			__in cc65c::core::counter_phase_t phase
+			)
+		{
+			TRACE_ENTRY();
+
+			if(m_counter_enabled && (std::this_thread::get_id() == m_counter_thread)) {
+				std::lock_guard<std::mutex> lock(m_counter_mutex);
+
+				if(phase > COUNTER_PHASE_MAX) {
+					THROW_CC65C_CORE_COUNTER_EXCEPTION_FORMAT(CC65C_CORE_COUNTER_EXCEPTION_INVALID_PHASE,
+						"Phase=%x", phase);
+				}
+
+				sample();
+				m_counter_phase.push_back(phase);
+				m_counter_current = phase;
+				++std::get<COUNTER_METADATA_ENTRY>(m_counter_metadata.at(phase));
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		counter::exit(void)
+		{
+			TRACE_ENTRY();
+
+			if(m_counter_enabled && (std::this_thread::get_id() == m_counter_thread)) {
+				std::lock_guard<std::mutex> lock(m_counter_mutex);
+
+				if(!m_counter_phase.empty()) {
+					sample();
+					m_counter_phase.pop_back();
+					m_counter_current = (m_counter_phase.empty() ? COUNTER_PHASE_NONE : m_counter_phase.back());
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		counter::initialize(void)
+		{
+			TRACE_ENTRY();
+
+			if(cc65c::core::singleton<cc65c::core::counter>::is_initialized()) {
+				THROW_CC65C_CORE_COUNTER_EXCEPTION(CC65C_CORE_COUNTER_EXCEPTION_INITIALIZED);
+			}
+
+			std::lock_guard<std::mutex> lock(m_counter_mutex);
+
+			cc65c::core::singleton<cc65c::core::counter>::set_initialized(true);
+			clear();
+			m_counter_thread = std::this_thread::get_id();
+			m_counter_enabled = true;
+			TRACE_INFORMATION_FORMAT("Counter manager initialized", "State=%s", open() ? "Enabled" : "Unavailable");
+
+			TRACE_EXIT();
+		}
+
+		cc65c::core::counter_metadata_t 
+		counter::metadata(
+			__in cc65c::core::counter_phase_t phase
+			)
+		{
+			cc65c::core::counter_metadata_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_counter_mutex);
+
+			if(!cc65c::core::singleton<cc65c::core::counter>::is_initialized()) {
+				THROW_CC65C_CORE_COUNTER_EXCEPTION(CC65C_CORE_COUNTER_EXCEPTION_UNINITIALIZED);
+			}
+
+			if(phase > COUNTER_PHASE_MAX) {
+				THROW_CC65C_CORE_COUNTER_EXCEPTION_FORMAT(CC65C_CORE_COUNTER_EXCEPTION_INVALID_PHASE,
+					"Phase=%x", phase);
+			}
+
+			result = m_counter_metadata.at(phase);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		bool 
+		counter::open(void)
+		{
+			bool result = false;
+#ifdef __linux__
+			size_t event;
+			int handle, leader;
+			struct perf_event_attr attribute;
+#endif // __linux__
+
+			TRACE_ENTRY();
+
+#ifdef __linux__
+			for(event = 0; event <= COUNTER_EVENT_MAX; ++event) {
+				std::memset(&attribute, 0, sizeof(attribute));
+				attribute.size = sizeof(attribute);
+				attribute.type = PERF_TYPE_HARDWARE;
+				attribute.config = COUNTER_EVENT_CONFIG[event];
+				attribute.disabled = m_counter_handle.empty();
+				attribute.exclude_hv = 1;
+				attribute.exclude_kernel = 1;
+				attribute.read_format = PERF_FORMAT_GROUP;
+				leader = (m_counter_handle.empty() ? COUNTER_HANDLE_INVALID : m_counter_handle.front());
+
+				handle = syscall(__NR_perf_event_open, &attribute, 0, -1, leader, 0);
+				if(handle == COUNTER_HANDLE_INVALID) {
+					TRACE_WARNING_FORMAT("Counter event unavailable", "Event=%s, Error=%s",
+						COUNTER_EVENT_STRING(event), std::strerror(errno));
+					close();
+					break;
+				}
+
+				m_counter_handle.push_back(handle);
+			}
+
+			if(!m_counter_handle.empty()) {
+				ioctl(m_counter_handle.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(m_counter_handle.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+				result = true;
+			}
+#endif // __linux__
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		size_t 
+		counter::phase(void)
+		{
+			return m_counter_current;
+		}
+
+		void 
+		counter::reset(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_counter_mutex);
+
+			if(!cc65c::core::singleton<cc65c::core::counter>::is_initialized()) {
+				THROW_CC65C_CORE_COUNTER_EXCEPTION(CC65C_CORE_COUNTER_EXCEPTION_UNINITIALIZED);
+			}
+
+			m_counter_metadata.assign(COUNTER_PHASE_MAX + 1, cc65c::core::counter_metadata_t(0, 0,
+				std::vector<uint64_t>(COUNTER_EVENT_MAX + 1, 0), 0));
+
+			TRACE_EXIT();
+		}
+
+		void 
+		counter::sample(void)
+		{
+#ifdef __linux__
+			size_t event;
+			uint64_t value[COUNTER_EVENT_MAX + 2] = { 0 };
+#endif // __linux__
+			struct timespec time;
+			uint64_t cpu = 0, wall;
+
+			TRACE_ENTRY();
+
+			if(!clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time)) {
+				cpu = ((time.tv_sec * COUNTER_NANOSECONDS_PER_SECOND) + time.tv_nsec);
+			}
+
+			wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+
+			if(!m_counter_phase.empty()) {
+				cc65c::core::counter_metadata_t &entry = m_counter_metadata.at(m_counter_phase.back());
+				std::get<COUNTER_METADATA_CPU>(entry) += (cpu - m_counter_cpu);
+				std::get<COUNTER_METADATA_WALL>(entry) += (wall - m_counter_wall);
+			}
+
+			m_counter_cpu = cpu;
+			m_counter_wall = wall;
+
+#ifdef __linux__
+			if(!m_counter_handle.empty() && (::read(m_counter_handle.front(), value, sizeof(value)) == sizeof(value))) {
+
+				for(event = 0; event <= COUNTER_EVENT_MAX; ++event) {
+
+					if(!m_counter_phase.empty()) {
+						std::get<COUNTER_METADATA_EVENT>(m_counter_metadata.at(m_counter_phase.back())).at(event)
+							+= (value[event + 1] - m_counter_sample.at(event));
+					}
+
+					m_counter_sample.at(event) = value[event + 1];
+				}
+			}
+#endif // __linux__
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		counter::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_counter_mutex);
+			result = cc65c::core::counter::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		counter::uninitialize(void)
+		{
+			TRACE_ENTRY();
+
+			if(cc65c::core::singleton<cc65c::core::counter>::is_initialized()) {
+				std::lock_guard<std::mutex> lock(m_counter_mutex);
+
+				cc65c::core::singleton<cc65c::core::counter>::set_initialized(false);
+				m_counter_enabled = false;
+				close();
+				clear();
+				TRACE_INFORMATION("Counter manager uninitialized");
+			}
+
+			TRACE_EXIT();
+		}
+
+		counter_scope::counter_scope(
+			__in cc65c::core::counter_phase_t phase
+			)
+		{
+			TRACE_ENTRY();
+
+			cc65c::core::counter::acquire().enter(phase);
+
+			TRACE_EXIT();
+		}
+
+		counter_scope::~counter_scope(void)
+		{
+			TRACE_ENTRY();
+
+			cc65c::core::counter::acquire().exit();
+
+			TRACE_EXIT();
+		}
+	}
+}
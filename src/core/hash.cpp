@@ -0,0 +1,149 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "../../include/core/hash.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace core {
+
+		#define HASH_PRIME_1 0x9e3779b185ebca87ULL
+		#define HASH_PRIME_2 0xc2b2ae3d27d4eb4fULL
+		#define HASH_PRIME_3 0x165667b19e3779f9ULL
+		#define HASH_PRIME_4 0x85ebca77c2b2ae63ULL
+		#define HASH_PRIME_5 0x27d4eb2f165667c5ULL
+		#define HASH_STRIPE_LENGTH 32
+
+		#define HASH_ROTATE(_VAL_, _BITS_) \
+			(((_VAL_) << (_BITS_)) | ((_VAL_) >> (64 - (_BITS_))))
+
+		uint64_t 
+		hash::generate(
+			__in const void *data,
+			__in size_t length,
+			__in_opt uint64_t seed
+			)
+		{
+			uint64_t result, value[4];
+			const uint8_t *position = (const uint8_t *) data, *end = (position + length);
+
+			TRACE_ENTRY();
+
+			if(length >= HASH_STRIPE_LENGTH) {
+				value[0] = (seed + HASH_PRIME_1 + HASH_PRIME_2);
+				value[1] = (seed + HASH_PRIME_2);
+				value[2] = seed;
+				value[3] = (seed - HASH_PRIME_1);
+
+				for(; (position + HASH_STRIPE_LENGTH) <= end; position += HASH_STRIPE_LENGTH) {
+					value[0] = round(value[0], read(position, sizeof(uint64_t)));
+					value[1] = round(value[1], read(position + 8, sizeof(uint64_t)));
+					value[2] = round(value[2], read(position + 16, sizeof(uint64_t)));
+					value[3] = round(value[3], read(position + 24, sizeof(uint64_t)));
+				}
+
+				result = (HASH_ROTATE(value[0], 1) + HASH_ROTATE(value[1], 7) + HASH_ROTATE(value[2], 12) 
+					+ HASH_ROTATE(value[3], 18));
+				result = merge(result, value[0]);
+				result = merge(result, value[1]);
+				result = merge(result, value[2]);
+				result = merge(result, value[3]);
+			} else {
+				result = (seed + HASH_PRIME_5);
+			}
+
+			result += length;
+
+			for(; (position + sizeof(uint64_t)) <= end; position += sizeof(uint64_t)) {
+				result ^= round(0, read(position, sizeof(uint64_t)));
+				result = ((HASH_ROTATE(result, 27) * HASH_PRIME_1) + HASH_PRIME_4);
+			}
+
+			if((position + sizeof(uint32_t)) <= end) {
+				result ^= (read(position, sizeof(uint32_t)) * HASH_PRIME_1);
+				result = ((HASH_ROTATE(result, 23) * HASH_PRIME_2) + HASH_PRIME_3);
+				position += sizeof(uint32_t);
+			}
+
+			for(; position < end; ++position) {
+				result ^= (*position * HASH_PRIME_5);
+				result = (HASH_ROTATE(result, 11) * HASH_PRIME_1);
+			}
+
+			result ^= (result >> 33);
+			result *= HASH_PRIME_2;
+			result ^= (result >> 29);
+			result *= HASH_PRIME_3;
+			result ^= (result >> 32);
+
+			TRACE_EXIT_FORMAT("Result=%llx", (unsigned long long) result);
+			return result;
+		}
+
+		uint64_t 
+		hash::generate(
+			__in const std::string &data,
+			__in_opt uint64_t seed
+			)
+		{
+			uint64_t result;
+
+			TRACE_ENTRY();
+
+			result = generate(data.c_str(), data.size(), seed);
+
+			TRACE_EXIT_FORMAT("Result=%llx", (unsigned long long) result);
+			return result;
+		}
+
+		uint64_t 
+		hash::merge(
+			__in uint64_t accumulator,
+			__in uint64_t value
+			)
+		{
+			accumulator ^= round(0, value);
+			return ((accumulator * HASH_PRIME_1) + HASH_PRIME_4);
+		}
+
+		uint64_t 
+		hash::read(
+			__in const uint8_t *data,
+			__in size_t width
+			)
+		{
+			uint64_t result = 0;
+
+			std::memcpy(&result, data, width);
+
+			return result;
+		}
+
+		uint64_t 
+		hash::round(
+			__in uint64_t accumulator,
+			__in uint64_t value
+			)
+		{
+			accumulator += (value * HASH_PRIME_2);
+			return (HASH_ROTATE(accumulator, 31) * HASH_PRIME_1);
+		}
+	}
+}
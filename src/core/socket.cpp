@@ -0,0 +1,423 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../../include/core/socket.h"
+#include "socket_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace core {
+
+		socket::socket(void) :
+			m_handle(SOCKET_HANDLE_INVALID),
+			m_listening(false)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		socket::~socket(void)
+		{
+			TRACE_ENTRY();
+
+			close();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		socket::accept(
+			__inout socket &client
+			)
+		{
+			int handle;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(!m_listening) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION(CC65C_CORE_SOCKET_EXCEPTION_CLOSED);
+			}
+
+			if(client.is_open()) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_OPEN,
+					"Path[%u]=%s", client.m_path.size(), STRING_CHECK(client.m_path));
+			}
+
+			handle = ::accept(m_handle, nullptr, nullptr);
+			if(handle == SOCKET_HANDLE_INVALID) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_ACCEPT_FAILED,
+					"Path[%u]=%s, Error=%s", m_path.size(), STRING_CHECK(m_path), std::strerror(errno));
+			}
+
+			std::lock_guard<std::recursive_mutex> client_lock(client.m_socket_mutex);
+			client.m_handle = handle;
+			client.m_path = m_path;
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		socket::as_string(
+			__in const socket &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << CC65C_CORE_SOCKET_HEADER << " " 
+				<< ((reference.m_handle != SOCKET_HANDLE_INVALID) ? (reference.m_listening ? "Listening" : "Open") 
+					: "Closed");
+
+			if(verbose) {
+				result << ", Instance=" << SCALAR_AS_HEX(uintptr_t, &reference);
+			}
+
+			if(reference.m_handle != SOCKET_HANDLE_INVALID) {
+				result << ", Path[" << reference.m_path.size() << "]=" << reference.m_path
+					<< ", Handle=" << reference.m_handle;
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		socket::close(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(m_handle != SOCKET_HANDLE_INVALID) {
+				::close(m_handle);
+				m_handle = SOCKET_HANDLE_INVALID;
+
+				if(m_listening) {
+					::unlink(m_path.c_str());
+					m_listening = false;
+				}
+
+				m_path.clear();
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		socket::connect(
+			__in const std::string &path
+			)
+		{
+			struct sockaddr_un address = {};
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(path.size() >= sizeof(address.sun_path)) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_PATH_LENGTH,
+					"Path[%u]=%s", path.size(), STRING_CHECK(path));
+			}
+
+			open();
+			address.sun_family = AF_UNIX;
+			std::memcpy(address.sun_path, path.c_str(), path.size());
+
+			if(::connect(m_handle, (struct sockaddr *) &address, sizeof(address))) {
+				close();
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_CONNECT_FAILED,
+					"Path[%u]=%s, Error=%s", path.size(), STRING_CHECK(path), std::strerror(errno));
+			}
+
+			m_path = path;
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		socket::is_open(void)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			result = (m_handle != SOCKET_HANDLE_INVALID);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		socket::listen(
+			__in const std::string &path
+			)
+		{
+			struct stat status;
+			struct sockaddr_un address = {};
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(path.size() >= sizeof(address.sun_path)) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_PATH_LENGTH,
+					"Path[%u]=%s", path.size(), STRING_CHECK(path));
+			}
+
+			if(!::lstat(path.c_str(), &status)) {
+
+				if(!S_ISSOCK(status.st_mode)) {
+					THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_PATH_INVALID,
+						"Path[%u]=%s", path.size(), STRING_CHECK(path));
+				}
+
+				::unlink(path.c_str());
+			}
+
+			open();
+			address.sun_family = AF_UNIX;
+			std::memcpy(address.sun_path, path.c_str(), path.size());
+
+			if(::bind(m_handle, (struct sockaddr *) &address, sizeof(address)) 
+					|| ::listen(m_handle, SOCKET_BACKLOG)) {
+				close();
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_LISTEN_FAILED,
+					"Path[%u]=%s, Error=%s", path.size(), STRING_CHECK(path), std::strerror(errno));
+			}
+
+			m_listening = true;
+			m_path = path;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		socket::open(void)
+		{
+			TRACE_ENTRY();
+
+			if(m_handle != SOCKET_HANDLE_INVALID) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_OPEN,
+					"Path[%u]=%s", m_path.size(), STRING_CHECK(m_path));
+			}
+
+			m_handle = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+			if(m_handle == SOCKET_HANDLE_INVALID) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_OPEN,
+					"Error=%s", std::strerror(errno));
+			}
+
+			TRACE_EXIT();
+		}
+
+		bool 
+		socket::read(
+			__inout void *data,
+			__in size_t length
+			)
+		{
+			ssize_t count;
+			bool result = true;
+			size_t position = 0;
+
+			TRACE_ENTRY();
+
+			while(position < length) {
+
+				count = ::recv(m_handle, (uint8_t *) data + position, length - position, 0);
+				if(count < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					}
+
+					THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_RECEIVE_FAILED,
+						"Path[%u]=%s, Error=%s", m_path.size(), STRING_CHECK(m_path), std::strerror(errno));
+				} else if(!count) {
+
+					if(position) {
+						THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_RECEIVE_FAILED,
+							"Path[%u]=%s, Received=%u, Expecting=%u", m_path.size(), STRING_CHECK(m_path), 
+							position, length);
+					}
+
+					result = false;
+					break;
+				}
+
+				position += count;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		bool 
+		socket::receive(
+			__inout std::string &data
+			)
+		{
+			bool result;
+			uint32_t length = 0;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(m_handle == SOCKET_HANDLE_INVALID) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION(CC65C_CORE_SOCKET_EXCEPTION_CLOSED);
+			}
+
+			data.clear();
+
+			result = read(&length, sizeof(length));
+			if(result) {
+
+				if(length > SOCKET_FRAME_MAX) {
+					THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_FRAME_LENGTH,
+						"Length=%u, Maximum=%u", length, SOCKET_FRAME_MAX);
+				}
+
+				data.resize(length);
+
+				if(length && !read(&data[0], length)) {
+					THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_RECEIVE_FAILED,
+						"Path[%u]=%s, Expecting=%u", m_path.size(), STRING_CHECK(m_path), length);
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void 
+		socket::send(
+			__in const std::string &data
+			)
+		{
+			uint32_t length = data.size();
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(m_handle == SOCKET_HANDLE_INVALID) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION(CC65C_CORE_SOCKET_EXCEPTION_CLOSED);
+			}
+
+			if(data.size() > SOCKET_FRAME_MAX) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_FRAME_LENGTH,
+					"Length=%u, Maximum=%u", data.size(), SOCKET_FRAME_MAX);
+			}
+
+			write(&length, sizeof(length));
+			write(data.c_str(), data.size());
+
+			TRACE_EXIT();
+		}
+
+		void 
+		socket::set_timeout(
+			__in uint32_t timeout
+			)
+		{
+			struct timeval value = {};
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			if(m_handle == SOCKET_HANDLE_INVALID) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION(CC65C_CORE_SOCKET_EXCEPTION_CLOSED);
+			}
+
+			value.tv_sec = (timeout / 1000);
+			value.tv_usec = ((timeout % 1000) * 1000);
+
+			if(::setsockopt(m_handle, SOL_SOCKET, SO_RCVTIMEO, &value, sizeof(value)) 
+					|| ::setsockopt(m_handle, SOL_SOCKET, SO_SNDTIMEO, &value, sizeof(value))) {
+				THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_TIMEOUT_FAILED,
+					"Path[%u]=%s, Timeout=%u ms, Error=%s", m_path.size(), STRING_CHECK(m_path), timeout, 
+					std::strerror(errno));
+			}
+
+			TRACE_EXIT();
+		}
+
+		std::string 
+		socket::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_socket_mutex);
+
+			result = cc65c::core::socket::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		void 
+		socket::write(
+			__in const void *data,
+			__in size_t length
+			)
+		{
+			ssize_t count;
+			size_t position = 0;
+
+			TRACE_ENTRY();
+
+			while(position < length) {
+
+				count = ::send(m_handle, (const uint8_t *) data + position, length - position, MSG_NOSIGNAL);
+				if(count < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					}
+
+					THROW_CC65C_CORE_SOCKET_EXCEPTION_FORMAT(CC65C_CORE_SOCKET_EXCEPTION_SEND_FAILED,
+						"Path[%u]=%s, Error=%s", m_path.size(), STRING_CHECK(m_path), std::strerror(errno));
+				}
+
+				position += count;
+			}
+
+			TRACE_EXIT();
+		}
+	}
+}
@@ -0,0 +1,1324 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "../../include/emulator/processor.h"
+#include "processor_type.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace emulator {
+
+		#define EXECUTE_ROW(_ROW_) \
+			&processor::execute<(_ROW_) | 0x0>, &processor::execute<(_ROW_) | 0x1>, \
+			&processor::execute<(_ROW_) | 0x2>, &processor::execute<(_ROW_) | 0x3>, \
+			&processor::execute<(_ROW_) | 0x4>, &processor::execute<(_ROW_) | 0x5>, \
+			&processor::execute<(_ROW_) | 0x6>, &processor::execute<(_ROW_) | 0x7>, \
+			&processor::execute<(_ROW_) | 0x8>, &processor::execute<(_ROW_) | 0x9>, \
+			&processor::execute<(_ROW_) | 0xa>, &processor::execute<(_ROW_) | 0xb>, \
+			&processor::execute<(_ROW_) | 0xc>, &processor::execute<(_ROW_) | 0xd>, \
+			&processor::execute<(_ROW_) | 0xe>, &processor::execute<(_ROW_) | 0xf>
+
+		#define PAGE_CROSSED(_LEFT_, _RIGHT_) ((((_LEFT_) ^ (_RIGHT_)) & 0xff00) != 0)
+
+		processor::processor(void) :
+			m_accumulator(0),
+			m_block(MEMORY_LENGTH),
+			m_block_enabled(true),
+			m_block_page(MEMORY_PAGE_COUNT),
+			m_cycle(0),
+			m_dirty_pending(false),
+			m_index_x(0),
+			m_index_y(0),
+			m_instruction(0),
+			m_interrupt(0),
+			m_profile_enabled(false),
+			m_program_counter(0),
+			m_stack_pointer(PROCESSOR_STACK_POINTER_RESET),
+			m_state(PROCESSOR_STATE_STOPPED),
+			m_status(PROCESSOR_FLAG_UNUSED)
+		{
+			TRACE_ENTRY();
+
+			std::memset(m_memory, 0, MEMORY_LENGTH);
+
+			TRACE_EXIT();
+		}
+
+		processor::processor(
+			__in const processor &other
+			) :
+				m_accumulator(other.m_accumulator),
+				m_block(other.m_block),
+				m_block_cached(other.m_block_cached),
+				m_block_enabled(other.m_block_enabled),
+				m_block_page(other.m_block_page),
+				m_cycle(other.m_cycle),
+				m_dirty(other.m_dirty),
+				m_dirty_pending(other.m_dirty_pending),
+				m_index_x(other.m_index_x),
+				m_index_y(other.m_index_y),
+				m_instruction(other.m_instruction),
+				m_interrupt(other.m_interrupt),
+				m_profile(other.m_profile),
+				m_profile_enabled(other.m_profile_enabled),
+				m_program_counter(other.m_program_counter),
+				m_stack_pointer(other.m_stack_pointer),
+				m_state(other.m_state),
+				m_status(other.m_status)
+		{
+			TRACE_ENTRY();
+
+			std::memcpy(m_memory, other.m_memory, MEMORY_LENGTH);
+
+			TRACE_EXIT();
+		}
+
+		processor::~processor(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		processor &
+		processor::operator=(
+			__in const processor &other
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			if(this != &other) {
+				m_accumulator = other.m_accumulator;
+				m_block = other.m_block;
+				m_block_cached = other.m_block_cached;
+				m_block_enabled = other.m_block_enabled;
+				m_block_page = other.m_block_page;
+				m_cycle = other.m_cycle;
+				m_dirty = other.m_dirty;
+				m_dirty_pending = other.m_dirty_pending;
+				m_index_x = other.m_index_x;
+				m_index_y = other.m_index_y;
+				m_instruction = other.m_instruction;
+				m_interrupt = other.m_interrupt;
+				std::memcpy(m_memory, other.m_memory, MEMORY_LENGTH);
+				m_profile = other.m_profile;
+				m_profile_enabled = other.m_profile_enabled;
+				m_program_counter = other.m_program_counter;
+				m_stack_pointer = other.m_stack_pointer;
+				m_state = other.m_state;
+				m_status = other.m_status;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", this);
+			return *this;
+		}
+
+		const cc65c::emulator::execute_t processor::EXECUTE[] = {
+			EXECUTE_ROW(0x00), EXECUTE_ROW(0x10), EXECUTE_ROW(0x20), EXECUTE_ROW(0x30),
+			EXECUTE_ROW(0x40), EXECUTE_ROW(0x50), EXECUTE_ROW(0x60), EXECUTE_ROW(0x70),
+			EXECUTE_ROW(0x80), EXECUTE_ROW(0x90), EXECUTE_ROW(0xa0), EXECUTE_ROW(0xb0),
+			EXECUTE_ROW(0xc0), EXECUTE_ROW(0xd0), EXECUTE_ROW(0xe0), EXECUTE_ROW(0xf0),
+			};
+
+		uint8_t &
+		processor::accumulator(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%02x", m_accumulator);
+			return m_accumulator;
+		}
+
+		inline void 
+		processor::add(
+			__in uint8_t value
+			)
+		{
+			int16_t overflow;
+			uint16_t low, sum;
+			uint8_t carry = (m_status & PROCESSOR_FLAG_CARRY);
+
+			if(m_status & PROCESSOR_FLAG_DECIMAL) {
+				low = (m_accumulator & 0x0f) + (value & 0x0f) + carry;
+				if(low >= 0x0a) {
+					low = ((low + 0x06) & 0x0f) + 0x10;
+				}
+
+				sum = (m_accumulator & 0xf0) + (value & 0xf0) + low;
+				overflow = (int8_t) (m_accumulator & 0xf0) + (int8_t) (value & 0xf0) + (int16_t) low;
+				flag(PROCESSOR_FLAG_OVERFLOW, (overflow < INT8_MIN) || (overflow > INT8_MAX));
+
+				if(sum >= 0xa0) {
+					sum += 0x60;
+				}
+
+				++m_cycle;
+			} else {
+				sum = m_accumulator + value + carry;
+				flag(PROCESSOR_FLAG_OVERFLOW, ~(m_accumulator ^ value) & (m_accumulator ^ sum) & 0x80);
+			}
+
+			flag(PROCESSOR_FLAG_CARRY, sum > UINT8_MAX);
+			m_accumulator = result(sum);
+		}
+
+		std::string 
+		processor::as_string(
+			__in const processor &reference,
+			__in_opt bool verbose
+			)
+		{
+			size_t iter;
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << "[" << PROCESSOR_STATE_STRING(reference.m_state) << "] PC=" 
+				<< SCALAR_AS_HEX(uint16_t, reference.m_program_counter)
+				<< ", A=" << SCALAR_AS_HEX(uint8_t, reference.m_accumulator)
+				<< ", X=" << SCALAR_AS_HEX(uint8_t, reference.m_index_x)
+				<< ", Y=" << SCALAR_AS_HEX(uint8_t, reference.m_index_y)
+				<< ", S=" << SCALAR_AS_HEX(uint8_t, reference.m_stack_pointer)
+				<< ", P=" << SCALAR_AS_HEX(uint8_t, reference.m_status) << " (";
+
+			for(iter = PROCESSOR_FLAG_STR.size(); iter > 0; --iter) {
+				result << (char) ((reference.m_status & (1 << (iter - 1))) ? std::toupper(PROCESSOR_FLAG_STR.at(iter - 1)) 
+					: PROCESSOR_FLAG_STR.at(iter - 1));
+			}
+
+			result << ")";
+
+			if(verbose) {
+				result << ", Cycles=" << reference.m_cycle << ", Instructions=" << reference.m_instruction;
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		bool 
+		processor::block_cache(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%x", m_block_enabled);
+			return m_block_enabled;
+		}
+
+		inline void 
+		processor::branch(
+			__in bool taken,
+			__in uint8_t offset
+			)
+		{
+			uint16_t target;
+
+			if(taken) {
+				target = m_program_counter + (int8_t) offset;
+				m_cycle += (PAGE_CROSSED(m_program_counter, target) ? 2 : 1);
+				m_program_counter = target;
+			}
+		}
+
+		void 
+		processor::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			invalidate(0, MEMORY_LENGTH);
+			flush();
+			m_accumulator = 0;
+			m_cycle = 0;
+			m_index_x = 0;
+			m_index_y = 0;
+			m_instruction = 0;
+			m_interrupt = 0;
+			std::memset(m_memory, 0, MEMORY_LENGTH);
+
+			if(!m_profile.empty()) {
+				m_profile.assign(MEMORY_LENGTH, cc65c::emulator::profile_t());
+			}
+
+			m_program_counter = 0;
+			m_stack_pointer = PROCESSOR_STACK_POINTER_RESET;
+			m_state = PROCESSOR_STATE_STOPPED;
+			m_status = PROCESSOR_FLAG_UNUSED;
+
+			TRACE_EXIT();
+		}
+
+		inline void 
+		processor::compare(
+			__in uint8_t left,
+			__in uint8_t right
+			)
+		{
+			flag(PROCESSOR_FLAG_CARRY, left >= right);
+			result(left - right);
+		}
+
+		void 
+		processor::compile(
+			__in uint16_t address
+			)
+		{
+			uint8_t opcode;
+			uint16_t page;
+			std::vector<cc65c::emulator::instruction_t> &block = m_block[address];
+			uint16_t entry = address, page_last = (address >> CHAR_BIT);
+
+			block.clear();
+			reference(page_last, entry);
+
+			do {
+				opcode = m_memory[address];
+				block.push_back(std::make_tuple(EXECUTE[opcode], OPCODE_LENGTH(opcode), 
+					m_memory[(uint16_t) (address + 1)] | (m_memory[(uint16_t) (address + 2)] << CHAR_BIT)));
+
+				page = ((uint16_t) (address + OPCODE_LENGTH(opcode) - 1) >> CHAR_BIT);
+				if(page != page_last) {
+					reference(page, entry);
+					page_last = page;
+				}
+
+				address += OPCODE_LENGTH(opcode);
+			} while(!OPCODE_BLOCK_END_CONTAINS(OPCODE_COMMAND(opcode)) && (block.size() < BLOCK_LENGTH_MAX) 
+				&& (address > entry));
+		}
+
+		uint64_t 
+		processor::cycles(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%llu", m_cycle);
+			return m_cycle;
+		}
+
+		template <bool _PROFILE_> inline uint32_t 
+		processor::dispatch(void)
+		{
+			uint8_t opcode;
+			uint16_t address, operand;
+			uint64_t begin = m_cycle, entry;
+
+			if(m_interrupt) {
+				service();
+			}
+
+			address = m_program_counter;
+			entry = m_cycle;
+			opcode = m_memory[address];
+			operand = m_memory[(uint16_t) (address + 1)] | (m_memory[(uint16_t) (address + 2)] << CHAR_BIT);
+			m_program_counter += OPCODE_LENGTH(opcode);
+			++m_instruction;
+			(this->*EXECUTE[opcode])(operand);
+
+			if(_PROFILE_) {
+				cc65c::emulator::profile_t &profile = m_profile[address];
+				std::get<PROFILE_CYCLE>(profile) += (m_cycle - entry);
+				++std::get<PROFILE_INSTRUCTION>(profile);
+			}
+
+			return (m_cycle - begin);
+		}
+
+		template <bool _PROFILE_> inline void 
+		processor::dispatch_block(
+			__in uint64_t end
+			)
+		{
+			uint16_t address;
+			uint64_t entry;
+			std::vector<cc65c::emulator::instruction_t>::const_iterator iter;
+
+			if(m_dirty_pending) {
+				flush();
+			}
+
+			if(m_interrupt) {
+				service();
+			}
+
+			if(m_block[m_program_counter].empty()) {
+				compile(m_program_counter);
+			}
+
+			const std::vector<cc65c::emulator::instruction_t> &block = m_block[m_program_counter];
+
+			for(iter = block.begin(); iter != block.end(); ++iter) {
+				address = m_program_counter;
+				entry = m_cycle;
+				m_program_counter += std::get<INSTRUCTION_LENGTH>(*iter);
+				++m_instruction;
+				(this->*std::get<INSTRUCTION_HANDLER>(*iter))(std::get<INSTRUCTION_OPERAND>(*iter));
+
+				if(_PROFILE_) {
+					cc65c::emulator::profile_t &profile = m_profile[address];
+					std::get<PROFILE_CYCLE>(profile) += (m_cycle - entry);
+					++std::get<PROFILE_INSTRUCTION>(profile);
+				}
+
+				if(m_dirty_pending || m_interrupt || (m_cycle >= end)) {
+					break;
+				}
+			}
+		}
+
+		template <uint8_t _OPCODE_> void 
+		processor::execute(
+			__in uint16_t operand
+			)
+		{
+			uint8_t value;
+			uint16_t address = 0;
+			const uint32_t command = OPCODE_COMMAND(_OPCODE_), mode = OPCODE_MODE(_OPCODE_);
+
+			m_cycle += OPCODE_CYCLE(_OPCODE_);
+
+			switch(mode) {
+				case cc65c::assembler::ADDRESS_MODE_ABSOLUTE:
+					address = operand;
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_INDIRECT:
+					address = read_word(operand + m_index_x);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_X:
+					address = operand + m_index_x;
+
+					if(PAGE_CROSSED(address, operand) && OPCODE_PAGE_PENALTY_CONTAINS(command)) {
+						++m_cycle;
+					}
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDEX_Y:
+					address = operand + m_index_y;
+
+					if(PAGE_CROSSED(address, operand) && OPCODE_PAGE_PENALTY_CONTAINS(command)) {
+						++m_cycle;
+					}
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ABSOLUTE_INDIRECT:
+					address = read_word(operand);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_IMMEDIATE:
+					address = (m_program_counter - 1);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ZERO_PAGE:
+					address = (uint8_t) operand;
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_INDIRECT:
+					address = read_word_zero_page(operand + m_index_x);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_X:
+					address = (uint8_t) (operand + m_index_x);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDEX_Y:
+					address = (uint8_t) (operand + m_index_y);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT:
+					address = read_word_zero_page(operand);
+					break;
+				case cc65c::assembler::ADDRESS_MODE_ZERO_PAGE_INDIRECT_INDEX:
+					operand = read_word_zero_page(operand);
+					address = operand + m_index_y;
+
+					if(PAGE_CROSSED(address, operand) && OPCODE_PAGE_PENALTY_CONTAINS(command)) {
+						++m_cycle;
+					}
+					break;
+				default:
+					break;
+			}
+
+			switch(command) {
+				case cc65c::assembler::KEYWORD_COMMAND_ADC:
+					add(read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_AND:
+					m_accumulator = result(m_accumulator & read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_ASL:
+
+					if(mode == cc65c::assembler::ADDRESS_MODE_ACCUMULATOR) {
+						m_accumulator = shift_left(m_accumulator);
+					} else {
+						write_memory(address, shift_left(read_memory(address)));
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BBR0:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR1:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR2:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR3:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR4:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR5:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR6:
+				case cc65c::assembler::KEYWORD_COMMAND_BBR7:
+					branch(!(read_memory((uint8_t) operand) 
+						& (1 << ((command - cc65c::assembler::KEYWORD_COMMAND_BBR0) % CHAR_BIT))), operand >> CHAR_BIT);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BBS0:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS1:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS2:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS3:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS4:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS5:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS6:
+				case cc65c::assembler::KEYWORD_COMMAND_BBS7:
+					branch(read_memory((uint8_t) operand) 
+						& (1 << ((command - cc65c::assembler::KEYWORD_COMMAND_BBS0) % CHAR_BIT)), operand >> CHAR_BIT);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BCC:
+					branch(!(m_status & PROCESSOR_FLAG_CARRY), operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BCS:
+					branch(m_status & PROCESSOR_FLAG_CARRY, operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BEQ:
+					branch(m_status & PROCESSOR_FLAG_ZERO, operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BIT:
+
+					value = read_memory(address);
+					flag(PROCESSOR_FLAG_ZERO, !(m_accumulator & value));
+
+					if(mode != cc65c::assembler::ADDRESS_MODE_IMMEDIATE) {
+						flag(PROCESSOR_FLAG_NEGATIVE, value & PROCESSOR_FLAG_NEGATIVE);
+						flag(PROCESSOR_FLAG_OVERFLOW, value & PROCESSOR_FLAG_OVERFLOW);
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BMI:
+					branch(m_status & PROCESSOR_FLAG_NEGATIVE, operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BNE:
+					branch(!(m_status & PROCESSOR_FLAG_ZERO), operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BPL:
+					branch(!(m_status & PROCESSOR_FLAG_NEGATIVE), operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BRA:
+					branch(true, operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BRK:
+					vector(VECTOR_MASKABLE, true);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BVC:
+					branch(!(m_status & PROCESSOR_FLAG_OVERFLOW), operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_BVS:
+					branch(m_status & PROCESSOR_FLAG_OVERFLOW, operand);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CLC:
+					m_status &= ~PROCESSOR_FLAG_CARRY;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CLD:
+					m_status &= ~PROCESSOR_FLAG_DECIMAL;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CLI:
+					m_status &= ~PROCESSOR_FLAG_INTERRUPT_DISABLE;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CLV:
+					m_status &= ~PROCESSOR_FLAG_OVERFLOW;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CMP:
+					compare(m_accumulator, read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CPX:
+					compare(m_index_x, read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_CPY:
+					compare(m_index_y, read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_DEC:
+
+					if(mode == cc65c::assembler::ADDRESS_MODE_ACCUMULATOR) {
+						m_accumulator = result(m_accumulator - 1);
+					} else {
+						write_memory(address, result(read_memory(address) - 1));
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_DEX:
+					m_index_x = result(m_index_x - 1);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_DEY:
+					m_index_y = result(m_index_y - 1);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_EOR:
+					m_accumulator = result(m_accumulator ^ read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_INC:
+
+					if(mode == cc65c::assembler::ADDRESS_MODE_ACCUMULATOR) {
+						m_accumulator = result(m_accumulator + 1);
+					} else {
+						write_memory(address, result(read_memory(address) + 1));
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_INX:
+					m_index_x = result(m_index_x + 1);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_INY:
+					m_index_y = result(m_index_y + 1);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_JMP:
+					m_program_counter = address;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_JSR:
+					push_word(m_program_counter - 1);
+					m_program_counter = address;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_LDA:
+					m_accumulator = result(read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_LDX:
+					m_index_x = result(read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_LDY:
+					m_index_y = result(read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_LSR:
+
+					if(mode == cc65c::assembler::ADDRESS_MODE_ACCUMULATOR) {
+						m_accumulator = shift_right(m_accumulator);
+					} else {
+						write_memory(address, shift_right(read_memory(address)));
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_NOP:
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_ORA:
+					m_accumulator = result(m_accumulator | read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PHA:
+					push(m_accumulator);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PHP:
+					push(m_status | PROCESSOR_FLAG_BREAK | PROCESSOR_FLAG_UNUSED);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PHX:
+					push(m_index_x);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PHY:
+					push(m_index_y);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PLA:
+					m_accumulator = result(pull());
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PLP:
+					m_status = ((pull() & ~PROCESSOR_FLAG_BREAK) | PROCESSOR_FLAG_UNUSED);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PLX:
+					m_index_x = result(pull());
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_PLY:
+					m_index_y = result(pull());
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_RMB0:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB1:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB2:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB3:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB4:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB5:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB6:
+				case cc65c::assembler::KEYWORD_COMMAND_RMB7:
+					write_memory(address, read_memory(address) 
+						& ~(1 << ((command - cc65c::assembler::KEYWORD_COMMAND_RMB0) % CHAR_BIT)));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_ROL:
+
+					if(mode == cc65c::assembler::ADDRESS_MODE_ACCUMULATOR) {
+						m_accumulator = rotate_left(m_accumulator);
+					} else {
+						write_memory(address, rotate_left(read_memory(address)));
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_ROR:
+
+					if(mode == cc65c::assembler::ADDRESS_MODE_ACCUMULATOR) {
+						m_accumulator = rotate_right(m_accumulator);
+					} else {
+						write_memory(address, rotate_right(read_memory(address)));
+					}
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_RTI:
+					m_status = ((pull() & ~PROCESSOR_FLAG_BREAK) | PROCESSOR_FLAG_UNUSED);
+					m_program_counter = pull_word();
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_RTS:
+					m_program_counter = pull_word() + 1;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_SBC:
+					subtract(read_memory(address));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_SEC:
+					m_status |= PROCESSOR_FLAG_CARRY;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_SED:
+					m_status |= PROCESSOR_FLAG_DECIMAL;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_SEI:
+					m_status |= PROCESSOR_FLAG_INTERRUPT_DISABLE;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_SMB0:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB1:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB2:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB3:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB4:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB5:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB6:
+				case cc65c::assembler::KEYWORD_COMMAND_SMB7:
+					write_memory(address, read_memory(address) 
+						| (1 << ((command - cc65c::assembler::KEYWORD_COMMAND_SMB0) % CHAR_BIT)));
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_STA:
+					write_memory(address, m_accumulator);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_STP:
+					m_state = PROCESSOR_STATE_STOPPED;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_STX:
+					write_memory(address, m_index_x);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_STY:
+					write_memory(address, m_index_y);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_STZ:
+					write_memory(address, 0);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TAX:
+					m_index_x = result(m_accumulator);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TAY:
+					m_index_y = result(m_accumulator);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TRB:
+					value = read_memory(address);
+					flag(PROCESSOR_FLAG_ZERO, !(m_accumulator & value));
+					write_memory(address, value & ~m_accumulator);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TSB:
+					value = read_memory(address);
+					flag(PROCESSOR_FLAG_ZERO, !(m_accumulator & value));
+					write_memory(address, value | m_accumulator);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TSX:
+					m_index_x = result(m_stack_pointer);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TXA:
+					m_accumulator = result(m_index_x);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TXS:
+					m_stack_pointer = m_index_x;
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_TYA:
+					m_accumulator = result(m_index_y);
+					break;
+				case cc65c::assembler::KEYWORD_COMMAND_WAI:
+
+					if(!m_interrupt) {
+						m_state = PROCESSOR_STATE_WAITING;
+					}
+					break;
+				default:
+					break;
+			}
+		}
+
+		inline void 
+		processor::flag(
+			__in uint8_t mask,
+			__in bool value
+			)
+		{
+
+			if(value) {
+				m_status |= mask;
+			} else {
+				m_status &= ~mask;
+			}
+		}
+
+		void 
+		processor::flush(void)
+		{
+			size_t page;
+			std::vector<uint16_t>::const_iterator iter;
+
+			for(page = 0; page < MEMORY_PAGE_COUNT; ++page) {
+
+				if(m_dirty.test(page)) {
+
+					for(iter = m_block_page[page].begin(); iter != m_block_page[page].end(); ++iter) {
+						m_block[*iter].clear();
+					}
+
+					m_block_cached.reset(page);
+					m_block_page[page].clear();
+				}
+			}
+
+			m_dirty.reset();
+			m_dirty_pending = false;
+		}
+
+		uint8_t &
+		processor::index_x(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%02x", m_index_x);
+			return m_index_x;
+		}
+
+		uint8_t &
+		processor::index_y(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%02x", m_index_y);
+			return m_index_y;
+		}
+
+		uint64_t 
+		processor::instructions(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%llu", m_instruction);
+			return m_instruction;
+		}
+
+		void 
+		processor::interrupt(
+			__in_opt bool maskable
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			m_interrupt |= (maskable ? PROCESSOR_INTERRUPT_MASKABLE : PROCESSOR_INTERRUPT_NON_MASKABLE);
+			if(m_state == PROCESSOR_STATE_WAITING) {
+				m_state = PROCESSOR_STATE_RUNNING;
+			}
+
+			TRACE_EXIT();
+		}
+
+		inline void 
+		processor::invalidate(
+			__in uint16_t address,
+			__in size_t length
+			)
+		{
+			size_t page;
+
+			for(page = (address >> CHAR_BIT); length && (page <= ((address + length - 1) >> CHAR_BIT)); ++page) {
+
+				if(m_block_cached.test(page)) {
+					m_dirty.set(page);
+					m_dirty_pending = true;
+				}
+			}
+		}
+
+		void 
+		processor::load(
+			__in uint16_t address,
+			__in const std::vector<uint8_t> &data
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			if((address + data.size()) > MEMORY_LENGTH) {
+				THROW_CC65C_EMULATOR_PROCESSOR_EXCEPTION_FORMAT(CC65C_EMULATOR_PROCESSOR_EXCEPTION_LENGTH, 
+					"Address=%04x, Length=%u", address, data.size());
+			}
+
+			if(!data.empty()) {
+				std::memcpy(m_memory + address, &data.front(), data.size());
+				invalidate(address, data.size());
+			}
+
+			TRACE_EXIT();
+		}
+
+		void 
+		processor::load(
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator begin,
+			__in std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator end
+			)
+		{
+			std::vector<cc65c::assembler::block_t>::const_iterator block;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			for(; begin != end; ++begin) {
+
+				for(block = begin->second.begin(); block != begin->second.end(); ++block) {
+					load(block->first, block->second);
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		const std::vector<cc65c::emulator::profile_t> &
+		processor::profile(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			if(m_profile.empty()) {
+				m_profile.resize(MEMORY_LENGTH);
+			}
+
+			TRACE_EXIT_FORMAT("Result[%u]=%p", m_profile.size(), &m_profile);
+			return m_profile;
+		}
+
+		bool 
+		processor::profiling(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%x", m_profile_enabled);
+			return m_profile_enabled;
+		}
+
+		uint16_t &
+		processor::program_counter(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%04x", m_program_counter);
+			return m_program_counter;
+		}
+
+		inline uint8_t 
+		processor::pull(void)
+		{
+			return m_memory[MEMORY_STACK | ++m_stack_pointer];
+		}
+
+		inline uint16_t 
+		processor::pull_word(void)
+		{
+			uint16_t result = pull();
+
+			return (result | (pull() << CHAR_BIT));
+		}
+
+		inline void 
+		processor::push(
+			__in uint8_t value
+			)
+		{
+			write_memory(MEMORY_STACK | m_stack_pointer--, value);
+		}
+
+		inline void 
+		processor::push_word(
+			__in uint16_t value
+			)
+		{
+			push(value >> CHAR_BIT);
+			push(value);
+		}
+
+		uint8_t 
+		processor::read(
+			__in uint16_t address
+			)
+		{
+			uint8_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			result = read_memory(address);
+
+			TRACE_EXIT_FORMAT("Result=%02x", result);
+			return result;
+		}
+
+		inline uint8_t 
+		processor::read_memory(
+			__in uint16_t address
+			)
+		{
+			return m_memory[address];
+		}
+
+		inline uint16_t 
+		processor::read_word(
+			__in uint16_t address
+			)
+		{
+			return (m_memory[address] | (m_memory[(uint16_t) (address + 1)] << CHAR_BIT));
+		}
+
+		inline uint16_t 
+		processor::read_word_zero_page(
+			__in uint8_t address
+			)
+		{
+			return (m_memory[address] | (m_memory[(uint8_t) (address + 1)] << CHAR_BIT));
+		}
+
+		void 
+		processor::reset(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			m_cycle = PROCESSOR_RESET_CYCLE;
+			m_instruction = 0;
+			m_interrupt = 0;
+			m_program_counter = read_word(VECTOR_RESET);
+			m_stack_pointer = PROCESSOR_STACK_POINTER_RESET;
+			m_state = PROCESSOR_STATE_RUNNING;
+			m_status = ((m_status | PROCESSOR_FLAG_INTERRUPT_DISABLE | PROCESSOR_FLAG_UNUSED) 
+				& ~(PROCESSOR_FLAG_BREAK | PROCESSOR_FLAG_DECIMAL));
+
+			TRACE_EXIT();
+		}
+
+		inline void 
+		processor::reference(
+			__in uint16_t page,
+			__in uint16_t entry
+			)
+		{
+			std::vector<uint16_t> &list = m_block_page[page];
+
+			if(std::find(list.begin(), list.end(), entry) == list.end()) {
+				list.push_back(entry);
+			}
+
+			m_block_cached.set(page);
+		}
+
+		inline uint8_t 
+		processor::result(
+			__in uint8_t value
+			)
+		{
+			flag(PROCESSOR_FLAG_NEGATIVE, value & PROCESSOR_FLAG_NEGATIVE);
+			flag(PROCESSOR_FLAG_ZERO, !value);
+
+			return value;
+		}
+
+		inline uint8_t 
+		processor::rotate_left(
+			__in uint8_t value
+			)
+		{
+			uint8_t carry = (m_status & PROCESSOR_FLAG_CARRY);
+
+			flag(PROCESSOR_FLAG_CARRY, value & 0x80);
+
+			return result((value << 1) | carry);
+		}
+
+		inline uint8_t 
+		processor::rotate_right(
+			__in uint8_t value
+			)
+		{
+			uint8_t carry = (m_status & PROCESSOR_FLAG_CARRY);
+
+			flag(PROCESSOR_FLAG_CARRY, value & 0x01);
+
+			return result((value >> 1) | (carry << 7));
+		}
+
+		uint64_t 
+		processor::run(
+			__in uint64_t cycles
+			)
+		{
+			uint64_t begin, end;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			begin = m_cycle;
+			end = (begin + cycles);
+
+			while((m_state == PROCESSOR_STATE_RUNNING) && (m_cycle < end)) {
+
+				if(m_block_enabled) {
+
+					if(m_profile_enabled) {
+						dispatch_block<true>(end);
+					} else {
+						dispatch_block<false>(end);
+					}
+				} else if(m_profile_enabled) {
+					dispatch<true>();
+				} else {
+					dispatch<false>();
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%llu", m_cycle - begin);
+			return (m_cycle - begin);
+		}
+
+		inline void 
+		processor::service(void)
+		{
+
+			if(m_interrupt & PROCESSOR_INTERRUPT_NON_MASKABLE) {
+				m_interrupt &= ~PROCESSOR_INTERRUPT_NON_MASKABLE;
+				vector(VECTOR_NON_MASKABLE, false);
+				m_cycle += PROCESSOR_INTERRUPT_CYCLE;
+			} else if(!(m_status & PROCESSOR_FLAG_INTERRUPT_DISABLE)) {
+				m_interrupt &= ~PROCESSOR_INTERRUPT_MASKABLE;
+				vector(VECTOR_MASKABLE, false);
+				m_cycle += PROCESSOR_INTERRUPT_CYCLE;
+			}
+		}
+
+		inline uint8_t 
+		processor::shift_left(
+			__in uint8_t value
+			)
+		{
+			flag(PROCESSOR_FLAG_CARRY, value & 0x80);
+
+			return result(value << 1);
+		}
+
+		inline uint8_t 
+		processor::shift_right(
+			__in uint8_t value
+			)
+		{
+			flag(PROCESSOR_FLAG_CARRY, value & 0x01);
+
+			return result(value >> 1);
+		}
+
+		void 
+		processor::set_block_cache(
+			__in bool enabled
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			if(!enabled) {
+				invalidate(0, MEMORY_LENGTH);
+				flush();
+			}
+
+			m_block_enabled = enabled;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		processor::set_profiling(
+			__in bool enabled
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			if(enabled && m_profile.empty()) {
+				m_profile.resize(MEMORY_LENGTH);
+			}
+
+			m_profile_enabled = enabled;
+
+			TRACE_EXIT();
+		}
+
+		uint8_t &
+		processor::stack_pointer(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%02x", m_stack_pointer);
+			return m_stack_pointer;
+		}
+
+		cc65c::emulator::processor_state_t 
+		processor::state(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%x(%s)", m_state, PROCESSOR_STATE_STRING(m_state));
+			return m_state;
+		}
+
+		uint8_t &
+		processor::status(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%02x", m_status);
+			return m_status;
+		}
+
+		uint32_t 
+		processor::step(void)
+		{
+			uint32_t result = 0;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			if(m_state == PROCESSOR_STATE_RUNNING) {
+				result = (m_profile_enabled ? dispatch<true>() : dispatch<false>());
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		inline void 
+		processor::subtract(
+			__in uint8_t value
+			)
+		{
+			int16_t difference, low;
+			uint8_t carry = (m_status & PROCESSOR_FLAG_CARRY);
+
+			difference = (int16_t) m_accumulator - value + carry - 1;
+			flag(PROCESSOR_FLAG_OVERFLOW, (m_accumulator ^ value) & (m_accumulator ^ difference) & 0x80);
+			flag(PROCESSOR_FLAG_CARRY, difference >= 0);
+
+			if(m_status & PROCESSOR_FLAG_DECIMAL) {
+				low = (int16_t) (m_accumulator & 0x0f) - (value & 0x0f) + carry - 1;
+
+				if(difference < 0) {
+					difference -= 0x60;
+				}
+
+				if(low < 0) {
+					difference -= 0x06;
+				}
+
+				++m_cycle;
+			}
+
+			m_accumulator = result(difference);
+		}
+
+		std::string 
+		processor::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			result = as_string(*this, verbose);
+
+			TRACE_EXIT_FORMAT("Result=%s", STRING_CHECK(result));
+			return result;
+		}
+
+		inline void 
+		processor::vector(
+			__in uint16_t address,
+			__in bool software
+			)
+		{
+			push_word(m_program_counter);
+			push((software ? (m_status | PROCESSOR_FLAG_BREAK) : (m_status & ~PROCESSOR_FLAG_BREAK)) 
+				| PROCESSOR_FLAG_UNUSED);
+			m_status = ((m_status | PROCESSOR_FLAG_INTERRUPT_DISABLE) & ~PROCESSOR_FLAG_DECIMAL);
+			m_program_counter = read_word(address);
+		}
+
+		void 
+		processor::write(
+			__in uint16_t address,
+			__in uint8_t value
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_processor_mutex);
+
+			write_memory(address, value);
+
+			TRACE_EXIT();
+		}
+
+		inline void 
+		processor::write_memory(
+			__in uint16_t address,
+			__in uint8_t value
+			)
+		{
+			m_memory[address] = value;
+
+			if(m_block_cached[address >> CHAR_BIT]) {
+				m_dirty[address >> CHAR_BIT] = true;
+				m_dirty_pending = true;
+			}
+		}
+	}
+}
@@ -0,0 +1,386 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "../../include/emulator/profiler.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace emulator {
+
+		#define PROFILER_COLUMN_MAX 0x40
+		#define PROFILER_FILL ' '
+
+		profiler::profiler(void) :
+			m_cycle(0),
+			m_instruction(0)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		profiler::profiler(
+			__in const profiler &other
+			) :
+				m_cycle(other.m_cycle),
+				m_instruction(other.m_instruction),
+				m_label(other.m_label),
+				m_line(other.m_line)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		profiler::~profiler(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		profiler &
+		profiler::operator=(
+			__in const profiler &other
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			if(this != &other) {
+				m_cycle = other.m_cycle;
+				m_instruction = other.m_instruction;
+				m_label = other.m_label;
+				m_line = other.m_line;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", this);
+			return *this;
+		}
+
+		std::string 
+		profiler::as_string(
+			__in const profiler &reference,
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY();
+
+			result << "Cycles=" << reference.m_cycle << ", Instructions=" << reference.m_instruction;
+
+			if(verbose) {
+				result << ", Labels=" << reference.m_label.size() << ", Lines=" << reference.m_line.size();
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void 
+		profiler::clear(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			m_cycle = 0;
+			m_instruction = 0;
+			m_label.clear();
+			m_line.clear();
+
+			TRACE_EXIT();
+		}
+
+		void 
+		profiler::collect(
+			__inout cc65c::assembler::generator &input,
+			__inout cc65c::emulator::processor &source
+			)
+		{
+			uint16_t address;
+			size_t count, index, length, offset;
+			uint64_t cycle, instruction;
+			const cc65c::assembler::block_t *block;
+			std::vector<cc65c::assembler::listing_metadata_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			clear();
+
+			const std::vector<cc65c::emulator::profile_t> &profile = source.profile();
+			m_label.push_back(std::make_tuple(0, 0, 0, 0, PROFILER_LABEL_ANONYMOUS, std::string(), 0));
+
+			for(iter = input.listing_begin(); iter != input.listing_end(); ++iter) {
+				block = nullptr;
+				cycle = 0;
+				instruction = 0;
+				length = std::get<cc65c::assembler::LISTING_METADATA_LENGTH>(*iter);
+				offset = std::get<cc65c::assembler::LISTING_METADATA_OFFSET>(*iter);
+
+				try {
+					const std::vector<cc65c::assembler::block_t> &segment = input.segment(
+						std::get<cc65c::assembler::LISTING_METADATA_SEGMENT>(*iter));
+
+					if(std::get<cc65c::assembler::LISTING_METADATA_BLOCK>(*iter) < segment.size()) {
+						block = &segment.at(std::get<cc65c::assembler::LISTING_METADATA_BLOCK>(*iter));
+					}
+				} catch(cc65c::core::exception &exc) { }
+
+				address = (block ? (block->first + offset) : 0);
+				length = (block ? std::min(length, block->second.size() - offset) : 0);
+
+				for(index = 0; index < length; ++index) {
+					const cc65c::emulator::profile_t &entry = profile.at((uint16_t) (address + index));
+					cycle += std::get<PROFILE_CYCLE>(entry);
+					instruction += std::get<PROFILE_INSTRUCTION>(entry);
+				}
+
+				const std::string &path = std::get<cc65c::assembler::LISTING_METADATA_PATH>(*iter);
+				if(!std::get<cc65c::assembler::LISTING_METADATA_LABEL>(*iter).empty()) {
+					m_label.push_back(std::make_tuple(address, std::get<cc65c::assembler::LISTING_METADATA_COLUMN>(*iter), 
+						0, 0, std::get<cc65c::assembler::LISTING_METADATA_LABEL>(*iter), path, 
+						std::get<cc65c::assembler::LISTING_METADATA_ROW>(*iter)));
+				}
+
+				std::get<PROFILER_LABEL_CYCLE>(m_label.back()) += cycle;
+				std::get<PROFILER_LABEL_INSTRUCTION>(m_label.back()) += instruction;
+				m_cycle += cycle;
+				m_instruction += instruction;
+
+				const std::string &line = input.listing_line(path, std::get<cc65c::assembler::LISTING_METADATA_ROW>(*iter));
+
+				for(count = line.size(); (count > 0) && (line.at(count - 1) == PROFILER_FILL); --count);
+				m_line.push_back(std::make_tuple(address, std::get<cc65c::assembler::LISTING_METADATA_COLUMN>(*iter), 
+					cycle, instruction, length, path, std::get<cc65c::assembler::LISTING_METADATA_ROW>(*iter), 
+					line.substr(0, count)));
+			}
+
+			if(!std::get<PROFILER_LABEL_INSTRUCTION>(m_label.front())) {
+				m_label.erase(m_label.begin());
+			}
+
+			std::stable_sort(m_label.begin(), m_label.end(), [](const cc65c::emulator::profiler_label_t &left, 
+					const cc65c::emulator::profiler_label_t &right) { 
+				return ((std::get<PROFILER_LABEL_CYCLE>(left) > std::get<PROFILER_LABEL_CYCLE>(right)) 
+					|| ((std::get<PROFILER_LABEL_CYCLE>(left) == std::get<PROFILER_LABEL_CYCLE>(right)) 
+					&& (std::get<PROFILER_LABEL_INSTRUCTION>(left) > std::get<PROFILER_LABEL_INSTRUCTION>(right))));
+				});
+
+			TRACE_EXIT();
+		}
+
+		uint64_t 
+		profiler::cycles(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%llu", m_cycle);
+			return m_cycle;
+		}
+
+		std::string 
+		profiler::hotspot(
+			__in_opt size_t count
+			)
+		{
+			size_t rank = 0;
+			std::stringstream result;
+			char field[PROFILER_COLUMN_MAX];
+			std::vector<cc65c::emulator::profiler_label_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			std::snprintf(field, PROFILER_COLUMN_MAX, "%4s %12s %7s %12s  ", "RANK", "CYCLES", "%", "INSTRUCTIONS");
+			result << field << "LABEL" << std::endl;
+
+			for(iter = m_label.begin(); (iter != m_label.end()) && (!count || (rank < count)); ++iter) {
+				std::snprintf(field, PROFILER_COLUMN_MAX, "%4u %12llu %6.2f%% %12llu  ", (unsigned) ++rank, 
+					(unsigned long long) std::get<PROFILER_LABEL_CYCLE>(*iter), 
+					percent(std::get<PROFILER_LABEL_CYCLE>(*iter), m_cycle), 
+					(unsigned long long) std::get<PROFILER_LABEL_INSTRUCTION>(*iter));
+				result << field << std::get<PROFILER_LABEL_NAME>(*iter);
+
+				if(std::get<PROFILER_LABEL_NAME>(*iter) != PROFILER_LABEL_ANONYMOUS) {
+					result << " (";
+
+					if(!std::get<PROFILER_LABEL_PATH>(*iter).empty()) {
+						result << std::get<PROFILER_LABEL_PATH>(*iter) << ":";
+					}
+
+					result << (std::get<PROFILER_LABEL_ROW>(*iter) + 1) << ":" 
+						<< (std::get<PROFILER_LABEL_COLUMN>(*iter) + 1) << ", " 
+						<< SCALAR_AS_HEX(uint16_t, std::get<PROFILER_LABEL_ADDRESS>(*iter)) << ")";
+				}
+
+				result << std::endl;
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		uint64_t 
+		profiler::instructions(void)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			TRACE_EXIT_FORMAT("Result=%llu", m_instruction);
+			return m_instruction;
+		}
+
+		std::vector<cc65c::emulator::profiler_label_t>::const_iterator 
+		profiler::label_begin(void)
+		{
+			std::vector<cc65c::emulator::profiler_label_t>::const_iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			result = m_label.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::vector<cc65c::emulator::profiler_label_t>::const_iterator 
+		profiler::label_end(void)
+		{
+			std::vector<cc65c::emulator::profiler_label_t>::const_iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			result = m_label.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::vector<cc65c::emulator::profiler_line_t>::const_iterator 
+		profiler::line_begin(void)
+		{
+			std::vector<cc65c::emulator::profiler_line_t>::const_iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			result = m_line.begin();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::vector<cc65c::emulator::profiler_line_t>::const_iterator 
+		profiler::line_end(void)
+		{
+			std::vector<cc65c::emulator::profiler_line_t>::const_iterator result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			result = m_line.end();
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		std::string 
+		profiler::listing(void)
+		{
+			std::string path;
+			std::stringstream result;
+			char field[PROFILER_COLUMN_MAX];
+			std::vector<cc65c::emulator::profiler_line_t>::const_iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			for(iter = m_line.begin(); iter != m_line.end(); ++iter) {
+
+				if(std::get<PROFILER_LINE_PATH>(*iter) != path) {
+					path = std::get<PROFILER_LINE_PATH>(*iter);
+
+					if(!path.empty()) {
+						result << "; " << path << std::endl;
+					}
+				}
+
+				if(std::get<PROFILER_LINE_LENGTH>(*iter)) {
+					std::snprintf(field, PROFILER_COLUMN_MAX, "%04X %12llu %12llu %6.2f%%", 
+						std::get<PROFILER_LINE_ADDRESS>(*iter), 
+						(unsigned long long) std::get<PROFILER_LINE_INSTRUCTION>(*iter), 
+						(unsigned long long) std::get<PROFILER_LINE_CYCLE>(*iter), 
+						percent(std::get<PROFILER_LINE_CYCLE>(*iter), m_cycle));
+				} else {
+					std::snprintf(field, PROFILER_COLUMN_MAX, "%38s", "");
+				}
+
+				result << field;
+
+				std::snprintf(field, PROFILER_COLUMN_MAX, "  %5u:%-3u  ", 
+					(unsigned) (std::get<PROFILER_LINE_ROW>(*iter) + 1), 
+					(unsigned) (std::get<PROFILER_LINE_COLUMN>(*iter) + 1));
+				result << field << std::get<PROFILER_LINE_TEXT>(*iter) << std::endl;
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		double 
+		profiler::percent(
+			__in uint64_t value,
+			__in uint64_t total
+			)
+		{
+			return (total ? ((100.0 * value) / total) : 0.0);
+		}
+
+		std::string 
+		profiler::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::string result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::recursive_mutex> lock(m_profiler_mutex);
+
+			result = cc65c::emulator::profiler::as_string(*this, verbose);
+
+			TRACE_EXIT();
+			return result;
+		}
+	}
+}
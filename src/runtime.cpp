@@ -22,6 +22,8 @@
 namespace cc65c {
 
 	runtime::runtime(void) :
+		m_artifact(cc65c::assembler::artifact::acquire()),
+		m_cache(cc65c::assembler::cache::acquire()),
 		m_symbol(cc65c::assembler::symbol::acquire()),
 		m_trace(cc65c::core::trace::acquire()),
 		m_uuid(cc65c::core::uuid::acquire())
@@ -87,6 +89,8 @@ namespace cc65c {
 
 		m_uuid.initialize();
 		m_symbol.initialize();
+		m_cache.initialize();
+		m_artifact.initialize();
 
 		// TODO
 
@@ -100,6 +104,8 @@ namespace cc65c {
 
 		// TODO
 
+		m_artifact.uninitialize();
+		m_cache.uninitialize();
 		m_symbol.uninitialize();
 		m_uuid.uninitialize();
 
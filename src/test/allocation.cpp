@@ -0,0 +1,138 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/test/allocation.h"
+#include "../../include/core/trace.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		std::atomic<bool> allocation::m_active(false);
+
+		std::atomic<uint64_t> allocation::m_bytes[ALLOCATION_PHASE_MAX + 1];
+
+		std::atomic<uint64_t> allocation::m_count[ALLOCATION_PHASE_MAX + 1];
+
+		std::atomic<bool> allocation::m_installed(false);
+
+		std::atomic<uint64_t> allocation::m_release[ALLOCATION_PHASE_MAX + 1];
+
+		std::thread::id allocation::m_thread;
+
+		void 
+		allocation::allocate(
+			__in size_t size
+			)
+		{
+			size_t phase;
+
+			if(!m_installed) {
+				m_installed = true;
+			}
+
+			if(m_active && (std::this_thread::get_id() == m_thread)) {
+				phase = cc65c::core::counter::acquire().phase();
+				m_bytes[phase] += size;
+				++m_count[phase];
+			}
+		}
+
+		void 
+		allocation::deallocate(void)
+		{
+
+			if(m_active && (std::this_thread::get_id() == m_thread)) {
+				++m_release[cc65c::core::counter::acquire().phase()];
+			}
+		}
+
+		bool 
+		allocation::installed(void)
+		{
+			bool result;
+
+			TRACE_ENTRY();
+
+			result = m_installed;
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		cc65c::test::allocation_metadata_t 
+		allocation::metadata(
+			__in_opt size_t phase
+			)
+		{
+			size_t index;
+			cc65c::test::allocation_metadata_t result;
+
+			TRACE_ENTRY();
+
+			for(index = 0; index <= ALLOCATION_PHASE_MAX; ++index) {
+
+				if((phase == ALLOCATION_PHASE_ALL) || (phase == index)) {
+					std::get<ALLOCATION_METADATA_BYTES>(result) += m_bytes[index];
+					std::get<ALLOCATION_METADATA_COUNT>(result) += m_count[index];
+					std::get<ALLOCATION_METADATA_RELEASE>(result) += m_release[index];
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result={%llu, %llu, %llu}", std::get<ALLOCATION_METADATA_BYTES>(result),
+				std::get<ALLOCATION_METADATA_COUNT>(result), std::get<ALLOCATION_METADATA_RELEASE>(result));
+			return result;
+		}
+
+		void 
+		allocation::start(void)
+		{
+			size_t index;
+
+			TRACE_ENTRY();
+
+			cc65c::core::counter &instance = cc65c::core::counter::acquire();
+			if(!instance.is_initialized()) {
+				instance.initialize();
+			}
+
+			m_active = false;
+
+			for(index = 0; index <= ALLOCATION_PHASE_MAX; ++index) {
+				m_bytes[index] = 0;
+				m_count[index] = 0;
+				m_release[index] = 0;
+			}
+
+			m_thread = std::this_thread::get_id();
+			m_active = true;
+
+			TRACE_EXIT();
+		}
+
+		void 
+		allocation::stop(void)
+		{
+			TRACE_ENTRY();
+
+			m_active = false;
+
+			TRACE_EXIT();
+		}
+	}
+}
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
 #include "../../include/test/fixture.h"
 #include "fixture_type.h"
 #include "../../include/core/trace.h"
@@ -32,8 +33,11 @@ namespace cc65c {
 			((_TYPE_) > STATUS_MAX ? STRING_UNKNOWN : STRING_CHECK(STATUS_STR[_TYPE_]))
 
 		fixture::fixture(
-			__in const std::string &name
+			__in const std::string &name,
+			__in_opt double duration_max
 			) :
+				m_duration(0.0, 0.0, 0.0),
+				m_duration_max(duration_max),
 				m_name(name),
 				m_status(STATUS_INCONCLUSIVE)
 		{
@@ -49,6 +53,8 @@ namespace cc65c {
 		fixture::fixture(
 			__in const fixture &other
 			) :
+				m_duration(other.m_duration),
+				m_duration_max(other.m_duration_max),
 				m_name(other.m_name),
 				m_status(other.m_status)
 		{
@@ -70,6 +76,8 @@ namespace cc65c {
 			TRACE_ENTRY();
 
 			if(this != &other) {
+				m_duration = other.m_duration;
+				m_duration_max = other.m_duration_max;
 				m_name = other.m_name;
 				m_status = other.m_status;
 			}
@@ -78,6 +86,52 @@ namespace cc65c {
 			return *this;
 		}
 
+		void 
+		fixture::allocation_begin(void)
+		{
+			TRACE_ENTRY();
+
+			cc65c::test::allocation::start();
+
+			TRACE_EXIT();
+		}
+
+		cc65c::test::status_t 
+		fixture::allocation_end(
+			__in size_t units,
+			__in double budget,
+			__in_opt size_t phase
+			)
+		{
+			double ratio;
+			cc65c::test::allocation_metadata_t entry;
+			cc65c::test::status_t result = STATUS_SUCCESS;
+
+			TRACE_ENTRY();
+
+			cc65c::test::allocation::stop();
+
+			if(phase > ALLOCATION_PHASE_ALL) {
+				THROW_CC65C_TEST_FIXTURE_EXCEPTION_FORMAT(CC65C_TEST_FIXTURE_EXCEPTION_INVALID_PHASE,
+					"Phase=%x", phase);
+			}
+
+			entry = cc65c::test::allocation::metadata(phase);
+			ratio = (units ? (std::get<ALLOCATION_METADATA_COUNT>(entry) / (double) units) : 0.0);
+
+			if(ratio > budget) {
+				std::cerr << "ALLOCATION_BUDGET[" << m_name << "/" << ((phase <= COUNTER_PHASE_MAX) 
+						? COUNTER_PHASE_STRING(phase) : ((phase == ALLOCATION_PHASE_ALL) ? "all" : "none"))
+					<< "]: " << std::fixed << std::setprecision(3) << ratio << " > " << budget << " (" 
+					<< std::get<ALLOCATION_METADATA_COUNT>(entry) << " allocations, " 
+					<< std::get<ALLOCATION_METADATA_BYTES>(entry) << " bytes, " << units << " units)" << std::endl;
+				result = STATUS_FAILURE;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
 		std::string 
 		fixture::as_name(
 			__in const fixture &reference
@@ -107,10 +161,50 @@ namespace cc65c {
 				<< ", Status=" << reference.m_status 
 				<< "(" << STATUS_STRING(reference.m_status) << ")";
 
+			if(verbose) {
+				result << ", Duration={" << std::get<FIXTURE_DURATION_SETUP>(reference.m_duration) 
+					<< ", " << std::get<FIXTURE_DURATION_TEST>(reference.m_duration) 
+					<< ", " << std::get<FIXTURE_DURATION_TEARDOWN>(reference.m_duration) << "} ms";
+
+				if(reference.m_duration_max > FIXTURE_DURATION_UNLIMITED) {
+					result << " (max " << reference.m_duration_max << " ms)";
+				}
+			}
+
 			TRACE_EXIT();
 			return result.str();
 		}
 
+		cc65c::test::fixture_duration_t 
+		fixture::duration(void)
+		{
+			cc65c::test::fixture_duration_t result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			result = m_duration;
+
+			TRACE_EXIT();
+			return result;
+		}
+
+		double 
+		fixture::duration_max(void)
+		{
+			double result;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			result = m_duration_max;
+
+			TRACE_EXIT_FORMAT("Result=%f", result);
+			return result;
+		}
+
 		const std::string &
 		fixture::name(void)
 		{
@@ -129,6 +223,7 @@ namespace cc65c {
 
 			std::lock_guard<std::mutex> lock(m_mutex);
 
+			m_duration = cc65c::test::fixture_duration_t(0.0, 0.0, 0.0);
 			m_status = STATUS_INCONCLUSIVE;
 
 			TRACE_EXIT();
@@ -137,6 +232,8 @@ namespace cc65c {
 		cc65c::test::status_t 
 		fixture::run(void)
 		{
+			double total;
+			std::chrono::steady_clock::time_point begin;
 			cc65c::test::status_t result_setup, result_teardown = STATUS_INCONCLUSIVE, 
 				result_test = STATUS_INCONCLUSIVE;
 
@@ -144,10 +241,23 @@ namespace cc65c {
 
 			std::lock_guard<std::mutex> lock(m_mutex);
 
+			m_duration = cc65c::test::fixture_duration_t(0.0, 0.0, 0.0);
+
+			begin = std::chrono::steady_clock::now();
 			result_setup = on_setup();
+			std::get<FIXTURE_DURATION_SETUP>(m_duration) = std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - begin).count();
+
 			if(result_setup == STATUS_SUCCESS) {
+				begin = std::chrono::steady_clock::now();
 				result_test = on_test();
+				std::get<FIXTURE_DURATION_TEST>(m_duration) = std::chrono::duration<double, std::milli>(
+					std::chrono::steady_clock::now() - begin).count();
+
+				begin = std::chrono::steady_clock::now();
 				result_teardown = on_teardown();
+				std::get<FIXTURE_DURATION_TEARDOWN>(m_duration) = std::chrono::duration<double, std::milli>(
+					std::chrono::steady_clock::now() - begin).count();
 			}
 
 			if((result_setup == STATUS_FAILURE) 
@@ -162,10 +272,35 @@ namespace cc65c {
 				m_status = STATUS_SUCCESS;
 			}
 
+			total = (std::get<FIXTURE_DURATION_SETUP>(m_duration) + std::get<FIXTURE_DURATION_TEST>(m_duration)
+				+ std::get<FIXTURE_DURATION_TEARDOWN>(m_duration));
+
+			if((m_duration_max > FIXTURE_DURATION_UNLIMITED) && (total > m_duration_max)) {
+				TRACE_WARNING_FORMAT("Fixture duration exceeded", "Name=%s, Duration=%f ms, Maximum=%f ms, "
+					"Setup=%f ms, Test=%f ms, Teardown=%f ms", STRING_CHECK(m_name), total, m_duration_max, 
+					std::get<FIXTURE_DURATION_SETUP>(m_duration), std::get<FIXTURE_DURATION_TEST>(m_duration), 
+					std::get<FIXTURE_DURATION_TEARDOWN>(m_duration));
+				m_status = STATUS_FAILURE;
+			}
+
 			TRACE_EXIT_FORMAT("Result=%x(%s)", m_status, STATUS_STRING(m_status));
 			return m_status;
 		}
 
+		void 
+		fixture::set_duration_max(
+			__in double duration_max
+			)
+		{
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_duration_max = duration_max;
+
+			TRACE_EXIT();
+		}
+
 		cc65c::test::status_t 
 		fixture::status(void)
 		{
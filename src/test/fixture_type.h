@@ -35,12 +35,14 @@ namespace cc65c {
 
 		enum {
 			CC65C_TEST_FIXTURE_EXCEPTION_INVALID = 0,
+			CC65C_TEST_FIXTURE_EXCEPTION_INVALID_PHASE,
 		};
 
-		#define CC65C_TEST_FIXTURE_EXCEPTION_MAX CC65C_TEST_FIXTURE_EXCEPTION_INVALID
+		#define CC65C_TEST_FIXTURE_EXCEPTION_MAX CC65C_TEST_FIXTURE_EXCEPTION_INVALID_PHASE
 
 		static const std::string CC65C_TEST_FIXTURE_EXCEPTION_STR[] = {
 			CC65C_TEST_FIXTURE_EXCEPTION_HEADER "Invalid fixture name",
+			CC65C_TEST_FIXTURE_EXCEPTION_HEADER "Invalid allocation phase",
 			};
 
 		#define CC65C_TEST_FIXTURE_EXCEPTION_STRING(_TYPE_) \
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <thread>
 #include "../../include/test/suite.h"
 #include "suite_type.h"
 #include "../../include/core/trace.h"
@@ -202,6 +203,26 @@ namespace cc65c {
 			return result;
 		}
 
+		void 
+		suite::duration(
+			__inout std::map<std::string, cc65c::test::fixture_duration_t> &output
+			)
+		{
+			std::map<std::string, std::reference_wrapper<cc65c::test::fixture>>::iterator iter;
+
+			TRACE_ENTRY();
+
+			std::lock_guard<std::mutex> lock(m_fixture_mutex);
+
+			output.clear();
+
+			for(iter = m_fixture.begin(); iter != m_fixture.end(); ++iter) {
+				output.insert(std::make_pair(iter->first, iter->second.get().duration()));
+			}
+
+			TRACE_EXIT();
+		}
+
 		const std::string &
 		suite::name(void)
 		{
@@ -271,27 +292,71 @@ namespace cc65c {
 
 		cc65c::test::status_t 
 		suite::run(
-			__inout std::map<std::string, cc65c::test::status_t> &output
+			__inout std::map<std::string, cc65c::test::status_t> &output,
+			__in_opt size_t jobs
 			)
 		{
-			cc65c::test::status_t result = STATUS_SUCCESS, status;
+			size_t index;
+			std::atomic<bool> abort(false);
+			std::atomic<size_t> next(0);
+			std::vector<std::thread> worker;
+			std::vector<std::exception_ptr> error;
+			std::vector<std::thread>::iterator thread;
+			std::vector<cc65c::test::status_t> status;
+			cc65c::test::status_t result = STATUS_SUCCESS;
+			std::vector<std::reference_wrapper<cc65c::test::fixture>> entry;
 			std::map<std::string, std::reference_wrapper<cc65c::test::fixture>>::iterator iter;
 
 			TRACE_ENTRY();
 
+			if(!jobs) {
+				THROW_CC65C_TEST_SUITE_EXCEPTION_FORMAT(CC65C_TEST_SUITE_EXCEPTION_INVALID_JOBS, "Jobs=%u", jobs);
+			} else if((jobs > SUITE_JOBS_DEFAULT) && cc65c::test::allocation::installed()) {
+				THROW_CC65C_TEST_SUITE_EXCEPTION_FORMAT(CC65C_TEST_SUITE_EXCEPTION_INVALID_JOBS, 
+					"Jobs=%u, Allocation harness installed", jobs);
+			}
+
 			std::lock_guard<std::mutex> lock(m_fixture_mutex);
 
 			output.clear();
 
 			for(iter = m_fixture.begin(); iter != m_fixture.end(); ++iter) {
+				entry.push_back(iter->second);
+			}
 
-				status = iter->second.get().run();
-				if((status == STATUS_FAILURE) 
-						|| ((result == STATUS_SUCCESS) && (status == STATUS_INCONCLUSIVE))) {
-					result = status;
+			status.assign(entry.size(), STATUS_INCONCLUSIVE);
+			error.assign(entry.size(), nullptr);
+			jobs = std::min(jobs, entry.size());
+
+			if(jobs > SUITE_JOBS_DEFAULT) {
+
+				for(index = 0; index < jobs; ++index) {
+					worker.push_back(std::thread(cc65c::test::suite::run_worker, std::cref(entry), std::ref(next),
+						std::ref(status), std::ref(error), std::ref(abort)));
 				}
 
-				output.insert(std::make_pair(iter->first, status));
+				for(thread = worker.begin(); thread != worker.end(); ++thread) {
+					thread->join();
+				}
+			} else {
+				cc65c::test::suite::run_worker(entry, next, status, error, abort);
+			}
+
+			for(index = 0; index < error.size(); ++index) {
+
+				if(error.at(index)) {
+					std::rethrow_exception(error.at(index));
+				}
+			}
+
+			for(index = 0, iter = m_fixture.begin(); iter != m_fixture.end(); ++index, ++iter) {
+
+				if((status.at(index) == STATUS_FAILURE) 
+						|| ((result == STATUS_SUCCESS) && (status.at(index) == STATUS_INCONCLUSIVE))) {
+					result = status.at(index);
+				}
+
+				output.insert(std::make_pair(iter->first, status.at(index)));
 			}
 
 			TRACE_EXIT_FORMAT("Result=%x", result);
@@ -315,6 +380,37 @@ namespace cc65c {
 			return result;
 		}
 
+		void 
+		suite::run_worker(
+			__in const std::vector<std::reference_wrapper<cc65c::test::fixture>> &entry,
+			__inout std::atomic<size_t> &next,
+			__inout std::vector<cc65c::test::status_t> &status,
+			__inout std::vector<std::exception_ptr> &error,
+			__inout std::atomic<bool> &abort
+			)
+		{
+			size_t index;
+
+			TRACE_ENTRY();
+
+			while(!abort) {
+
+				index = next++;
+				if(index >= entry.size()) {
+					break;
+				}
+
+				try {
+					status.at(index) = entry.at(index).get().run();
+				} catch(...) {
+					error.at(index) = std::current_exception();
+					abort = true;
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		cc65c::test::status_t 
 		suite::status(
 			__inout std::map<std::string, cc65c::test::status_t> &output
@@ -36,6 +36,7 @@ namespace cc65c {
 		enum {
 			CC65C_TEST_SUITE_EXCEPTION_DUPLICATE = 0,
 			CC65C_TEST_SUITE_EXCEPTION_INVALID,
+			CC65C_TEST_SUITE_EXCEPTION_INVALID_JOBS,
 			CC65C_TEST_SUITE_EXCEPTION_NOT_FOUND,
 		};
 
@@ -44,6 +45,7 @@ namespace cc65c {
 		static const std::string CC65C_TEST_SUITE_EXCEPTION_STR[] = {
 			CC65C_TEST_SUITE_EXCEPTION_HEADER "Duplicate fixture",
 			CC65C_TEST_SUITE_EXCEPTION_HEADER "Invalid suite name",
+			CC65C_TEST_SUITE_EXCEPTION_HEADER "Invalid job count",
 			CC65C_TEST_SUITE_EXCEPTION_HEADER "Fixture does not exist",
 			};
 
@@ -0,0 +1,229 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+#include <tuple>
+#include "../../include/runtime.h"
+#include "../../include/assembler/writer.h"
+#include "../../include/core/stream.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define ARTIFACT_DIRECTORY "./build/artifact_XXXXXX"
+		#define ARTIFACT_FIXTURE_NAME "ARTIFACT_FIXTURE"
+		#define ARTIFACT_INCLUDE "/test.inc"
+		#define ARTIFACT_INPUT "/test.asm"
+		#define ARTIFACT_OUTPUT "/test.bin"
+		#define ARTIFACT_SUITE_NAME "ARTIFACT_SUITE"
+
+		enum {
+			ARTIFACT_TEST_TITLE = 0,
+			ARTIFACT_TEST_INCLUDE,
+			ARTIFACT_TEST_DEFINE,
+			ARTIFACT_TEST_HIT,
+			ARTIFACT_TEST_OUTPUT,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, std::map<std::string, int32_t>, bool, 
+				std::vector<uint8_t>>> ARTIFACT_TEST_SET = {
+			std::make_tuple("TEST_MISS", "\tdb 0x03\n", std::map<std::string, int32_t>(), false, 
+				std::vector<uint8_t>({ 0xa9, 0x01, 0x03, })),
+			std::make_tuple("TEST_HIT", "\tdb 0x03\n", std::map<std::string, int32_t>(), true, 
+				std::vector<uint8_t>({ 0xa9, 0x01, 0x03, })),
+			std::make_tuple("TEST_DEFINE_MISS", "\tdb 0x03\n", std::map<std::string, int32_t>({ { "variant", 2 }, }), 
+				false, std::vector<uint8_t>({ 0xa9, 0x01, 0x03, })),
+			std::make_tuple("TEST_DEFINE_HIT", "\tdb 0x03\n", std::map<std::string, int32_t>({ { "variant", 2 }, }), 
+				true, std::vector<uint8_t>({ 0xa9, 0x01, 0x03, })),
+			std::make_tuple("TEST_DEPENDENCY_MISS", "\tdb 0x02\n", std::map<std::string, int32_t>(), false, 
+				std::vector<uint8_t>({ 0xa9, 0x01, 0x02, })),
+			std::make_tuple("TEST_DEPENDENCY_HIT", "\tdb 0x02\n", std::map<std::string, int32_t>(), true, 
+				std::vector<uint8_t>({ 0xa9, 0x01, 0x02, })),
+
+			// TODO: Add additional test cases
+
+			};
+
+		class fixture_artifact :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_artifact(void) :
+					cc65c::test::fixture(ARTIFACT_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					char directory[] = ARTIFACT_DIRECTORY;
+
+					TRACE_ENTRY();
+
+					if(mkdtemp(directory)) {
+						m_directory = directory;
+						cc65c::assembler::artifact::acquire().set_directory(m_directory);
+						write_file(m_directory + ARTIFACT_INPUT, "org 0x0200\n\tlda #0x01\n\tincs \"" + m_directory 
+							+ ARTIFACT_INCLUDE + "\"\n");
+					} else {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					cc65c::assembler::artifact::acquire().set_directory(std::string());
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<std::tuple<std::string, std::string, std::map<std::string, int32_t>, bool, 
+						std::vector<uint8_t>>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = ARTIFACT_TEST_SET.begin(); iter != ARTIFACT_TEST_SET.end(); ++iter) {
+
+						result = test_input(std::get<ARTIFACT_TEST_INCLUDE>(*iter), std::get<ARTIFACT_TEST_DEFINE>(*iter), 
+							std::get<ARTIFACT_TEST_HIT>(*iter), std::get<ARTIFACT_TEST_OUTPUT>(*iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", STRING_CHECK(std::get<ARTIFACT_TEST_TITLE>(*iter)));
+							break;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				cc65c::test::status_t 
+				test_input(
+					__in const std::string &include,
+					__in const std::map<std::string, int32_t> &define,
+					__in bool hit,
+					__in const std::vector<uint8_t> &output
+					)
+				{
+					bool found;
+					std::vector<uint8_t> bytes;
+					std::string input = (m_directory + ARTIFACT_INPUT);
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<std::string> path({ m_directory + ARTIFACT_OUTPUT });
+					std::map<std::string, int32_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					try {
+						write_file(m_directory + ARTIFACT_INCLUDE, include);
+						std::remove(path.front().c_str());
+
+						cc65c::assembler::artifact &instance = cc65c::assembler::artifact::acquire();
+
+						found = instance.fetch(input, define, path);
+						if(found != hit) {
+							THROW_EXCEPTION_FORMAT("Build cache mismatch", "Expecting=%x, Found=%x", hit, found);
+						}
+
+						if(!found) {
+							cc65c::assembler::generator gen(input, true);
+
+							for(iter = define.begin(); iter != define.end(); ++iter) {
+								gen.define(iter->first, iter->second);
+							}
+
+							gen.enumerate();
+							cc65c::assembler::writer(path.front()).write_binary(gen.segment_begin(), gen.segment_end());
+							instance.store(input, define, std::set<std::string>(gen.dependency_begin(), 
+								gen.dependency_end()), path);
+						}
+
+						cc65c::core::stream stored(path.front(), true);
+						if(stored.size()) {
+							bytes = std::vector<uint8_t>(&stored.at(0), &stored.at(0) + stored.size());
+						}
+
+						if(bytes != output) {
+							THROW_EXCEPTION_FORMAT("Output mismatch", "Expecting=%u, Found=%u", output.size(), bytes.size());
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static void 
+				write_file(
+					__in const std::string &path,
+					__in const std::string &data
+					)
+				{
+					TRACE_ENTRY();
+
+					std::ofstream(path.c_str(), std::ios::binary | std::ios::out | std::ios::trunc) << data;
+
+					TRACE_EXIT();
+				}
+
+				std::string m_directory;
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(ARTIFACT_SUITE_NAME);
+		cc65c::test::fixture_artifact test; 
+		suite.add(test);
+		result = suite.run(ARTIFACT_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
@@ -0,0 +1,508 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tuple>
+#include "../../include/runtime.h"
+#include "../../include/assembler/generator.h"
+#include "../../include/emulator/profiler.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define EMULATOR_FIXTURE_NAME "EMULATOR_FIXTURE"
+		#define EMULATOR_ORIGIN 0x0200
+		#define EMULATOR_PROFILE_SOURCE \
+			"org 0x0200\n" \
+			"\tldx #0x03\n" \
+			"loop:\n" \
+			"\tdex\n" \
+			"\tbne loop\n" \
+			"\tjsr sub\n" \
+			"\tstp\n" \
+			"sub:\n" \
+			"\tlda #0x11\n" \
+			"\trts\n"
+		#define EMULATOR_SUITE_NAME "EMULATOR_SUITE"
+		#define EMULATOR_TIMEOUT 0x10000
+
+		enum {
+			EMULATOR_TEST_TITLE = 0,
+			EMULATOR_TEST_SOURCE,
+			EMULATOR_TEST_ACCUMULATOR,
+			EMULATOR_TEST_INDEX_X,
+			EMULATOR_TEST_INDEX_Y,
+			EMULATOR_TEST_STATUS,
+			EMULATOR_TEST_CYCLE,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, uint8_t, uint8_t, uint8_t, uint8_t, 
+				uint64_t>> EMULATOR_TEST_SET = {
+			std::make_tuple("TEST_LOAD_STORE", 
+				"org 0x0200\n"
+				"\tlda #0x42\n"
+				"\tsta 0x10\n"
+				"\tldx 0x10\n"
+				"\tldy #0x80\n"
+				"\tstp\n", 
+				0x42, 0x42, 0x80, 0xa4, 13),
+			std::make_tuple("TEST_ARITHMETIC", 
+				"org 0x0200\n"
+				"\tclc\n"
+				"\tlda #0x7f\n"
+				"\tadc #0x01\n"
+				"\ttax\n"
+				"\tsec\n"
+				"\tsbc #0x01\n"
+				"\ttay\n"
+				"\tstp\n", 
+				0x7f, 0x80, 0x7f, 0x65, 17),
+			std::make_tuple("TEST_DECIMAL", 
+				"org 0x0200\n"
+				"\tsed\n"
+				"\tclc\n"
+				"\tlda #0x19\n"
+				"\tadc #0x28\n"
+				"\ttax\n"
+				"\tsec\n"
+				"\tsbc #0x48\n"
+				"\tcld\n"
+				"\tstp\n", 
+				0x99, 0x47, 0x00, 0xa4, 21),
+			std::make_tuple("TEST_BRANCH", 
+				"org 0x0200\n"
+				"\tldx #0x05\n"
+				"loop:\n"
+				"\tdex\n"
+				"\tbne loop\n"
+				"\tstp\n", 
+				0x00, 0x00, 0x00, 0x26, 29),
+			std::make_tuple("TEST_PAGE_CROSS", 
+				"org 0x0200\n"
+				"\tldx #0x01\n"
+				"\tlda 0x02ff, x\n"
+				"\tsta 0x02ff, x\n"
+				"\tlda #0xff\n"
+				"\tsta 0x10\n"
+				"\tlda #0x02\n"
+				"\tsta 0x11\n"
+				"\tldy #0x01\n"
+				"\tlda [0x10], y\n"
+				"\tstp\n", 
+				0x00, 0x01, 0x01, 0x26, 33),
+			std::make_tuple("TEST_SUBROUTINE", 
+				"org 0x0200\n"
+				"\tldx #0x03\n"
+				"\tjsr sub\n"
+				"\tphx\n"
+				"\tply\n"
+				"\tstp\n"
+				"sub:\n"
+				"\tlda #0x11\n"
+				"\tinx\n"
+				"\trts\n", 
+				0x11, 0x04, 0x04, 0x24, 28),
+			std::make_tuple("TEST_BIT", 
+				"org 0x0200\n"
+				"\tlda #0x81\n"
+				"\tsta 0x20\n"
+				"\trmb0 0x20\n"
+				"\tsmb1 0x20\n"
+				"\tbbs1 0x20, set\n"
+				"\tlda #0x00\n"
+				"set:\n"
+				"\tbbr0 0x20, clear\n"
+				"\tlda #0x00\n"
+				"clear:\n"
+				"\tlda #0x0f\n"
+				"\ttsb 0x20\n"
+				"\ttrb 0x20\n"
+				"\tldx 0x20\n"
+				"\tstz 0x20\n"
+				"\tldy 0x20\n"
+				"\tstp\n", 
+				0x0f, 0x80, 0x00, 0x26, 51),
+			std::make_tuple("TEST_INDIRECT", 
+				"org 0x0200\n"
+				"\tjmp [vector]\n"
+				"\tstp\n"
+				"vector:\n"
+				"\tdw target\n"
+				"target:\n"
+				"\tldx #0x02\n"
+				"\tjmp [table, x]\n"
+				"\tstp\n"
+				"table:\n"
+				"\tdw 0x0000\n"
+				"\tdw done\n"
+				"done:\n"
+				"\tlda #0x33\n"
+				"\tstp\n", 
+				0x33, 0x02, 0x00, 0x24, 19),
+			std::make_tuple("TEST_BREAK", 
+				"org 0x0200\n"
+				"\tldx #0x00\n"
+				"\tbrk\n"
+				"\tdb 0xea\n"
+				"\tinx\n"
+				"\tstp\n"
+				"handler:\n"
+				"\tinx\n"
+				"\trti\n"
+				"org 0xfffe\n"
+				"\tdw handler\n", 
+				0x00, 0x02, 0x00, 0x24, 22),
+			std::make_tuple("TEST_SELF_MODIFY", 
+				"org 0x0200\n"
+				"\tldx #0x03\n"
+				"loop:\n"
+				"\tlda data\n"
+				"\tinc loop + 1\n"
+				"\tdex\n"
+				"\tbne loop\n"
+				"\tstp\n"
+				"data:\n"
+				"\tdb 0x11, 0x22, 0x33\n", 
+				0x33, 0x00, 0x00, 0x26, 49),
+
+			// TODO: Add additional test cases
+
+			};
+
+		class fixture_emulator :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_emulator(void) :
+					cc65c::test::fixture(EMULATOR_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result;
+					std::vector<std::tuple<std::string, std::string, uint8_t, uint8_t, uint8_t, uint8_t, 
+						uint64_t>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					result = test_opcode();
+					if(result != STATUS_SUCCESS) {
+						TRACE_ERROR_FORMAT("Test failure", "Name=%s", "TEST_OPCODE");
+					} else {
+
+						for(iter = EMULATOR_TEST_SET.begin(); iter != EMULATOR_TEST_SET.end(); ++iter) {
+
+							result = test_program(std::get<EMULATOR_TEST_SOURCE>(*iter), 
+								std::get<EMULATOR_TEST_ACCUMULATOR>(*iter), std::get<EMULATOR_TEST_INDEX_X>(*iter), 
+								std::get<EMULATOR_TEST_INDEX_Y>(*iter), std::get<EMULATOR_TEST_STATUS>(*iter), 
+								std::get<EMULATOR_TEST_CYCLE>(*iter), false);
+							if(result == STATUS_SUCCESS) {
+								result = test_program(std::get<EMULATOR_TEST_SOURCE>(*iter), 
+									std::get<EMULATOR_TEST_ACCUMULATOR>(*iter), std::get<EMULATOR_TEST_INDEX_X>(*iter), 
+									std::get<EMULATOR_TEST_INDEX_Y>(*iter), std::get<EMULATOR_TEST_STATUS>(*iter), 
+									std::get<EMULATOR_TEST_CYCLE>(*iter), true);
+							}
+
+							if(result != STATUS_SUCCESS) {
+								TRACE_ERROR_FORMAT("Test failure", "Name=%s", 
+									STRING_CHECK(std::get<EMULATOR_TEST_TITLE>(*iter)));
+								break;
+							}
+						}
+					}
+
+					if(result == STATUS_SUCCESS) {
+
+						result = test_interrupt();
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", "TEST_INTERRUPT");
+						}
+					}
+
+					if(result == STATUS_SUCCESS) {
+
+						result = test_profile(false);
+						if(result == STATUS_SUCCESS) {
+							result = test_profile(true);
+						}
+
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", "TEST_PROFILE");
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static void 
+				assemble(
+					__in const std::string &source,
+					__inout cc65c::emulator::processor &instance
+					)
+				{
+					TRACE_ENTRY();
+
+					cc65c::assembler::generator gen(source, false);
+					gen.enumerate();
+					instance.clear();
+					instance.write(cc65c::emulator::VECTOR_RESET, EMULATOR_ORIGIN & UINT8_MAX);
+					instance.write(cc65c::emulator::VECTOR_RESET + 1, EMULATOR_ORIGIN >> CHAR_BIT);
+					instance.load(gen.segment_begin(), gen.segment_end());
+					instance.reset();
+
+					TRACE_EXIT();
+				}
+
+				static cc65c::test::status_t 
+				test_interrupt(void)
+				{
+					uint64_t cycles;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::emulator::processor instance;
+
+						assemble("org 0x0200\n\tcli\n\twai\n\tstp\nhandler:\n\tlda #0x55\n\trti\norg 0xfffe\n\tdw handler\n", 
+							instance);
+
+						cycles = instance.run(EMULATOR_TIMEOUT);
+						if((cycles != 5) || (instance.state() != cc65c::emulator::PROCESSOR_STATE_WAITING)) {
+							THROW_EXCEPTION_FORMAT("Wait mismatch", "Cycles=%llu, State=%x", cycles, instance.state());
+						}
+
+						instance.interrupt();
+
+						cycles = instance.run(EMULATOR_TIMEOUT);
+						if((cycles != 18) || (instance.state() != cc65c::emulator::PROCESSOR_STATE_STOPPED)
+								|| (instance.accumulator() != 0x55)) {
+							THROW_EXCEPTION_FORMAT("Interrupt mismatch", "Cycles=%llu, State=%x, A=%02x", cycles, 
+								instance.state(), instance.accumulator());
+						}
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_opcode(void)
+				{
+					uint16_t opcode;
+					uint32_t command, mode;
+					std::set<uint32_t> covered;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					for(opcode = 0; opcode <= OPCODE_MAX; ++opcode) {
+						covered.insert(cc65c::emulator::OPCODE[opcode][cc65c::emulator::OPCODE_METADATA_COMMAND]);
+					}
+
+					for(command = 0; command <= cc65c::assembler::KEYWORD_COMMAND_MAX; ++command) {
+
+						if(covered.find(command) == covered.end()) {
+							std::cerr << "Command not covered: " << cc65c::assembler::KEYWORD_COMMAND_STR[command] << std::endl;
+							result = STATUS_FAILURE;
+						}
+
+						for(mode = 0; mode <= cc65c::assembler::ADDRESS_MODE_MAX; ++mode) {
+
+							opcode = cc65c::assembler::ADDRESS_MODE_OPCODE[command][mode];
+							if(opcode == OPCODE_NONE) {
+								continue;
+							}
+
+							if((cc65c::emulator::OPCODE[opcode][cc65c::emulator::OPCODE_METADATA_COMMAND] != command) 
+									|| ((cc65c::emulator::OPCODE[opcode][cc65c::emulator::OPCODE_METADATA_MODE] != mode)
+									&& (command != cc65c::assembler::KEYWORD_COMMAND_BRK))) {
+								std::cerr << "Opcode mismatch: " << SCALAR_AS_HEX(uint8_t, opcode) << std::endl;
+								result = STATUS_FAILURE;
+							}
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_profile(
+					__in bool cached
+					)
+				{
+					uint64_t cycles;
+					std::vector<cc65c::emulator::profiler_label_t> label;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<cc65c::emulator::profiler_line_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::emulator::profiler report;
+						cc65c::emulator::processor instance;
+
+						cc65c::assembler::generator gen(EMULATOR_PROFILE_SOURCE, false);
+						gen.enumerate();
+						instance.set_block_cache(cached);
+						instance.set_profiling(true);
+						assemble(EMULATOR_PROFILE_SOURCE, instance);
+
+						cycles = instance.run(EMULATOR_TIMEOUT);
+						report.collect(gen, instance);
+						label.assign(report.label_begin(), report.label_end());
+
+						if((cycles != 33) || (report.cycles() != cycles) || (report.instructions() != 11)) {
+							THROW_EXCEPTION_FORMAT("Profile mismatch", "Cycles=%llu, Profile=%s", cycles, 
+								STRING_CHECK(report.to_string(true)));
+						}
+
+						if((label.size() != 3) 
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_NAME>(label.at(0)) != "loop")
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_CYCLE>(label.at(0)) != 23)
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_INSTRUCTION>(label.at(0)) != 8)
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_ROW>(label.at(0)) != 2)
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_NAME>(label.at(1)) != "sub")
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_CYCLE>(label.at(1)) != 8)
+								|| (std::get<cc65c::emulator::PROFILER_LABEL_NAME>(label.at(2)) 
+									!= PROFILER_LABEL_ANONYMOUS)) {
+							THROW_EXCEPTION_FORMAT("Hotspot mismatch", "Hotspot=\n%s", 
+								STRING_CHECK(report.hotspot()));
+						}
+
+						for(iter = report.line_begin(); iter != report.line_end(); ++iter) {
+
+							if((std::get<cc65c::emulator::PROFILER_LINE_ROW>(*iter) == 3) 
+									&& (std::get<cc65c::emulator::PROFILER_LINE_INSTRUCTION>(*iter) == 3)
+									&& (std::get<cc65c::emulator::PROFILER_LINE_CYCLE>(*iter) == 6)) {
+								break;
+							}
+						}
+
+						if(iter == report.line_end()) {
+							THROW_EXCEPTION_FORMAT("Listing mismatch", "Listing=\n%s", STRING_CHECK(report.listing()));
+						}
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_program(
+					__in const std::string &source,
+					__in uint8_t accumulator,
+					__in uint8_t index_x,
+					__in uint8_t index_y,
+					__in uint8_t status,
+					__in uint64_t cycle,
+					__in bool cached
+					)
+				{
+					uint64_t cycles;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::emulator::processor instance;
+
+						instance.set_block_cache(cached);
+						assemble(source, instance);
+
+						cycles = instance.run(EMULATOR_TIMEOUT);
+						if(instance.state() != cc65c::emulator::PROCESSOR_STATE_STOPPED) {
+							THROW_EXCEPTION_FORMAT("Program did not stop", "State=%s", 
+								STRING_CHECK(instance.to_string(true)));
+						}
+
+						if((instance.accumulator() != accumulator) || (instance.index_x() != index_x) 
+								|| (instance.index_y() != index_y) || (instance.status() != status)
+								|| (cycles != cycle)) {
+							THROW_EXCEPTION_FORMAT("Processor mismatch", "Expecting=A=%02x, X=%02x, Y=%02x, P=%02x, "
+								"Cycles=%llu, Found=%s", accumulator, index_x, index_y, status, cycle, 
+								STRING_CHECK(instance.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+						std::cerr << exc.to_string(true) << std::endl;
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(EMULATOR_SUITE_NAME);
+		cc65c::test::fixture_emulator test; 
+		suite.add(test);
+		result = suite.run(EMULATOR_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
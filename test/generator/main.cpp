@@ -0,0 +1,361 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tuple>
+#include "../../include/runtime.h"
+#include "../../include/assembler/generator.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define GENERATOR_FIXTURE_NAME "GENERATOR_FIXTURE"
+		#define GENERATOR_SUITE_NAME "GENERATOR_SUITE"
+
+		enum {
+			GENERATOR_TEST_TITLE = 0,
+			GENERATOR_TEST_FILE,
+			GENERATOR_TEST_OUTPUT,
+		};
+
+		enum {
+			GENERATOR_PASS_TEST_TITLE = 0,
+			GENERATOR_PASS_TEST_FILE,
+			GENERATOR_PASS_TEST_COUNT,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, size_t>> GENERATOR_PASS_TEST_SET = {
+			std::make_tuple("TEST_SHORTEN", "./test/generator/test/test_shorten.asm", 2),
+			std::make_tuple("TEST_SHORTEN_CHAIN", "./test/generator/test/test_shorten_chain.asm", 1),
+			std::make_tuple("TEST_SHORTEN_DEFINE", "./test/generator/test/test_shorten_define.asm", 1),
+
+			// TODO: Add additional test cases
+
+			};
+
+		enum {
+			GENERATOR_REWRITE_PEEPHOLE = 0,
+			GENERATOR_REWRITE_RELAX,
+		};
+
+		enum {
+			GENERATOR_REWRITE_TEST_TITLE = 0,
+			GENERATOR_REWRITE_TEST_FILE,
+			GENERATOR_REWRITE_TEST_EXPECTED,
+			GENERATOR_REWRITE_TEST_TYPE,
+			GENERATOR_REWRITE_TEST_COUNT,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, std::string, uint32_t, size_t>> 
+				GENERATOR_REWRITE_TEST_SET = {
+			std::make_tuple("TEST_PEEPHOLE", "./test/generator/test/test_peephole.asm", 
+				"./test/generator/test/test_peephole_expected.asm", GENERATOR_REWRITE_PEEPHOLE, 4),
+			std::make_tuple("TEST_RELAX", "./test/generator/test/test_relax.asm", 
+				"./test/generator/test/test_relax_expected.asm", GENERATOR_REWRITE_RELAX, 4),
+
+			// TODO: Add additional test cases
+
+			};
+
+		static const std::vector<std::tuple<std::string, std::string, std::vector<uint8_t>>> GENERATOR_TEST_SET = {
+			std::make_tuple("TEST_CONDITION", "./test/generator/test/test_condition.asm", std::vector<uint8_t>({
+				0xa9, 0x02, 0xea, 0xa0, 0x03, 0xa2, 0x04, 0x60,
+				})),
+			std::make_tuple("TEST_EMPTY", "./test/generator/test/test_empty.asm", std::vector<uint8_t>()),
+			std::make_tuple("TEST_EXPRESSION", "./test/generator/test/test_expression.asm", std::vector<uint8_t>({
+				0x0a, 0x04, 0x15, 0x02, 0x01, 0x08, 0x0e, 0x06, 0x00, 0x01, 0xf0, 0x01, 0x00, 0x34, 0x12, 0x34, 
+				0x34, 0x12, 0x62, 0x61, 0x63, 0x10, 0x01, 0x01, 0x03, 0x04, 0x06, 0x07,
+				})),
+			std::make_tuple("TEST_FIXUP", "./test/generator/test/test_fixup.asm", std::vector<uint8_t>({
+				0x20, 0x11, 0x02, 0xb5, 0x10, 0xa9, 0x02, 0x0f, 0x10, 0xf6, 0xf0, 0x05, 0xb1, 0x10, 0x7c, 0x00, 
+				0x02, 0x00, 0x00, 0x11, 0x61, 0x62, 0x16, 0x11, 0x02,
+				})),
+			std::make_tuple("TEST_INCLUDE", "./test/generator/test/test_include.asm", std::vector<uint8_t>({
+				0x43, 0x44, 0x45, 0x49, 0x4a, 0xa9, 0x01, 0x85, 0x10, 0xea, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25,
+				0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+				0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45,
+				0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55,
+				0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65,
+				0x0b, 0x30, 0x55, 0x7a, 0x9f, 0xc4, 0xe9, 0x0e, 0x33, 0x58, 0x7d, 0xa2, 0xc7, 0xec, 0x11, 0x36,
+				0x5b, 0x80, 0xa5, 0xca, 0xef, 0x14, 0x39, 0x5e, 0x83, 0xa8, 0xcd, 0xf2, 0x17, 0x3c, 0x61, 0x86,
+				0xab, 0xd0, 0xf5, 0x1a, 0x3f, 0x64, 0x89, 0xae,
+				})),
+			std::make_tuple("TEST_INCLUDE_SOURCE", "./test/generator/test/test_include_source.asm", std::vector<uint8_t>({
+				0xa9, 0x01, 0x61, 0x62, 0x02, 0xa9, 0x01, 0x61, 0x62, 0x02,
+				})),
+			std::make_tuple("TEST_MACRO", "./test/generator/test/test_macro.asm", std::vector<uint8_t>({
+				0xa9, 0x01, 0x85, 0x10, 0xa9, 0x01, 0x85, 0x10, 0xa9, 0x05, 0x85, 0x11, 0x18, 0xa5, 0x20, 0x69, 
+				0x34, 0x85, 0x20, 0xa5, 0x21, 0x69, 0x12, 0x85, 0x21, 0xea, 0xea, 0xa9, 0x04, 0x85, 0x12, 0xea, 
+				0xea, 0x60,
+				})),
+			std::make_tuple("TEST_MACRO_INCLUDE", "./test/generator/test/test_macro_include.asm", std::vector<uint8_t>({
+				0xea, 0xea, 0xa9, 0x01, 0x85, 0x10, 0xa9, 0x01, 0x85, 0x10, 0x60,
+				})),
+			std::make_tuple("TEST_SHORTEN", "./test/generator/test/test_shorten.asm", std::vector<uint8_t>({
+				0xa5, 0x10, 0x95, 0x20, 0xb6, 0x20, 0xee, 0x0c, 0x02, 0xad, 0xff, 0x00, 0x60,
+				})),
+			std::make_tuple("TEST_SHORTEN_CHAIN", "./test/generator/test/test_shorten_chain.asm", std::vector<uint8_t>({
+				0xa5, 0x10, 0xa5, 0xfc, 0xa5, 0xfd, 0xa5, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+				0x00, 0x00, 0x00, 0x00, 0xea, 0xea, 0x60,
+				})),
+			std::make_tuple("TEST_SHORTEN_DEFINE", "./test/generator/test/test_shorten_define.asm", std::vector<uint8_t>({
+				0xa5, 0x10, 0xad, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+				0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+				})),
+
+			// TODO: Add additional test cases
+
+			};
+
+		class fixture_generator :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_generator(void) :
+					cc65c::test::fixture(GENERATOR_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<std::tuple<std::string, std::string, std::vector<uint8_t>>>::const_iterator iter;
+					std::vector<std::tuple<std::string, std::string, size_t>>::const_iterator pass_iter;
+					std::vector<std::tuple<std::string, std::string, std::string, uint32_t, size_t>>::const_iterator 
+						rewrite_iter;
+
+					TRACE_ENTRY();
+
+					for(iter = GENERATOR_TEST_SET.begin(); iter != GENERATOR_TEST_SET.end(); ++iter) {
+
+						result = test_input(std::get<GENERATOR_TEST_FILE>(*iter), std::get<GENERATOR_TEST_OUTPUT>(*iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", STRING_CHECK(std::get<GENERATOR_TEST_TITLE>(*iter)));
+							break;
+						}
+					}
+
+					for(rewrite_iter = GENERATOR_REWRITE_TEST_SET.begin(); (result == STATUS_SUCCESS) 
+							&& (rewrite_iter != GENERATOR_REWRITE_TEST_SET.end()); ++rewrite_iter) {
+
+						result = test_rewrite(std::get<GENERATOR_REWRITE_TEST_FILE>(*rewrite_iter), 
+							std::get<GENERATOR_REWRITE_TEST_EXPECTED>(*rewrite_iter), 
+							std::get<GENERATOR_REWRITE_TEST_TYPE>(*rewrite_iter), 
+							std::get<GENERATOR_REWRITE_TEST_COUNT>(*rewrite_iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", 
+								STRING_CHECK(std::get<GENERATOR_REWRITE_TEST_TITLE>(*rewrite_iter)));
+						}
+					}
+
+					for(pass_iter = GENERATOR_PASS_TEST_SET.begin(); (result == STATUS_SUCCESS) 
+							&& (pass_iter != GENERATOR_PASS_TEST_SET.end()); ++pass_iter) {
+
+						result = test_pass(std::get<GENERATOR_PASS_TEST_FILE>(*pass_iter), 
+							std::get<GENERATOR_PASS_TEST_COUNT>(*pass_iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", 
+								STRING_CHECK(std::get<GENERATOR_PASS_TEST_TITLE>(*pass_iter)));
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static std::vector<uint8_t> 
+				bytes(
+					__inout cc65c::assembler::generator &gen
+					)
+				{
+					std::vector<uint8_t> result;
+					std::vector<cc65c::assembler::block_t>::const_iterator block_iter;
+					std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = gen.segment_begin(); iter != gen.segment_end(); ++iter) {
+
+						for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+							result.insert(result.end(), block_iter->second.begin(), block_iter->second.end());
+						}
+					}
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_input(
+					__in const std::string &input,
+					__in const std::vector<uint8_t> &output
+					)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::generator gen(input, true);
+						gen.enumerate();
+
+						if(bytes(gen) != output) {
+							THROW_EXCEPTION_FORMAT("Output mismatch", "Expecting=%u, Found=%u, %s", output.size(), 
+								bytes(gen).size(), STRING_CHECK(gen.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_pass(
+					__in const std::string &input,
+					__in size_t count
+					)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::generator gen(input, true);
+						gen.enumerate();
+
+						if(gen.passes() != count) {
+							THROW_EXCEPTION_FORMAT("Pass mismatch", "Expecting=%u, Found=%u, %s", count, gen.passes(), 
+								STRING_CHECK(gen.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_rewrite(
+					__in const std::string &input,
+					__in const std::string &expected,
+					__in uint32_t type,
+					__in size_t count
+					)
+				{
+					bool rewritten = true;
+					size_t found = 0;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::map<uint32_t, cc65c::assembler::peephole_report_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::generator gen(input, true), gen_expected(expected, true);
+						gen_expected.enumerate();
+
+						try {
+							cc65c::assembler::generator gen_default(input, true);
+							gen_default.enumerate();
+							rewritten = (bytes(gen_default) == bytes(gen_expected));
+						} catch(cc65c::core::exception &exc) {
+							rewritten = false;
+						}
+
+						if(rewritten) {
+							THROW_EXCEPTION("Rewrite applied without opt-in");
+						}
+
+						if(type == GENERATOR_REWRITE_PEEPHOLE) {
+							gen.set_peephole(true);
+							gen.enumerate();
+
+							for(iter = gen.peephole_begin(); iter != gen.peephole_end(); ++iter) {
+								found += std::get<cc65c::assembler::PEEPHOLE_REPORT_COUNT>(iter->second);
+							}
+						} else {
+							gen.set_relax(true);
+							gen.enumerate();
+							found = gen.relaxed();
+						}
+
+						if((bytes(gen) != bytes(gen_expected)) || (found != count)) {
+							THROW_EXCEPTION_FORMAT("Output mismatch", "Expecting=%u[%u], Found=%u[%u], %s", 
+								bytes(gen_expected).size(), count, bytes(gen).size(), found, 
+								STRING_CHECK(gen.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(GENERATOR_SUITE_NAME);
+		cc65c::test::fixture_generator test; 
+		suite.add(test);
+		result = suite.run(GENERATOR_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
@@ -0,0 +1,40 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+def MODE 2
+
+if MODE == 1
+	lda #1
+	if 1
+		@@@ ( ] 'x' "endif" ; endif
+	endif
+elif MODE == 2
+	lda #2
+	ifdef PLATFORM
+		@@@
+	else
+		nop
+	endif
+else
+	%%% inactive
+endif
+
+undef MODE
+
+ifdef MODE
+	@@@
+elifdef start		; forward label is not yet defined
+	@@@
+else
+	ldy #3
+endif
+
+start:
+if $ == 0x0205		; position dependent, resolved by the generator
+	ldx #4
+	ifdef start
+		rts
+	endif
+endif
@@ -0,0 +1,2 @@
+; CC65C Generator Test file
+; 2016 David Jolly
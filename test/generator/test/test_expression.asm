@@ -0,0 +1,37 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+	db 7 + 3, 7 - 3, 7 * 3, 7 / 3, 7 % 3			; arithmetic
+	db 0x0c & 0x0a, 0x0c | 0x0a, 0x0c ^ 0x0a		; binary
+	db 1 && 0, 1 || 0					; logical
+	db low(~0x0f), !0, !5					; unary
+	db byte(0x1234), high(0x1234), low(0x1234)		; macros
+	dw word(0x12, 0x34)
+	db "abc"[1], "abc"[2 - 2], "abc"[divisor - 2]		; literal index
+	db 0x40 / divisor, 0x41 % divisor			; forward divisor
+
+if 3 == 3
+	db 0x01
+endif
+if 3 != 3
+	db 0x02
+endif
+if 2 < 3
+	db 0x03
+endif
+if 3 <= 3
+	db 0x04
+endif
+if 2 > 3
+	db 0x05
+endif
+if 3 >= 2
+	db 0x06
+endif
+if $ == 0x021b
+	db 0x07
+endif
+
+	def divisor 4
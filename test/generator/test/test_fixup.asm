@@ -0,0 +1,20 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+def zp 0x10
+
+org 0x0200
+
+start:
+	jsr forward		; forward absolute fixup
+	lda zp, x		; zero page index x
+	lda #high(forward)	; immediate macro
+	bbr0 zp, start		; zero page relative
+	beq forward		; forward relative fixup
+	lda [zp], y		; zero page indirect index
+	jmp [start, x]		; absolute index indirect
+forward:
+	brk
+	brk low(forward)	; signature byte
+	db "ab", $ - $$
+	dw forward
@@ -0,0 +1,10 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+def skip 2
+
+org 0x0300
+
+	incb "./test/generator/test/test_include.bin", skip, 3	; sliced binary include
+	incb "./test/generator/test/test_include.bin", 8		; binary include tail
+	inch "./test/generator/test/test_include.hex"		; hexidecimal include
@@ -0,0 +1,7 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0400
+
+	incs "./test/generator/test/test_include_source.inc"	; parsed source include
+	incs "./test/generator/test/test_include_source.inc"	; cached source include
@@ -0,0 +1,36 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+macro store(value, addr)
+	lda #value
+	sta addr
+endm
+
+macro add16(addr, amount)
+	clc
+	lda addr
+	adc #low(amount)
+	sta addr
+	lda addr + 1
+	adc #high(amount)
+	sta addr + 1
+endm
+
+macro pause
+	nop
+	nop
+endm
+
+start:
+	store(1, 0x10)
+	store(1, 0x10)		; memoized expansion
+	store(2 + 3, 0x11)	; compound argument
+	add16(0x20, 0x1234)
+	if 1 == 1
+		pause
+		store(4, 0x12)
+	endif
+	pause()
+	rts
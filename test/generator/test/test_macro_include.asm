@@ -0,0 +1,12 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+	incs "./test/generator/test/test_macro_include.inc"	; included macro
+	incs "./test/generator/test/test_macro_include.inc"	; repeated include
+
+start:
+	store(1, 0x10)
+	store(1, 0x10)		; memoized expansion
+	rts
@@ -0,0 +1,29 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+def value 0x10
+
+org 0x0200
+
+start:
+	clc
+	adc #1			; inc a, carry and overflow rewritten below
+	sta value
+	lda value		; dropped, flags rewritten by ldx
+	ldx #0
+	clc
+	adc #1			; kept, carry read by rol
+	rol a
+	sec
+	sbc #1			; dec a
+	clc
+	clv
+	jsr sub			; jmp sub
+	rts
+sub:
+	sta value
+	lda value		; kept, flags read by beq
+	beq start
+	jsr start		; kept, rts is labeled
+done:
+	rts
@@ -0,0 +1,25 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+def value 0x10
+
+org 0x0200
+
+start:
+	inc a
+	sta value
+	ldx #0
+	clc
+	adc #1
+	rol a
+	dec a
+	clc
+	clv
+	jmp sub
+sub:
+	sta value
+	lda value
+	beq start
+	jsr start
+done:
+	rts
@@ -0,0 +1,17 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+back:
+	rts
+	res 0x7e, 0xea
+start:
+	beq far			; pushed out of range by the next relaxation
+	bne back		; backward out of range
+	res 0x7b, 0xea
+far:
+	bra back		; unconditional out of range
+	bbs7 0x10, far		; zero page relative in range
+	bbr1 0x10, back		; zero page relative out of range
+	rts
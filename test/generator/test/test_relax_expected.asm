@@ -0,0 +1,20 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+back:
+	rts
+	res 0x7e, 0xea
+start:
+	bne $ + 5
+	jmp far
+	beq $ + 5
+	jmp back
+	res 0x7b, 0xea
+far:
+	jmp back
+	bbs7 0x10, far
+	bbs1 0x10, $ + 6
+	jmp back
+	rts
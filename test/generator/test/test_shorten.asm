@@ -0,0 +1,15 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x0200
+
+start:
+	lda counter		; forward zero page
+	sta table, x		; forward zero page index x
+	ldx table, y		; forward zero page index y
+	inc forward		; forward absolute
+	lda 0x010b - (forward - start)	; shortening moves operand out of zero page
+forward:
+	rts
+	def counter 0x10
+	def table 0x20
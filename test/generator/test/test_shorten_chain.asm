@@ -0,0 +1,17 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x00e8
+
+	lda counter		; forward zero page
+	lda first		; zero page once counter is shortened
+	lda second		; zero page once first is shortened
+	lda third		; zero page once second is shortened
+	res 0x0c, 0x00
+first:
+	nop
+second:
+	nop
+third:
+	rts
+	def counter 0x10
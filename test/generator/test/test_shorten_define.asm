@@ -0,0 +1,12 @@
+; CC65C Generator test file
+; 2016 David Jolly
+
+org 0x00f0
+
+start:
+	lda counter		; forward zero page
+	lda wide		; forward absolute constant
+	res 0x10, 0
+	rts
+	def counter 0x10
+	def wide 0x0100
@@ -16,6 +16,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#define CC65C_TEST_ALLOCATION_HARNESS
+
 #include <tuple>
 #include "../../include/runtime.h"
 #include "../../include/assembler/lexer.h"
@@ -25,6 +27,9 @@ namespace cc65c {
 
 	namespace test {
 
+		#define LEXER_ALLOCATION_BUDGET 6.5
+		#define LEXER_ALLOCATION_FILE "./test/test.asm"
+
 		#define LEXER_FIXTURE_NAME "LEXER_FIXTURE"
 		#define LEXER_SUITE_NAME "LEXER_SUITE"
 
@@ -132,12 +137,73 @@ namespace cc65c {
 						}
 					}
 
+					if(result == STATUS_SUCCESS) {
+
+						result = test_allocation(LEXER_ALLOCATION_FILE, LEXER_ALLOCATION_BUDGET);
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", "TEST_ALLOCATION");
+						}
+					}
+
+					if(result == STATUS_SUCCESS) {
+
+						result = test_allocation_jobs();
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", "TEST_ALLOCATION_JOBS");
+						}
+					}
+
 					TRACE_EXIT_FORMAT("Result=%x", result);
 					return result;
 				}
 
 			protected:
 
+				cc65c::test::status_t 
+				test_allocation(
+					__in const std::string &input,
+					__in double budget
+					)
+				{
+					size_t tokens;
+					cc65c::test::status_t result;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::lexer lex(input, true);
+
+						allocation_begin();
+						tokens = lex.enumerate();
+						result = allocation_end(tokens, budget, cc65c::core::COUNTER_PHASE_LEX);
+					} catch(cc65c::core::exception &exc) {
+						cc65c::test::allocation::stop();
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_allocation_jobs(void)
+				{
+					std::map<std::string, cc65c::test::status_t> output;
+					cc65c::test::status_t result = STATUS_FAILURE;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::test::suite entry(LEXER_SUITE_NAME);
+						entry.run(output, SUITE_JOBS_DEFAULT + 1);
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_SUCCESS;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
 				static cc65c::test::status_t 
 				test_input(
 					__in const std::string &input,
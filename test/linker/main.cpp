@@ -0,0 +1,179 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tuple>
+#include "../../include/runtime.h"
+#include "../../include/assembler/generator.h"
+#include "../../include/assembler/linker.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define LINKER_FIXTURE_NAME "LINKER_FIXTURE"
+		#define LINKER_OBJECT_PATH "./build/linker_test_"
+		#define LINKER_SUITE_NAME "LINKER_SUITE"
+
+		enum {
+			LINKER_TEST_TITLE = 0,
+			LINKER_TEST_FILE,
+			LINKER_TEST_OUTPUT,
+			LINKER_TEST_SUCCESS,
+		};
+
+		static const std::vector<std::tuple<std::string, std::vector<std::string>, std::vector<uint8_t>, bool>> LINKER_TEST_SET = {
+			std::make_tuple("TEST_LINK", std::vector<std::string>({ "./test/linker/test/test_module_0.asm", 
+				"./test/linker/test/test_module_1.asm" }), std::vector<uint8_t>({ 0x20, 0x00, 0x03, 0xa9, 0x42, 0xd0, 
+				0xf9, 0x4c, 0x03, 0x03, 0x60, 0xea, 0xea, 0x60, }), true),
+			std::make_tuple("TEST_UNDEFINED", std::vector<std::string>({ "./test/linker/test/test_module_0.asm" }), 
+				std::vector<uint8_t>(), false),
+
+			// TODO: Add additional test cases
+
+			};
+
+		class fixture_linker :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_linker(void) :
+					cc65c::test::fixture(LINKER_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<std::tuple<std::string, std::vector<std::string>, std::vector<uint8_t>, bool>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = LINKER_TEST_SET.begin(); iter != LINKER_TEST_SET.end(); ++iter) {
+
+						result = test_input(std::get<LINKER_TEST_FILE>(*iter), std::get<LINKER_TEST_OUTPUT>(*iter), 
+							std::get<LINKER_TEST_SUCCESS>(*iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", STRING_CHECK(std::get<LINKER_TEST_TITLE>(*iter)));
+							break;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static cc65c::test::status_t 
+				test_input(
+					__in const std::vector<std::string> &input,
+					__in const std::vector<uint8_t> &output,
+					__in bool success
+					)
+				{
+					size_t index;
+					std::string path;
+					std::vector<uint8_t> bytes;
+					cc65c::assembler::linker link;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<cc65c::assembler::block_t>::const_iterator block_iter;
+					std::map<std::string, std::vector<cc65c::assembler::block_t>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					try {
+
+						for(index = 0; index < input.size(); ++index) {
+							cc65c::assembler::generator gen(input.at(index), true);
+							path = LINKER_OBJECT_PATH + std::to_string(index) + ".o";
+							gen.enumerate_object().write(path);
+							link.add(path);
+						}
+
+						link.link();
+
+						for(iter = link.segment_begin(); iter != link.segment_end(); ++iter) {
+
+							for(block_iter = iter->second.begin(); block_iter != iter->second.end(); ++block_iter) {
+								bytes.insert(bytes.end(), block_iter->second.begin(), block_iter->second.end());
+							}
+						}
+
+						if(!success || (bytes != output)) {
+							THROW_EXCEPTION_FORMAT("Output mismatch", "Expecting=%u, Found=%u, %s", output.size(), 
+								bytes.size(), STRING_CHECK(link.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+
+						if(success) {
+							result = STATUS_FAILURE;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(LINKER_SUITE_NAME);
+		cc65c::test::fixture_linker test; 
+		suite.add(test);
+		result = suite.run(LINKER_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
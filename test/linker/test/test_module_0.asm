@@ -0,0 +1,10 @@
+; CC65C Linker Test file
+; 2016 David Jolly
+
+org 0x0200
+
+start:
+	jsr routine		; external absolute word
+	lda #value		; external absolute byte
+	bne start
+	jmp routine + 3		; external with addend
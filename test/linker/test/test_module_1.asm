@@ -0,0 +1,12 @@
+; CC65C Linker Test file
+; 2016 David Jolly
+
+def value 0x42
+
+org 0x0300
+
+routine:
+	rts
+	nop
+	nop
+	rts
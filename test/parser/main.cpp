@@ -28,6 +28,35 @@ namespace cc65c {
 		#define PARSER_FIXTURE_NAME "PARSER_FIXTURE"
 		#define PARSER_SUITE_NAME "PARSER_SUITE"
 
+		enum {
+			PARSER_EXPANSION_TEST_TITLE = 0,
+			PARSER_EXPANSION_TEST_FILE,
+			PARSER_EXPANSION_TEST_HIT,
+			PARSER_EXPANSION_TEST_MISS,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, size_t, size_t>> PARSER_EXPANSION_TEST_SET = {
+			std::make_tuple("TEST_MACRO", "./test/parser/test/test_macro.asm", 2, 3),
+			std::make_tuple("TEST_MACRO_EXPANSION", "./test/parser/test/test_macro_expansion.asm", 3, 4),
+
+			// TODO: Add additional test cases
+
+			};
+
+		enum {
+			PARSER_SKIP_TEST_TITLE = 0,
+			PARSER_SKIP_TEST_FILE,
+			PARSER_SKIP_TEST_EXPECTED,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, std::string>> PARSER_SKIP_TEST_SET = {
+			std::make_tuple("TEST_CONDITION_SKIP", "./test/parser/test/test_condition_skip.asm", 
+				"./test/parser/test/test_condition_skip_expected.asm"),
+
+			// TODO: Add additional test cases
+
+			};
+
 		enum {
 			PARSER_TEST_TITLE = 0,
 			PARSER_TEST_FILE,
@@ -35,6 +64,7 @@ namespace cc65c {
 
 		static const std::vector<std::tuple<std::string, std::pair<std::string, bool>>> PARSER_TEST_SET = {
 			std::make_tuple("TEST_EMPTY", std::make_pair("./test/parser/test/test_empty.asm", true)),
+			std::make_tuple("TEST_MACRO", std::make_pair("./test/parser/test/test_macro.asm", true)),
 
 			// TODO: Add additional test cases
 
@@ -77,6 +107,8 @@ namespace cc65c {
 				{
 					cc65c::test::status_t result = STATUS_SUCCESS;
 					std::vector<std::tuple<std::string, std::pair<std::string, bool>>>::const_iterator iter;
+					std::vector<std::tuple<std::string, std::string, size_t, size_t>>::const_iterator expansion_iter;
+					std::vector<std::tuple<std::string, std::string, std::string>>::const_iterator skip_iter;
 
 					TRACE_ENTRY();
 
@@ -88,12 +120,63 @@ namespace cc65c {
 						}
 					}
 
+					for(expansion_iter = PARSER_EXPANSION_TEST_SET.begin(); (result == STATUS_SUCCESS) 
+							&& (expansion_iter != PARSER_EXPANSION_TEST_SET.end()); ++expansion_iter) {
+
+						result = test_expansion(std::get<PARSER_EXPANSION_TEST_FILE>(*expansion_iter), 
+							std::get<PARSER_EXPANSION_TEST_HIT>(*expansion_iter), 
+							std::get<PARSER_EXPANSION_TEST_MISS>(*expansion_iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", 
+								STRING_CHECK(std::get<PARSER_EXPANSION_TEST_TITLE>(*expansion_iter)));
+						}
+					}
+
+					for(skip_iter = PARSER_SKIP_TEST_SET.begin(); (result == STATUS_SUCCESS) 
+							&& (skip_iter != PARSER_SKIP_TEST_SET.end()); ++skip_iter) {
+
+						result = test_skip(std::get<PARSER_SKIP_TEST_FILE>(*skip_iter), 
+							std::get<PARSER_SKIP_TEST_EXPECTED>(*skip_iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", 
+								STRING_CHECK(std::get<PARSER_SKIP_TEST_TITLE>(*skip_iter)));
+						}
+					}
+
 					TRACE_EXIT_FORMAT("Result=%x", result);
 					return result;
 				}
 
 			protected:
 
+				static cc65c::test::status_t 
+				test_expansion(
+					__in const std::string &input,
+					__in size_t hit,
+					__in size_t miss
+					)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::parser par(input, true);
+						par.enumerate();
+
+						if((par.macro_expansion_hit() != hit) || (par.macro_expansion_miss() != miss)) {
+							THROW_EXCEPTION_FORMAT("Expansion mismatch", "Expecting=%u/%u, Found=%u/%u, %s", hit, miss, 
+								par.macro_expansion_hit(), par.macro_expansion_miss(), 
+								STRING_CHECK(par.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
 				static cc65c::test::status_t 
 				test_input(
 					__in const std::string &input,
@@ -150,6 +233,46 @@ namespace cc65c {
 					TRACE_EXIT_FORMAT("Result=%x", result);
 					return result;
 				}
+
+				static cc65c::test::status_t 
+				test_skip(
+					__in const std::string &input,
+					__in const std::string &expected
+					)
+				{
+					size_t token, token_expected, tree, tree_expected;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::symbol &instance = cc65c::assembler::symbol::acquire();
+
+						token = instance.token_count();
+						cc65c::assembler::parser par(input, true);
+						par.set_condition(std::map<std::string, int32_t>());
+						par.enumerate();
+						token = (instance.token_count() - token);
+						tree = par.size();
+
+						token_expected = instance.token_count();
+						cc65c::assembler::parser par_expected(expected, true);
+						par_expected.set_condition(std::map<std::string, int32_t>());
+						par_expected.enumerate();
+						token_expected = (instance.token_count() - token_expected);
+						tree_expected = par_expected.size();
+
+						if((token != token_expected) || (tree != tree_expected)) {
+							THROW_EXCEPTION_FORMAT("Skip mismatch", "Expecting=%u/%u, Found=%u/%u, %s", token_expected, 
+								tree_expected, token, tree, STRING_CHECK(par.to_string(true)));
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
 		};
 	}
 }
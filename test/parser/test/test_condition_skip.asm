@@ -0,0 +1,178 @@
+; CC65C Parser Test file
+; 2016 David Jolly
+
+	def FLAG 1
+
+ifdef FLAG
+	lda #1
+else
+	lda #0
+	sta 0x10, x
+	lda #1
+	sta 0x11, x
+	lda #2
+	sta 0x12, x
+	lda #3
+	sta 0x13, x
+	lda #4
+	sta 0x14, x
+	lda #5
+	sta 0x15, x
+	lda #6
+	sta 0x16, x
+	lda #7
+	sta 0x17, x
+	lda #8
+	sta 0x18, x
+	lda #9
+	sta 0x19, x
+	lda #10
+	sta 0x1a, x
+	lda #11
+	sta 0x1b, x
+	lda #12
+	sta 0x1c, x
+	lda #13
+	sta 0x1d, x
+	lda #14
+	sta 0x1e, x
+	lda #15
+	sta 0x1f, x
+	lda #16
+	sta 0x20, x
+	lda #17
+	sta 0x21, x
+	lda #18
+	sta 0x22, x
+	lda #19
+	sta 0x23, x
+	lda #20
+	sta 0x24, x
+	lda #21
+	sta 0x25, x
+	lda #22
+	sta 0x26, x
+	lda #23
+	sta 0x27, x
+	lda #24
+	sta 0x28, x
+	lda #25
+	sta 0x29, x
+	lda #26
+	sta 0x2a, x
+	lda #27
+	sta 0x2b, x
+	lda #28
+	sta 0x2c, x
+	lda #29
+	sta 0x2d, x
+	lda #30
+	sta 0x2e, x
+	lda #31
+	sta 0x2f, x
+	lda #32
+	sta 0x30, x
+	lda #33
+	sta 0x31, x
+	lda #34
+	sta 0x32, x
+	lda #35
+	sta 0x33, x
+	lda #36
+	sta 0x34, x
+	lda #37
+	sta 0x35, x
+	lda #38
+	sta 0x36, x
+	lda #39
+	sta 0x37, x
+	lda #40
+	sta 0x38, x
+	lda #41
+	sta 0x39, x
+	lda #42
+	sta 0x3a, x
+	lda #43
+	sta 0x3b, x
+	lda #44
+	sta 0x3c, x
+	lda #45
+	sta 0x3d, x
+	lda #46
+	sta 0x3e, x
+	lda #47
+	sta 0x3f, x
+	lda #48
+	sta 0x40, x
+	lda #49
+	sta 0x41, x
+	lda #50
+	sta 0x42, x
+	lda #51
+	sta 0x43, x
+	lda #52
+	sta 0x44, x
+	lda #53
+	sta 0x45, x
+	lda #54
+	sta 0x46, x
+	lda #55
+	sta 0x47, x
+	lda #56
+	sta 0x48, x
+	lda #57
+	sta 0x49, x
+	lda #58
+	sta 0x4a, x
+	lda #59
+	sta 0x4b, x
+	lda #60
+	sta 0x4c, x
+	lda #61
+	sta 0x4d, x
+	lda #62
+	sta 0x4e, x
+	lda #63
+	sta 0x4f, x
+	@@@ ( ] "endif"	; endif
+	if FLAG
+		nop
+	endif
+endif
+
+	ifdef UNDEFINED
+		jmp (0x0200, x)
+		jmp (0x0202, x)
+		jmp (0x0204, x)
+		jmp (0x0206, x)
+		jmp (0x0208, x)
+		jmp (0x020a, x)
+		jmp (0x020c, x)
+		jmp (0x020e, x)
+		jmp (0x0210, x)
+		jmp (0x0212, x)
+		jmp (0x0214, x)
+		jmp (0x0216, x)
+		jmp (0x0218, x)
+		jmp (0x021a, x)
+		jmp (0x021c, x)
+		jmp (0x021e, x)
+		jmp (0x0220, x)
+		jmp (0x0222, x)
+		jmp (0x0224, x)
+		jmp (0x0226, x)
+		jmp (0x0228, x)
+		jmp (0x022a, x)
+		jmp (0x022c, x)
+		jmp (0x022e, x)
+		jmp (0x0230, x)
+		jmp (0x0232, x)
+		jmp (0x0234, x)
+		jmp (0x0236, x)
+		jmp (0x0238, x)
+		jmp (0x023a, x)
+		jmp (0x023c, x)
+		jmp (0x023e, x)
+	else
+		rts
+	endif
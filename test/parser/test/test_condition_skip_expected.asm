@@ -0,0 +1,14 @@
+; CC65C Parser Test file
+; 2016 David Jolly
+
+	def FLAG 1
+
+ifdef FLAG
+	lda #1
+else
+endif
+
+	ifdef UNDEFINED
+	else
+		rts
+	endif
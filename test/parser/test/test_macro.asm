@@ -0,0 +1,20 @@
+; CC65C Parser Test file
+; 2016 David Jolly
+
+macro store(value, addr)
+	lda #value
+	sta addr
+endm
+
+macro pause
+	nop
+endm
+
+	store(1, 0x10)
+	store(1, 0x10)
+	ifdef value
+		pause
+	else
+		store(value + 1, 0x11)
+	endif
+	pause()
@@ -0,0 +1,23 @@
+; CC65C Parser Test file
+; 2016 David Jolly
+
+macro store(value, addr)
+	lda #value
+	sta addr
+endm
+
+macro guard(value)
+	ifdef flag
+		nop
+	else
+		lda #value
+	endif
+endm
+
+	store(1, 0x10)		; miss
+	store(1, 0x10)		; hit
+	store(2, 0x10)		; miss
+	store(1, 0x10)		; hit
+	guard(3)		; miss, condition state changes
+	guard(3)		; miss, memoization bypassed
+	store(2, 0x10)		; hit
@@ -0,0 +1,328 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <list>
+#include <thread>
+#include <tuple>
+#include "../../include/runtime.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define SUITE_FIXTURE_NAME "SUITE_FIXTURE"
+		#define SUITE_STUB_DELAY 20
+		#define SUITE_STUB_DELAY_LONG 60
+		#define SUITE_STUB_EXCEPTION "Stub failure"
+		#define SUITE_SUITE_NAME "SUITE_SUITE"
+
+		enum {
+			SUITE_STUB_NAME = 0,
+			SUITE_STUB_DELAY_MS,
+			SUITE_STUB_DURATION_MAX,
+			SUITE_STUB_ERROR,
+		};
+
+		enum {
+			SUITE_TEST_TITLE = 0,
+			SUITE_TEST_STUB,
+			SUITE_TEST_JOBS,
+			SUITE_TEST_STATUS,
+			SUITE_TEST_ERROR,
+		};
+
+		typedef std::tuple<std::string, size_t, double, bool> suite_stub_t;
+
+		static const std::vector<std::tuple<std::string, std::vector<cc65c::test::suite_stub_t>, size_t, 
+				std::vector<cc65c::test::status_t>, std::string>> SUITE_TEST_SET = {
+			std::make_tuple("TEST_DURATION", std::vector<cc65c::test::suite_stub_t>({
+				std::make_tuple("STUB_0", SUITE_STUB_DELAY, 1.0, false),
+				std::make_tuple("STUB_1", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				}), 1, std::vector<cc65c::test::status_t>({ STATUS_FAILURE, STATUS_SUCCESS, }), ""),
+			std::make_tuple("TEST_JOBS", std::vector<cc65c::test::suite_stub_t>({
+				std::make_tuple("STUB_0", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				std::make_tuple("STUB_1", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				std::make_tuple("STUB_2", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				std::make_tuple("STUB_3", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				std::make_tuple("STUB_4", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				std::make_tuple("STUB_5", SUITE_STUB_DELAY, FIXTURE_DURATION_UNLIMITED, false),
+				}), 4, std::vector<cc65c::test::status_t>({ STATUS_SUCCESS, STATUS_SUCCESS, STATUS_SUCCESS, 
+				STATUS_SUCCESS, STATUS_SUCCESS, STATUS_SUCCESS, }), ""),
+			std::make_tuple("TEST_RETHROW", std::vector<cc65c::test::suite_stub_t>({
+				std::make_tuple("STUB_0", SUITE_STUB_DELAY_LONG, FIXTURE_DURATION_UNLIMITED, true),
+				std::make_tuple("STUB_1", 0, FIXTURE_DURATION_UNLIMITED, true),
+				}), 2, std::vector<cc65c::test::status_t>(), "STUB_0"),
+
+			// TODO: Add additional test cases
+
+			};
+
+		class fixture_stub :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_stub(
+					__in const cc65c::test::suite_stub_t &stub,
+					__inout std::atomic<size_t> &active,
+					__inout std::atomic<size_t> &peak
+					) :
+						cc65c::test::fixture(std::get<SUITE_STUB_NAME>(stub), std::get<SUITE_STUB_DURATION_MAX>(stub)),
+						m_active(active),
+						m_delay(std::get<SUITE_STUB_DELAY_MS>(stub)),
+						m_error(std::get<SUITE_STUB_ERROR>(stub)),
+						m_peak(peak)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					size_t active, peak;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					active = ++m_active;
+
+					peak = m_peak;
+					while((active > peak) && !m_peak.compare_exchange_weak(peak, active));
+
+					std::this_thread::sleep_for(std::chrono::milliseconds(m_delay));
+					--m_active;
+
+					if(m_error) {
+						THROW_EXCEPTION_FORMAT(SUITE_STUB_EXCEPTION, "Name=%s", STRING_CHECK(m_name));
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				std::atomic<size_t> &m_active;
+
+				size_t m_delay;
+
+				bool m_error;
+
+				std::atomic<size_t> &m_peak;
+		};
+
+		class fixture_suite :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_suite(void) :
+					cc65c::test::fixture(SUITE_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<std::tuple<std::string, std::vector<cc65c::test::suite_stub_t>, size_t, 
+						std::vector<cc65c::test::status_t>, std::string>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = SUITE_TEST_SET.begin(); iter != SUITE_TEST_SET.end(); ++iter) {
+
+						result = test_run(std::get<SUITE_TEST_STUB>(*iter), std::get<SUITE_TEST_JOBS>(*iter),
+							std::get<SUITE_TEST_STATUS>(*iter), std::get<SUITE_TEST_ERROR>(*iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", STRING_CHECK(std::get<SUITE_TEST_TITLE>(*iter)));
+							break;
+						}
+					}
+
+					if(result == STATUS_SUCCESS) {
+						result = test_jobs_invalid();
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static cc65c::test::status_t 
+				test_jobs_invalid(void)
+				{
+					std::map<std::string, cc65c::test::status_t> output;
+					cc65c::test::status_t result = STATUS_FAILURE;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::test::suite entry(SUITE_SUITE_NAME);
+						entry.run(output, 0);
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_SUCCESS;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_run(
+					__in const std::vector<cc65c::test::suite_stub_t> &stub,
+					__in size_t jobs,
+					__in const std::vector<cc65c::test::status_t> &status,
+					__in const std::string &error
+					)
+				{
+					size_t index;
+					std::list<fixture_stub> fixture;
+					std::atomic<size_t> active(0), peak(0);
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::map<std::string, cc65c::test::status_t> output;
+					std::map<std::string, cc65c::test::fixture_duration_t> duration;
+					std::vector<cc65c::test::suite_stub_t>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::test::suite entry(SUITE_SUITE_NAME);
+
+						for(iter = stub.begin(); iter != stub.end(); ++iter) {
+							fixture.emplace_back(*iter, active, peak);
+							entry.add(fixture.back());
+						}
+
+						try {
+							entry.run(output, jobs);
+						} catch(cc65c::core::exception &exc) {
+
+							if(error.empty() || (std::string(exc.what()).find("Name=" + error) == std::string::npos)) {
+								THROW_EXCEPTION_FORMAT("Exception mismatch", "Expecting=%s, Found=%s", 
+									STRING_CHECK(error), exc.what());
+							}
+
+							output.clear();
+						}
+
+						if(output.size() != status.size()) {
+							THROW_EXCEPTION_FORMAT("Status mismatch", "Expecting=%u, Found=%u, %s", status.size(),
+								output.size(), STRING_CHECK(entry.to_string(true)));
+						}
+
+						entry.duration(duration);
+
+						for(index = 0, iter = stub.begin(); index < status.size(); ++index, ++iter) {
+
+							if(output.at(std::get<SUITE_STUB_NAME>(*iter)) != status.at(index)) {
+								THROW_EXCEPTION_FORMAT("Status mismatch", "Expecting=%x, Found=%x, %s", status.at(index),
+									output.at(std::get<SUITE_STUB_NAME>(*iter)), STRING_CHECK(entry.to_string(true)));
+							}
+
+							if(std::get<FIXTURE_DURATION_TEST>(duration.at(std::get<SUITE_STUB_NAME>(*iter)))
+									< std::get<SUITE_STUB_DELAY_MS>(*iter)) {
+								THROW_EXCEPTION_FORMAT("Duration mismatch", "Expecting=%u ms, %s", 
+									std::get<SUITE_STUB_DELAY_MS>(*iter), STRING_CHECK(entry.to_string(true)));
+							}
+						}
+
+						if(!error.empty() && !output.empty()) {
+							THROW_EXCEPTION_FORMAT("Exception mismatch", "Expecting=%s, Found=none", STRING_CHECK(error));
+						}
+
+						if((jobs > SUITE_JOBS_DEFAULT) && error.empty() && (peak < 2)) {
+							THROW_EXCEPTION_FORMAT("Concurrency mismatch", "Jobs=%u, Peak=%u", jobs, (size_t) peak);
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(SUITE_SUITE_NAME);
+		cc65c::test::fixture_suite test;
+		suite.add(test);
+		result = suite.run(SUITE_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
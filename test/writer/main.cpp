@@ -0,0 +1,202 @@
+/**
+ * cc65c
+ * Copyright (C) 2016 David Jolly
+ *
+ * cc65c is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cc65c is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tuple>
+#include "../../include/runtime.h"
+#include "../../include/assembler/writer.h"
+#include "../../include/core/stream.h"
+#include "../../include/test/suite.h"
+
+namespace cc65c {
+
+	namespace test {
+
+		#define WRITER_FIXTURE_NAME "WRITER_FIXTURE"
+		#define WRITER_OUTPUT_BINARY "./build/writer_test.bin"
+		#define WRITER_OUTPUT_HEX "./build/writer_test.hex"
+		#define WRITER_OUTPUT_LISTING "./build/writer_test.lst"
+		#define WRITER_SUITE_NAME "WRITER_SUITE"
+
+		enum {
+			WRITER_TEST_TITLE = 0,
+			WRITER_TEST_PATH,
+			WRITER_TEST_BINARY,
+			WRITER_TEST_HEX,
+			WRITER_TEST_LISTING,
+		};
+
+		static const std::vector<std::tuple<std::string, std::string, std::vector<uint8_t>, std::string, std::string>> WRITER_TEST_SET = {
+			std::make_tuple("TEST_EMPTY", "./test/generator/test/test_empty.asm", std::vector<uint8_t>(), 
+				":00000001FF\n", ""),
+			std::make_tuple("TEST_OUTPUT", "./test/writer/test/test_output.asm", std::vector<uint8_t>({ 0xa9, 0x01, 
+				0x85, 0x10, 0xff, 0xff, 0xff, 0xff, 0x61, 0x62, 0x63, 0x64, }), 
+				":04020000A9018510BB\n:040208006162636468\n:00000001FF\n", 
+				"0200                4  org 0x0200\n"
+				"0200                6  start:\n"
+				"0200  A9 01         7   lda #0x01  ; immediate\n"
+				"0202  85 10         8   sta 0x10  ; zero page\n"
+				"0204               10  org 0x0208\n"
+				"0208  61 62 63     11   db \"ab\", 0x63, 0x64 ; continued listing row\n"
+				"020B  64\n"),
+
+			// TODO: Add additional test cases
+
+			};
+
+		class fixture_writer :
+				public cc65c::test::fixture {
+
+			public:
+
+				fixture_writer(void) :
+					cc65c::test::fixture(WRITER_FIXTURE_NAME)
+				{
+					TRACE_ENTRY();
+					TRACE_EXIT();
+				}
+
+				cc65c::test::status_t 
+				on_setup(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_teardown(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+				cc65c::test::status_t 
+				on_test(void)
+				{
+					cc65c::test::status_t result = STATUS_SUCCESS;
+					std::vector<std::tuple<std::string, std::string, std::vector<uint8_t>, std::string, std::string>>::const_iterator iter;
+
+					TRACE_ENTRY();
+
+					for(iter = WRITER_TEST_SET.begin(); iter != WRITER_TEST_SET.end(); ++iter) {
+
+						result = test_input(std::get<WRITER_TEST_PATH>(*iter), std::get<WRITER_TEST_BINARY>(*iter), 
+							std::get<WRITER_TEST_HEX>(*iter), std::get<WRITER_TEST_LISTING>(*iter));
+						if(result != STATUS_SUCCESS) {
+							TRACE_ERROR_FORMAT("Test failure", "Name=%s", STRING_CHECK(std::get<WRITER_TEST_TITLE>(*iter)));
+							break;
+						}
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+
+			protected:
+
+				static std::string 
+				read_output(
+					__in const std::string &path
+					)
+				{
+					std::string result;
+
+					TRACE_ENTRY();
+
+					cc65c::core::stream input(path, true);
+					if(input.size()) {
+						result = std::string((const char *) &input.at(0), input.size());
+					}
+
+					TRACE_EXIT();
+					return result;
+				}
+
+				static cc65c::test::status_t 
+				test_input(
+					__in const std::string &path,
+					__in const std::vector<uint8_t> &binary,
+					__in const std::string &hex,
+					__in const std::string &listing
+					)
+				{
+					std::string output;
+					cc65c::test::status_t result = STATUS_SUCCESS;
+
+					TRACE_ENTRY();
+
+					try {
+						cc65c::assembler::generator gen(path, true);
+						gen.enumerate();
+
+						cc65c::assembler::writer(WRITER_OUTPUT_BINARY).write_binary(gen.segment_begin(), gen.segment_end());
+						output = read_output(WRITER_OUTPUT_BINARY);
+						if(std::vector<uint8_t>(output.begin(), output.end()) != binary) {
+							THROW_EXCEPTION_FORMAT("Binary output mismatch", "Expecting=%u, Found=%u", binary.size(), 
+								output.size());
+						}
+
+						cc65c::assembler::writer(WRITER_OUTPUT_HEX).write_hex(gen.segment_begin(), gen.segment_end());
+						output = read_output(WRITER_OUTPUT_HEX);
+						if(output != hex) {
+							THROW_EXCEPTION_FORMAT("Hex output mismatch", "Expecting=%s, Found=%s", STRING_CHECK(hex), 
+								STRING_CHECK(output));
+						}
+
+						cc65c::assembler::writer(WRITER_OUTPUT_LISTING).write_listing(gen);
+						output = read_output(WRITER_OUTPUT_LISTING);
+						if(output != listing) {
+							THROW_EXCEPTION_FORMAT("Listing output mismatch", "Expecting=%s, Found=%s", 
+								STRING_CHECK(listing), STRING_CHECK(output));
+						}
+					} catch(cc65c::core::exception &exc) {
+						result = STATUS_FAILURE;
+					}
+
+					TRACE_EXIT_FORMAT("Result=%x", result);
+					return result;
+				}
+		};
+	}
+}
+
+int 
+main(void)
+{
+	cc65c::test::status_t result = cc65c::test::STATUS_INCONCLUSIVE;
+
+	try {
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		cc65c::test::suite suite(WRITER_SUITE_NAME);
+		cc65c::test::fixture_writer test; 
+		suite.add(test);
+		result = suite.run(WRITER_FIXTURE_NAME);
+		instance.uninitialize();
+	} catch(cc65c::core::exception &exc) {
+		TRACE_ERROR(STRING_CHECK(exc.to_string(true)));
+		std::cerr << exc.to_string(true) << std::endl;
+	}
+
+	return result;
+}
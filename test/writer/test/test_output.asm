@@ -0,0 +1,11 @@
+; CC65C Writer test file
+; 2016 David Jolly
+
+org 0x0200
+
+start:
+	lda #0x01		; immediate
+	sta 0x10		; zero page
+
+org 0x0208
+	db "ab", 0x63, 0x64	; continued listing row
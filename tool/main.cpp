@@ -16,43 +16,928 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <getopt.h>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
 #include "../include/runtime.h"
+#include "../include/assembler/writer.h"
+#include "../include/core/counter.h"
+#include "../include/core/socket.h"
 
-// TODO: DEBUGGING
-#include "../include/assembler/parser.h"
-// ---
+enum {
+	JOB_INPUT = 0,
+	JOB_OUTPUT,
+	JOB_STATUS,
+	JOB_STREAM,
+};
 
-int 
-main(void)
+typedef std::tuple<std::string, std::vector<std::string>, int, std::string> job_t;
+
+enum {
+	OUTPUT_BINARY = 0,
+	OUTPUT_HEX,
+	OUTPUT_LISTING,
+};
+
+#define OUTPUT_MAX OUTPUT_LISTING
+
+static const std::string OUTPUT_EXTENSION[] = {
+	".bin",
+	".hex",
+	".lst",
+	};
+
+static const std::string OUTPUT_FORMAT[] = {
+	"bin",
+	"hex",
+	"lst",
+	};
+
+#define RESPONSE_FILE_PREFIX '@'
+
+#define SERVER_ENVIRONMENT "CC65C_SERVER"
+#define SERVER_OPTION_CONNECT_LONG "--connect"
+#define SERVER_OPTION_CONNECT_SHORT "-C"
+#define SERVER_OPTION_LISTEN_LONG "--server"
+#define SERVER_OPTION_LISTEN_SHORT "-S"
+#define SERVER_TIMEOUT 5000
+
+enum {
+	STATS_COUNT = 0,
+	STATS_CPU,
+	STATS_INPUT,
+	STATS_PHASE,
+	STATS_RSS,
+	STATS_WALL,
+};
+
+typedef std::tuple<std::vector<size_t>, uint64_t, std::string, std::vector<cc65c::core::counter_metadata_t>, long, 
+	uint64_t> stats_t;
+
+enum {
+	STATS_COUNT_INTERN = 0,
+	STATS_COUNT_NODE,
+	STATS_COUNT_TOKEN,
+	STATS_COUNT_TREE,
+	STATS_COUNT_UUID,
+};
+
+#define STATS_COUNT_MAX STATS_COUNT_UUID
+
+static const std::string STATS_COUNT_STR[] = {
+	"interned",
+	"nodes",
+	"tokens",
+	"trees",
+	"uuids",
+	};
+
+typedef enum {
+	STATS_FORMAT_NONE = 0,
+	STATS_FORMAT_JSON,
+	STATS_FORMAT_TEXT,
+} stats_format_t;
+
+#define STATS_FORMAT_MAX STATS_FORMAT_TEXT
+
+static const std::string STATS_FORMAT_STR[] = {
+	"",
+	"json",
+	"text",
+	};
+
+#define STATS_NANOSECONDS_PER_MILLISECOND 1000000.0
+#define STATS_NANOSECONDS_PER_SECOND 1000000000ULL
+
+#define OPTION_STATS 0x100
+
+static const struct option OPTION_LONG[] = {
+	{ "binary", required_argument, nullptr, 'b' },
+	{ "cache", required_argument, nullptr, 'c' },
+	{ "define", required_argument, nullptr, 'D' },
+	{ "format", required_argument, nullptr, 'f' },
+	{ "help", no_argument, nullptr, 'h' },
+	{ "hex", required_argument, nullptr, 'x' },
+	{ "jobs", required_argument, nullptr, 'j' },
+	{ "listing", required_argument, nullptr, 'l' },
+	{ "peephole", no_argument, nullptr, 'p' },
+	{ "relax", no_argument, nullptr, 'r' },
+	{ "statistics", no_argument, nullptr, 's' },
+	{ "stats", optional_argument, nullptr, OPTION_STATS },
+	{ "version", no_argument, nullptr, 'v' },
+	{ nullptr, 0, nullptr, 0 },
+	};
+
+#define OPTION_SHORT "b:c:D:f:hj:l:prsvx:"
+
+static volatile sig_atomic_t server_stop = 0;
+
+static void 
+assemble(
+	__in const std::string &input,
+	__in const std::map<std::string, int32_t> &define,
+	__in const std::vector<std::string> &output,
+	__in bool relax,
+	__in bool peephole,
+	__inout std::vector<size_t> &count
+	)
 {
-	int result = 0;
+	std::map<std::string, int32_t>::const_iterator iter;
+
+	count.assign(STATS_COUNT_MAX + 1, 0);
+
+	cc65c::assembler::artifact &instance = cc65c::assembler::artifact::acquire();
+	if(instance.fetch(input, define, output, relax, peephole)) {
+		return;
+	}
+
+	cc65c::assembler::generator gen(input, true);
+	gen.set_peephole(peephole);
+	gen.set_relax(relax);
+
+	for(iter = define.begin(); iter != define.end(); ++iter) {
+		gen.define(iter->first, iter->second);
+	}
+
+	gen.enumerate();
+
+	if(!output.at(OUTPUT_BINARY).empty()) {
+		cc65c::assembler::writer(output.at(OUTPUT_BINARY)).write_binary(gen.segment_begin(), gen.segment_end());
+	}
+
+	if(!output.at(OUTPUT_HEX).empty()) {
+		cc65c::assembler::writer(output.at(OUTPUT_HEX)).write_hex(gen.segment_begin(), gen.segment_end());
+	}
+
+	if(!output.at(OUTPUT_LISTING).empty()) {
+		cc65c::assembler::writer(output.at(OUTPUT_LISTING)).write_listing(gen);
+	}
+
+	count.at(STATS_COUNT_INTERN) = gen.symbol_count();
+	count.at(STATS_COUNT_NODE) = cc65c::assembler::symbol::acquire().node_count();
+	count.at(STATS_COUNT_TOKEN) = cc65c::assembler::symbol::acquire().token_count();
+	count.at(STATS_COUNT_TREE) = gen.tree_count();
+	count.at(STATS_COUNT_UUID) = cc65c::core::uuid::acquire().size();
 
-	std::cout << CC65C << " " << cc65c::runtime::version(true) << std::endl;
+	instance.store(input, define, std::set<std::string>(gen.dependency_begin(), gen.dependency_end()), output, 
+		relax, peephole);
+}
+
+static int 
+assemble_input(
+	__in const std::string &input,
+	__in const std::map<std::string, int32_t> &define,
+	__in const std::vector<std::string> &output,
+	__in bool relax,
+	__in bool peephole,
+	__inout std::ostream &stream_error,
+	__inout std::vector<size_t> &count
+	)
+{
+	int result = EXIT_SUCCESS;
 
 	try {
-		cc65c::runtime &instance = cc65c::runtime::acquire();
-		instance.initialize();
+		assemble(input, define, output, relax, peephole, count);
+	} catch(cc65c::core::exception &exc) {
+		stream_error << exc.to_string(true) << std::endl;
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+static int 
+assemble_measure(
+	__in const std::string &input,
+	__in const std::map<std::string, int32_t> &define,
+	__in const std::vector<std::string> &output,
+	__in bool relax,
+	__in bool peephole,
+	__inout std::ostream &stream_error,
+	__inout stats_t &stats
+	)
+{
+	int result;
+	size_t phase;
+	std::clock_t cpu;
+	struct rusage usage;
+	std::chrono::steady_clock::time_point wall;
+
+	cc65c::core::counter &instance = cc65c::core::counter::acquire();
+	instance.reset();
+	std::get<STATS_INPUT>(stats) = input;
+	cpu = std::clock();
+	wall = std::chrono::steady_clock::now();
+	result = assemble_input(input, define, output, relax, peephole, stream_error, std::get<STATS_COUNT>(stats));
+	std::get<STATS_WALL>(stats) = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - wall).count();
+	std::get<STATS_CPU>(stats) = (((std::clock() - cpu) * STATS_NANOSECONDS_PER_SECOND) / CLOCKS_PER_SEC);
+
+	for(phase = 0; phase <= COUNTER_PHASE_MAX; ++phase) {
+		std::get<STATS_PHASE>(stats).push_back(instance.metadata((cc65c::core::counter_phase_t) phase));
+	}
+
+	if(!getrusage(RUSAGE_SELF, &usage)) {
+		std::get<STATS_RSS>(stats) = usage.ru_maxrss;
+	}
+
+	return result;
+}
+
+static void 
+assemble_worker(
+	__inout std::vector<job_t> &job,
+	__inout std::atomic<size_t> &next,
+	__in const std::map<std::string, int32_t> &define,
+	__in bool relax,
+	__in bool peephole
+	)
+{
+	size_t index;
+
+	while((index = next++) < job.size()) {
+		std::vector<size_t> tally;
+		std::stringstream stream_error;
+
+		job_t &entry = job.at(index);
+		std::get<JOB_STATUS>(entry) = assemble_input(std::get<JOB_INPUT>(entry), define, std::get<JOB_OUTPUT>(entry), 
+			relax, peephole, stream_error, tally);
+		std::get<JOB_STREAM>(entry) = stream_error.str();
+	}
+}
+
+static int 
+assemble_parallel(
+	__inout std::vector<job_t> &job,
+	__in const std::map<std::string, int32_t> &define,
+	__in bool relax,
+	__in bool peephole,
+	__in size_t jobs,
+	__inout std::ostream &stream_error
+	)
+{
+	size_t index;
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> worker;
+	int result = EXIT_SUCCESS;
+
+	for(index = 0; index < std::min(jobs, job.size()); ++index) {
+		worker.push_back(std::thread(assemble_worker, std::ref(job), std::ref(next), std::cref(define), relax, 
+			peephole));
+	}
+
+	for(index = 0; index < worker.size(); ++index) {
+		worker.at(index).join();
+	}
+
+	for(index = 0; index < job.size(); ++index) {
+		stream_error << std::get<JOB_STREAM>(job.at(index));
+
+		if(std::get<JOB_STATUS>(job.at(index)) != EXIT_SUCCESS) {
+			result = EXIT_FAILURE;
+		}
+	}
+
+	return result;
+}
+
+static bool 
+expand_response(
+	__in const std::vector<std::string> &argument,
+	__inout std::vector<std::string> &result,
+	__inout std::ostream &stream_error
+	)
+{
+	std::string entry;
+	std::ifstream file;
+	std::vector<std::string>::const_iterator iter;
+
+	for(iter = argument.begin(); iter != argument.end(); ++iter) {
+
+		if(iter->empty() || (iter->front() != RESPONSE_FILE_PREFIX)) {
+			result.push_back(*iter);
+			continue;
+		}
+
+		file = std::ifstream(iter->substr(1).c_str());
+		if(!file) {
+			stream_error << CC65C << ": Response file not found: " << iter->substr(1) << std::endl;
+			return false;
+		}
+
+		while(file >> entry) {
+			result.push_back(entry);
+		}
+
+		file.close();
+	}
+
+	return true;
+}
+
+static bool 
+extract_option(
+	__inout std::vector<std::string> &argument,
+	__in const std::string &option_short,
+	__in const std::string &option_long,
+	__inout std::string &value
+	)
+{
+	bool result = false;
+	std::vector<std::string>::iterator iter;
+
+	for(iter = argument.begin(); iter != argument.end();) {
+
+		if(*iter == "--") {
+			break;
+		} else if(((*iter == option_short) || (*iter == option_long)) && ((iter + 1) != argument.end())) {
+			value = *(iter + 1);
+			iter = argument.erase(iter, iter + 2);
+			result = true;
+		} else if(!iter->compare(0, option_long.size() + 1, option_long + "=")) {
+			value = iter->substr(option_long.size() + 1);
+			iter = argument.erase(iter);
+			result = true;
+		} else {
+			++iter;
+		}
+	}
+
+	return result;
+}
+
+static bool 
+forward(
+	__in const std::string &path,
+	__in const std::vector<std::string> &argument,
+	__inout int &result
+	)
+{
+	char *directory;
+	int32_t status = EXIT_FAILURE;
+	std::string request, response;
+	std::vector<std::string>::const_iterator iter;
+	cc65c::core::socket client;
+
+	try {
+		client.connect(path);
+	} catch(cc65c::core::exception &exc) {
+		return false;
+	}
+
+	directory = getcwd(nullptr, 0);
+	if(directory) {
+		request = directory;
+		std::free(directory);
+	}
+
+	for(iter = argument.begin(); iter != argument.end(); ++iter) {
+		request.append(1, '\0');
+		request.append(*iter);
+	}
+
+	client.send(request);
+
+	if(client.receive(response) && (response.size() == sizeof(status))) {
+		std::memcpy(&status, response.c_str(), sizeof(status));
+
+		if(client.receive(response)) {
+			std::cout << response;
+		}
+
+		if(client.receive(response)) {
+			std::cerr << response;
+		}
+	}
+
+	result = status;
+
+	return true;
+}
+
+static bool 
+parse_define(
+	__in const std::string &argument,
+	__inout std::map<std::string, int32_t> &define
+	)
+{
+	char *end = nullptr;
+	long value = 1;
+	std::string name = argument;
+	size_t position = argument.find('=');
+
+	if(position != std::string::npos) {
+		name = argument.substr(0, position);
+		value = std::strtol(argument.c_str() + position + 1, &end, 0);
+
+		if(!end || *end || ((position + 1) == argument.size()) || (value < INT32_MIN) || (value > INT32_MAX)) {
+			return false;
+		}
+	}
+
+	if(name.empty()) {
+		return false;
+	}
+
+	define[name] = value;
+
+	return true;
+}
+
+static bool 
+parse_format(
+	__in const std::string &argument,
+	__inout std::vector<bool> &format
+	)
+{
+	size_t index, position = 0, next;
+
+	do {
+		next = argument.find(',', position);
+		std::string entry = argument.substr(position, (next == std::string::npos) ? std::string::npos 
+			: (next - position));
+
+		for(index = 0; index <= OUTPUT_MAX; ++index) {
 
-		// TODO: DEBUGGING
-		cc65c::assembler::parser par("./test/test.asm");
-		//par.enumerate();
+			if(entry == OUTPUT_FORMAT[index]) {
+				format.at(index) = true;
+				break;
+			}
+		}
+
+		if(index > OUTPUT_MAX) {
+			return false;
+		}
+
+		position = (next + 1);
+	} while(next != std::string::npos);
+
+	return true;
+}
+
+static std::string 
+output_path(
+	__in const std::string &input,
+	__in const std::string &extension
+	)
+{
+	size_t position = input.find_last_of('.');
+
+	return (((position != std::string::npos) && (position > input.find_last_of('/') + 1)) 
+		? input.substr(0, position) : input) + extension;
+}
+
+static std::string 
+print_escape(
+	__in const std::string &input
+	)
+{
+	std::string result;
+	std::string::const_iterator iter;
+
+	for(iter = input.begin(); iter != input.end(); ++iter) {
+
+		if((*iter == '\"') || (*iter == '\\')) {
+			result += '\\';
+		}
+
+		result += *iter;
+	}
+
+	return result;
+}
+
+static void 
+print_stats(
+	__in const stats_t &stats,
+	__in bool available,
+	__inout std::ostream &stream
+	)
+{
+	size_t event, index;
+
+	stream << "Statistics: " << std::get<STATS_INPUT>(stats) << std::endl << std::fixed << std::setprecision(3) 
+		<< "  total: " << (std::get<STATS_WALL>(stats) / STATS_NANOSECONDS_PER_MILLISECOND) << " ms wall, " 
+		<< (std::get<STATS_CPU>(stats) / STATS_NANOSECONDS_PER_MILLISECOND) << " ms cpu, " 
+		<< std::get<STATS_RSS>(stats) << " KB peak rss" << std::endl << "  count:";
+
+	for(index = 0; index <= STATS_COUNT_MAX; ++index) {
+		stream << ((index > 0) ? ", " : " ") << std::get<STATS_COUNT>(stats).at(index) << " " 
+			<< STATS_COUNT_STR[index];
+	}
+
+	stream << std::endl;
+
+	for(index = 0; index < std::get<STATS_PHASE>(stats).size(); ++index) {
+		const cc65c::core::counter_metadata_t &entry = std::get<STATS_PHASE>(stats).at(index);
+
+		stream << "  " << COUNTER_PHASE_STRING(index) << ": " << std::get<cc65c::core::COUNTER_METADATA_ENTRY>(entry) 
+			<< " entries, " << (std::get<cc65c::core::COUNTER_METADATA_WALL>(entry) 
+				/ STATS_NANOSECONDS_PER_MILLISECOND) << " ms wall, " 
+			<< (std::get<cc65c::core::COUNTER_METADATA_CPU>(entry) / STATS_NANOSECONDS_PER_MILLISECOND) << " ms cpu";
+
+		for(event = 0; available && (event <= COUNTER_EVENT_MAX); ++event) {
+			stream << ", " << std::get<cc65c::core::COUNTER_METADATA_EVENT>(entry).at(event) << " " 
+				<< COUNTER_EVENT_STRING(event);
+		}
+
+		stream << std::endl;
+	}
+
+	if(!available) {
+		stream << "  counters: unavailable" << std::endl;
+	}
+}
+
+static void 
+print_stats_json(
+	__in const std::vector<stats_t> &stats,
+	__in bool available,
+	__inout std::ostream &stream
+	)
+{
+	size_t event, index;
+	std::vector<stats_t>::const_iterator iter;
+
+	stream << "{" << std::endl << "  \"counters\": " << (available ? "true" : "false") << "," << std::endl 
+		<< "  \"files\": [";
 
-		while(par.has_next()) {
-			std::cout << par.to_string(true) << std::endl;
-			par.move_next();
+	for(iter = stats.begin(); iter != stats.end(); ++iter) {
+		stream << ((iter != stats.begin()) ? "," : "") << std::endl << "    {\"input\": \"" 
+			<< print_escape(std::get<STATS_INPUT>(*iter)) << "\", " << std::fixed << std::setprecision(6) 
+			<< "\"wall_ms\": " << (std::get<STATS_WALL>(*iter) / STATS_NANOSECONDS_PER_MILLISECOND) 
+			<< ", \"cpu_ms\": " << (std::get<STATS_CPU>(*iter) / STATS_NANOSECONDS_PER_MILLISECOND) 
+			<< ", \"peak_rss_kb\": " << std::get<STATS_RSS>(*iter) << ", \"counts\": {";
+
+		for(index = 0; index <= STATS_COUNT_MAX; ++index) {
+			stream << ((index > 0) ? ", " : "") << "\"" << STATS_COUNT_STR[index] << "\": " 
+				<< std::get<STATS_COUNT>(*iter).at(index);
 		}
 
-		std::cout << par.to_string(true) << std::endl;
+		stream << "}, \"phases\": {";
+
+		for(index = 0; index < std::get<STATS_PHASE>(*iter).size(); ++index) {
+			const cc65c::core::counter_metadata_t &entry = std::get<STATS_PHASE>(*iter).at(index);
+
+			stream << ((index > 0) ? ", " : "") << "\"" << COUNTER_PHASE_STRING(index) << "\": {\"entries\": " 
+				<< std::get<cc65c::core::COUNTER_METADATA_ENTRY>(entry) << ", \"wall_ms\": " 
+				<< (std::get<cc65c::core::COUNTER_METADATA_WALL>(entry) / STATS_NANOSECONDS_PER_MILLISECOND) 
+				<< ", \"cpu_ms\": " 
+				<< (std::get<cc65c::core::COUNTER_METADATA_CPU>(entry) / STATS_NANOSECONDS_PER_MILLISECOND);
+
+			for(event = 0; available && (event <= COUNTER_EVENT_MAX); ++event) {
+				stream << ", \"" << COUNTER_EVENT_STRING(event) << "\": " 
+					<< std::get<cc65c::core::COUNTER_METADATA_EVENT>(entry).at(event);
+			}
+
+			stream << "}";
+		}
+
+		stream << "}}";
+	}
+
+	stream << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+static void 
+usage(
+	__inout std::ostream &stream
+	)
+{
+	stream << "Usage: " << CC65C << " [options] input... [@response]" << std::endl << std::endl
+		<< "  -b, --binary <path>     Write binary image (single input only)" << std::endl
+		<< "  -c, --cache <dir>       Reuse parse and build results stored in dir" << std::endl
+		<< "  -C, --connect <socket>  Forward this invocation to a server (default: $" << SERVER_ENVIRONMENT << ")" 
+			<< std::endl
+		<< "  -D, --define <name[=v]> Define symbol name with value v (default: 1)" << std::endl
+		<< "  -f, --format <list>     Write input.{bin,hex,lst} for each input (default: bin)" << std::endl
+		<< "  -h, --help              Display this message" << std::endl
+		<< "  -j, --jobs <count>      Assemble up to count inputs concurrently (default: " 
+			<< std::max(std::thread::hardware_concurrency(), 1U) << ")" << std::endl
+		<< "  -l, --listing <path>    Write listing (single input only)" << std::endl
+		<< "  -p, --peephole          Rewrite jsr/rts, sta/lda and clc/adc #1 pairs into shorter code" << std::endl
+		<< "  -r, --relax             Rewrite out-of-range branches as an inverted branch over jmp" << std::endl
+		<< "  -s, --statistics        Display build cache hit/miss statistics" << std::endl
+		<< "      --stats[=format]    Display per-phase time, memory and counts for each input as text or json" 
+			<< std::endl
+		<< "  -S, --server <socket>   Serve assemble requests on a Unix socket" << std::endl
+		<< "  -v, --version           Display version" << std::endl
+		<< "  -x, --hex <path>        Write Intel HEX image (single input only)" << std::endl;
+}
+
+static int 
+run(
+	__in const std::vector<std::string> &argument,
+	__inout std::ostream &stream_output,
+	__inout std::ostream &stream_error
+	)
+{
+	long value;
+	int option;
+	char *end = nullptr;
+	bool explicit_output = false, peephole = false, relax = false, statistics = false;
+	size_t hits, index, misses, jobs = std::max(std::thread::hardware_concurrency(), 1U);
+	std::string cache;
+	std::vector<char *> argv;
+	std::vector<job_t> job;
+	std::vector<stats_t> measure;
+	stats_format_t stats = STATS_FORMAT_NONE;
+	std::vector<std::string> expanded, input;
+	std::map<std::string, int32_t> define;
+	std::vector<bool> format(OUTPUT_MAX + 1, false);
+	std::vector<std::string> output(OUTPUT_MAX + 1);
+	std::vector<std::string>::const_iterator iter;
+	int result = EXIT_SUCCESS;
+
+	if(!expand_response(argument, expanded, stream_error)) {
+		return EXIT_FAILURE;
+	}
+
+	argv.push_back((char *) CC65C);
+
+	for(iter = expanded.begin(); iter != expanded.end(); ++iter) {
+		argv.push_back((char *) iter->c_str());
+	}
+
+	argv.push_back(nullptr);
+	optind = 0;
+	opterr = 0;
+
+	while((option = getopt_long(argv.size() - 1, &argv[0], OPTION_SHORT, OPTION_LONG, nullptr)) != -1) {
+
+		switch(option) {
+			case 'b':
+				output.at(OUTPUT_BINARY) = optarg;
+				explicit_output = true;
+				break;
+			case 'c':
+				cache = optarg;
+				break;
+			case 'D':
+
+				if(!parse_define(optarg, define)) {
+					stream_error << CC65C << ": Invalid define: " << optarg << std::endl;
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'f':
+
+				if(!parse_format(optarg, format)) {
+					stream_error << CC65C << ": Invalid format: " << optarg << std::endl;
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'h':
+				usage(stream_output);
+				return EXIT_SUCCESS;
+			case 'j':
+				value = std::strtol(optarg, &end, 0);
+
+				if(!end || *end || (value <= 0)) {
+					stream_error << CC65C << ": Invalid job count: " << optarg << std::endl;
+					return EXIT_FAILURE;
+				}
+
+				jobs = value;
+				break;
+			case 'l':
+				output.at(OUTPUT_LISTING) = optarg;
+				explicit_output = true;
+				break;
+			case 'p':
+				peephole = true;
+				break;
+			case 'r':
+				relax = true;
+				break;
+			case 's':
+				statistics = true;
+				break;
+			case OPTION_STATS:
+				stats = STATS_FORMAT_TEXT;
+
+				if(optarg) {
 
-		/*while(par.has_previous()) {
-			par.move_previous();
-			std::cout << par.to_string(true) << std::endl;
-		}*/
-		// ---
+					for(index = STATS_FORMAT_JSON; index <= STATS_FORMAT_MAX; ++index) {
 
+						if(optarg == STATS_FORMAT_STR[index]) {
+							stats = (stats_format_t) index;
+							break;
+						}
+					}
+
+					if(index > STATS_FORMAT_MAX) {
+						stream_error << CC65C << ": Invalid stats format: " << optarg << std::endl;
+						return EXIT_FAILURE;
+					}
+				}
+				break;
+			case 'v':
+				stream_output << CC65C << " " << cc65c::runtime::version(true) << std::endl;
+				return EXIT_SUCCESS;
+			case 'x':
+				output.at(OUTPUT_HEX) = optarg;
+				explicit_output = true;
+				break;
+			default:
+				usage(stream_error);
+				return EXIT_FAILURE;
+		}
+	}
+
+	input.assign(argv.begin() + optind, argv.end() - 1);
+
+	if((input.empty() && !statistics) || (explicit_output && (input.size() > 1))) {
+		usage(stream_error);
+		return EXIT_FAILURE;
+	}
+
+	if(!explicit_output && (std::find(format.begin(), format.end(), true) == format.end())) {
+		format.at(OUTPUT_BINARY) = true;
+	}
+
+	for(iter = input.begin(); iter != input.end(); ++iter) {
+		job.push_back(job_t(*iter, output, EXIT_SUCCESS, std::string()));
+
+		for(index = 0; index <= OUTPUT_MAX; ++index) {
+
+			if(format.at(index)) {
+				std::get<JOB_OUTPUT>(job.back()).at(index) = output_path(*iter, OUTPUT_EXTENSION[index]);
+			}
+		}
+	}
+
+	try {
+		cc65c::assembler::artifact::acquire().set_directory(cache);
+		cc65c::assembler::cache::acquire().set_directory(cache);
+
+		if(stats != STATS_FORMAT_NONE) {
+			cc65c::core::counter::acquire().initialize();
+
+			for(index = 0; index < job.size(); ++index) {
+				measure.push_back(stats_t());
+
+				if(assemble_measure(std::get<JOB_INPUT>(job.at(index)), define, std::get<JOB_OUTPUT>(job.at(index)), 
+						relax, peephole, stream_error, measure.back()) != EXIT_SUCCESS) {
+					result = EXIT_FAILURE;
+				}
+
+				if(stats == STATS_FORMAT_TEXT) {
+					print_stats(measure.back(), cc65c::core::counter::acquire().available(), stream_output);
+				}
+			}
+
+			if(stats == STATS_FORMAT_JSON) {
+				print_stats_json(measure, cc65c::core::counter::acquire().available(), stream_output);
+			}
+		} else if((job.size() > 1) && (jobs > 1)) {
+			result = assemble_parallel(job, define, relax, peephole, jobs, stream_error);
+		} else {
+
+			for(index = 0; index < job.size(); ++index) {
+				std::vector<size_t> count;
+
+				if(assemble_input(std::get<JOB_INPUT>(job.at(index)), define, std::get<JOB_OUTPUT>(job.at(index)), 
+						relax, peephole, stream_error, count) != EXIT_SUCCESS) {
+					result = EXIT_FAILURE;
+				}
+			}
+		}
+
+		if(statistics) {
+			cc65c::assembler::artifact::acquire().statistics(hits, misses);
+			stream_output << "Build cache: " << hits << " hit(s), " << misses << " miss(es)";
+
+			if(hits + misses) {
+				stream_output << " (" << ((hits * 100) / (hits + misses)) << "%)";
+			}
+
+			stream_output << std::endl;
+		}
+	} catch(cc65c::core::exception &exc) {
+		stream_error << exc.to_string(true) << std::endl;
+		result = EXIT_FAILURE;
+	}
+
+	cc65c::core::counter::acquire().uninitialize();
+
+	return result;
+}
+
+static void 
+server_signal(
+	__in int signal
+	)
+{
+	server_stop = 1;
+}
+
+static int 
+serve(
+	__in const std::string &path
+	)
+{
+	size_t position;
+	int32_t result;
+	struct sigaction action = {};
+	std::string directory, request;
+	std::vector<std::string> argument;
+	cc65c::core::socket server;
+
+	action.sa_handler = server_signal;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	server.listen(path);
+	std::cout << CC65C << " " << cc65c::runtime::version(true) << " listening on " << path << std::endl;
+
+	while(!server_stop) {
+		cc65c::core::socket client;
+
+		try {
+			server.accept(client);
+			client.set_timeout(SERVER_TIMEOUT);
+
+			if(!client.receive(request)) {
+				continue;
+			}
+
+			argument.clear();
+			position = request.find('\0');
+			directory = request.substr(0, position);
+
+			while(position != std::string::npos) {
+				size_t next = request.find('\0', position + 1);
+				argument.push_back(request.substr(position + 1, (next == std::string::npos) ? std::string::npos 
+					: (next - position - 1)));
+				position = next;
+			}
+
+			std::stringstream stream_error, stream_output;
+			if(chdir(directory.c_str())) {
+				stream_error << CC65C << ": Invalid directory: " << directory << std::endl;
+				result = EXIT_FAILURE;
+			} else {
+				result = run(argument, stream_output, stream_error);
+			}
+
+			client.send(std::string((const char *) &result, sizeof(result)));
+			client.send(stream_output.str());
+			client.send(stream_error.str());
+		} catch(cc65c::core::exception &exc) {
+
+			if(!server_stop) {
+				std::cerr << exc.to_string(true) << std::endl;
+			}
+		}
+	}
+
+	server.close();
+
+	return EXIT_SUCCESS;
+}
+
+int 
+main(
+	__in int argc,
+	__in char *argv[]
+	)
+{
+	const char *environment;
+	std::string connect, listen;
+	std::vector<std::string> argument(argv + 1, argv + argc);
+	int result = EXIT_SUCCESS;
+
+	try {
+		extract_option(argument, SERVER_OPTION_LISTEN_SHORT, SERVER_OPTION_LISTEN_LONG, listen);
+
+		if(!extract_option(argument, SERVER_OPTION_CONNECT_SHORT, SERVER_OPTION_CONNECT_LONG, connect) 
+				&& listen.empty()) {
+			environment = std::getenv(SERVER_ENVIRONMENT);
+			if(environment) {
+				connect = environment;
+			}
+		}
+
+		if(!connect.empty() && forward(connect, argument, result)) {
+			return result;
+		}
+
+		cc65c::runtime &instance = cc65c::runtime::acquire();
+		instance.initialize();
+		result = (listen.empty() ? run(argument, std::cout, std::cerr) : serve(listen));
 		instance.uninitialize();
 	} catch(cc65c::core::exception &exc) {
 		std::cerr << exc.to_string(true) << std::endl;
+		result = EXIT_FAILURE;
 	}
 
 	return result;